@@ -1,63 +1,22 @@
 #include "AnalysisWindow.h"
 
-AnalysisWindow::AnalysisWindow(QWidget *parent) :
+AnalysisWindow::AnalysisWindow(const StartupMode mode, QWidget *parent) :
     QWidget(parent),
+    seqPointListModel_(0),
     dataBaseName_("database.db"),
     tableName_("points")
 {
-    if(QFile::exists(dataBaseName_))
-    {
-        if(!QFile::remove(dataBaseName_))
-        {
-            qWarning() << "can't remove testing database";
-        }
-    }
+    // opened on itemsLoaded(), after the loader has checked the database
+    reader_ = new SqlPointListReader(dataBaseName_, tableName_);
+    reader_->setConnectionName(SqlPointListInterface::uniqueConnectionName());
+    reader_->setReadOnly(true);
 
-    SqlPointListWriter writer(dataBaseName_, tableName_);
-    writer.open();
-    SequencePointList seq;
-    for(int i = 0; i < 1000; i++)
+    loader_ = new StorageLoader(dataBaseName_, tableName_, this);
+    if(mode == GenerateDatabase)
     {
-        qDebug() << i;
-        PointList pointList(QString("id%1").arg(i));
-        for(int j = 0; j < 1; j++)
-        {
-            pointList << Point(j);
-  }
-        seq.append(pointList);
+        loader_->setGeneratedSequences(1000);
     }
 
-    qWarning() << "------BEGIN-WRITE-------";
-    writer.write(seq);
-    qWarning() << "------END-WRITE-------";
-
-//    DatabaseGenerator databaseGenerator;
-
-//    databaseGenerator.generateDataBase(dataBaseName_,tableName_);
-
-    reader_ = new SqlPointListReader(dataBaseName_, tableName_);
-    static_cast<SqlPointListReader*>(reader_)->open();
-
-    StatisticsList statisticsList;
-    statisticsList << new MaxSequenceLengthIdStatistics
-                   << new MaxSequenceLengthStatistics
-                   << new FiveTopSequenceLengthStatistics
-                   << new MinSequenceLengthIdStatistics
-                   << new MinSequenceLengthStatistics
-                   << new AverageSequenceLengthStatistics
-                   << new AverageNullCountPointsStatistics
-                   << new AverageNoneNullCountPointsStatistics
-                   << new PercentNullCountPointsStatistics
-                   << new PercentNoneNullCountPointsStatistics
-                   << new MaxPointStatistics
-                   << new MinPointStatistics
-                   << new FiveTopPointsValueStatistics
-                   << new SequenceWithRepeatCountStatistics
-                   << new IncSequenceCountStatistics
-                   << new DecSequenceCountStatistics;
-
-    static_cast<SqlPointListReader*>(reader_)->appendStatistics(statisticsList);
-
     QVBoxLayout* mainLayout = new QVBoxLayout;
     QHBoxLayout* subLayout = new QHBoxLayout;
 
@@ -81,18 +40,36 @@ AnalysisWindow::AnalysisWindow(QWidget *parent) :
 
     analyzesView_->setModel(analyzesModel_);
 
-    seqPointListModel_ = new ItemListModel(reader_);
-
     seqPointListView_ = new ItemListView();
     seqPointListView_->setFixedWidth(300);
-    seqPointListView_->setModel(seqPointListModel_);
 
     analyzeButton = new QPushButton("Провести анализ");
+    analyzeButton->setEnabled(false);
+    cancelButton_ = new QPushButton("Отменить");
+    cancelButton_->setEnabled(false);
+
+    analysisProgress_ = new QProgressBar;
+    analysisProgress_->setRange(0, 1);
+    analysisProgress_->setValue(0);
+
+    analysisSpeed_ = new QLabel;
+
+    lazyAnalysis_ = new QCheckBox("Анализ по требованию");
+    lazyAnalysis_->setEnabled(false);
+
+    storageStatus_ = new QLabel("Загрузка базы данных...");
+
+    analysisWorker_ = new AnalysisWorker(reader_, this);
 
 
     QHBoxLayout* analysisButtonsSection = new QHBoxLayout;
+    analysisButtonsSection->addWidget(storageStatus_);
+    analysisButtonsSection->addWidget(analysisProgress_);
+    analysisButtonsSection->addWidget(analysisSpeed_);
     analysisButtonsSection->addStretch();
+    analysisButtonsSection->addWidget(lazyAnalysis_);
     analysisButtonsSection->addWidget(analyzeButton);
+    analysisButtonsSection->addWidget(cancelButton_);
 
     QVBoxLayout* analyzesResultSectionLayout = new QVBoxLayout;
     analyzesResultSectionLayout->addWidget(analyzesView_);
@@ -118,10 +95,27 @@ AnalysisWindow::AnalysisWindow(QWidget *parent) :
     connect(seqPointListView_, SIGNAL(itemActivated(ID)), this, SLOT(addItem(ID)));
     connect(seqPointListView_, SIGNAL(itemsActivated(IDList)), this, SLOT(addItems(IDList)));
     connect(analyzeButton, SIGNAL(clicked()), this, SLOT(onAnalyzeButtonClick()));
+    connect(cancelButton_, SIGNAL(clicked()), this, SLOT(onCancelButtonClick()));
+    connect(lazyAnalysis_, SIGNAL(toggled(bool)), this, SLOT(onLazyAnalysisToggled(bool)));
+
+    connect(analysisWorker_, SIGNAL(resultsReady(AnalysisBatch)),
+            this, SLOT(onAnalysisResults(AnalysisBatch)));
+    connect(analysisWorker_, SIGNAL(progressChanged(int,int,int,double)),
+            this, SLOT(onAnalysisProgress(int,int,int,double)));
+    connect(analysisWorker_, SIGNAL(finished()), this, SLOT(onAnalysisFinished()));
+
+    connect(loader_, SIGNAL(itemsLoaded(IDList)), this, SLOT(onItemsLoaded(IDList)));
+    connect(loader_, SIGNAL(statisticsLoaded(PointListStorageStatistics)), this, SLOT(onStatisticsLoaded()));
+    connect(loader_, SIGNAL(loadFailed()), this, SLOT(onLoadFailed()));
+
+    loader_->load();
 }
 
 AnalysisWindow::~AnalysisWindow()
 {
+    delete analysisWorker_;
+    delete loader_;
+    delete seqPointListModel_;
     delete reader_;
     SqlPointListInterface::removeConnection();
 }
@@ -131,6 +125,7 @@ void AnalysisWindow::createMenu()
     mainMenu_ = new QMenuBar;
 
     mainMenu_->addAction("Статисткика", this, SLOT(onStatisticsClick()));
+    mainMenu_->addAction("Метрики", this, SLOT(onMetricsClick()));
 
 
     QMenu* menuData = mainMenu_->addMenu("Данные");
@@ -152,23 +147,114 @@ void AnalysisWindow::addItem(const ID &item)
 
 void AnalysisWindow::addItems(const IDList &items)
 {
-    foreach(const ID& item, items)
+    analyzesModel_->appendPointList(items);
+}
+
+void AnalysisWindow::onAnalyzeButtonClick()
+{
+    analyzesModel_->clearResults();
+
+    const IDList items = analyzesModel_->getPointsIDs();
+
+    analysisProgress_->setRange(0, qMax(1, items.count()));
+    analysisProgress_->setValue(0);
+    analysisSpeed_->clear();
+    cancelButton_->setEnabled(true);
+
+    analysisWorker_->analyze(analyzesModel_->collection(), items);
+}
+
+void AnalysisWindow::onCancelButtonClick()
+{
+    analysisWorker_->cancel();
+}
+
+void AnalysisWindow::onAnalysisResults(const AnalysisBatch &batch)
+{
+    if(batch.run != analysisWorker_->currentRun())
+    {
+        return;
+    }
+
+    analyzesModel_->appendResults(batch);
+}
+
+void AnalysisWindow::onAnalysisProgress(const int run, const int processed, const int total, const double itemsPerSecond)
+{
+    // queued progress of a cancelled run would overwrite the new one
+    if(run != analysisWorker_->currentRun())
     {
-        addItem(item);
+        return;
     }
+
+    analysisProgress_->setRange(0, qMax(1, total));
+    analysisProgress_->setValue(processed);
+    analysisSpeed_->setText(QString("%1 посл./с").arg(itemsPerSecond, 0, 'f', 1));
 }
 
-void AnalysisWindow::onAnalyzeButtonClick()
+void AnalysisWindow::onAnalysisFinished()
+{
+    cancelButton_->setEnabled(analysisWorker_->isRunning());
+}
+
+void AnalysisWindow::onLazyAnalysisToggled(const bool lazy)
 {
-    analyzesModel_->analyzeAll();
+    if(lazy)
+    {
+        analysisWorker_->cancel();
+    }
+
+    analyzesModel_->setLazyMode(lazy);
+    analyzeButton->setEnabled(!lazy);
 }
 
 void AnalysisWindow::onStatisticsClick()
 {
-    PointListStorageStatisticsDialog dialog(reader_->statistics());
+    if(!loader_->isStatisticsLoaded())
+    {
+        QMessageBox::information(this, "Статистика", "Статистика ещё загружается");
+        return;
+    }
+
+    PointListStorageStatisticsDialog dialog(loader_->statistics());
     dialog.exec();
 }
 
+void AnalysisWindow::onMetricsClick()
+{
+    MetricsDialog dialog(this);
+    dialog.exec();
+}
+
+void AnalysisWindow::onItemsLoaded(const IDList &firstPage)
+{
+    if(!reader_->isOpen() && !reader_->open())
+    {
+        onLoadFailed();
+        return;
+    }
+
+    // the first page is already read, so the model doesn't query the storage
+    ItemListModel* oldModel = seqPointListModel_;
+    seqPointListModel_ = new ItemListModel(reader_, firstPage);
+    seqPointListView_->setModel(seqPointListModel_);
+    delete oldModel;
+
+    storageStatus_->setText("Загрузка статистики...");
+    analyzeButton->setEnabled(!lazyAnalysis_->isChecked());
+    lazyAnalysis_->setEnabled(true);
+}
+
+void AnalysisWindow::onStatisticsLoaded()
+{
+    storageStatus_->clear();
+}
+
+void AnalysisWindow::onLoadFailed()
+{
+    storageStatus_->setText("База данных не загружена");
+}
+
 void AnalysisWindow::onExportClick()
 {
     QString exportFileName = QFileDialog::getSaveFileName(this, QString("Export File"),
@@ -194,6 +280,8 @@ void AnalysisWindow::onImportClick()
             qWarning() << importFileName << "not imported";
             return;
         }
-        seqPointListModel_->update();
+
+        storageStatus_->setText("Загрузка базы данных...");
+        loader_->load();
     }
 }
@@ -9,6 +9,9 @@
 #include <QToolButton>
 #include <QLabel>
 #include <QScrollBar>
+#include <QProgressBar>
+#include <QCheckBox>
+#include <QMessageBox>
 
 #include "src/ItemListView.h"
 
@@ -21,19 +24,37 @@
 #include "src/SqlPointListWriter.h"
 #include "src/DatabaseGenerator.h"
 #include "src/PointListStorageStatisticsDialog.h"
+#include "src/MetricsDialog.h"
 #include "src/CSVPointListImporter.h"
 #include "src/CSVPointListExporter.h"
+#include "src/AnalysisWorker.h"
+#include "src/StorageLoader.h"
 
 class AnalysisWindow : public QWidget
 {
     Q_OBJECT
     
 public:
-    AnalysisWindow(QWidget *parent = 0);
+    enum StartupMode
+    {
+        OpenDatabase,
+        GenerateDatabase
+    };
+
+    // the window is shown before the database is opened, the items and the
+    // statistics are loaded by a StorageLoader
+    AnalysisWindow(const StartupMode mode = OpenDatabase, QWidget *parent = 0);
     ~AnalysisWindow();
 
 private:
     QPushButton* analyzeButton;
+    QPushButton* cancelButton_;
+    QProgressBar* analysisProgress_;
+    QLabel* analysisSpeed_;
+    QCheckBox* lazyAnalysis_;
+    QLabel* storageStatus_;
+
+    AnalysisWorker* analysisWorker_;
 
     QTableView* analyzesView_;
     AnalysisTableModel* analyzesModel_;
@@ -41,7 +62,8 @@ private:
     ItemListView* seqPointListView_;
     ItemListModel* seqPointListModel_;
 
-    AbstractPointListReader *reader_;
+    SqlPointListReader *reader_;
+    StorageLoader* loader_;
 
     QMenuBar* mainMenu_;
 
@@ -55,7 +77,17 @@ private slots:
     void addItems(const IDList &items);
 
     void onAnalyzeButtonClick();
+    void onCancelButtonClick();
+    void onAnalysisResults(const AnalysisBatch &batch);
+    void onAnalysisProgress(const int run, const int processed, const int total, const double itemsPerSecond);
+    void onAnalysisFinished();
+    void onLazyAnalysisToggled(const bool lazy);
     void onStatisticsClick();
+    void onMetricsClick();
+
+    void onItemsLoaded(const IDList &firstPage);
+    void onStatisticsLoaded();
+    void onLoadFailed();
 
     void onExportClick();
     void onImportClick();
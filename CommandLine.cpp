@@ -0,0 +1,375 @@
+#include "CommandLine.h"
+
+#include <QFileInfo>
+#include <QThread>
+
+#include "src/AverageAnalysis.h"
+#include "src/AverageIgnoreNullAnalysis.h"
+#include "src/StandardDeviationAnalysis.h"
+#include "src/MedianAnalysis.h"
+#include "src/FirstQuartileAnalysis.h"
+#include "src/ThirdQuartileAnalysis.h"
+#include "src/PercentileAnalysis.h"
+#include "src/DatabaseAnalysisJob.h"
+#include "src/SqlAnalysisSink.h"
+#include "src/CSVAnalysisSink.h"
+#include "src/CSVPointListImporter.h"
+#include "src/CSVPointListExporter.h"
+#include "src/StatisticsCollection.h"
+#include "src/Metrics.h"
+
+CommandLine::CommandLine(const QStringList &arguments) :
+    arguments_(arguments),
+    tableName_("points"),
+    analyses_(QStringList() << "average"),
+    threads_(QThread::idealThreadCount()),
+    rangeSize_(0),
+    resultsTable_("results"),
+    out_(stdout)
+{
+}
+
+int CommandLine::run()
+{
+    if(!parse())
+    {
+        qWarning() << qPrintable(usage());
+        return UsageError;
+    }
+
+    int exitCode = Success;
+
+    if(command_ == "import")
+    {
+        exitCode = importPoints();
+    }
+    else if(command_ == "analyze")
+    {
+        exitCode = analyze();
+    }
+    else if(command_ == "statistics")
+    {
+        exitCode = statistics();
+    }
+    else if(command_ == "export")
+    {
+        exitCode = exportPoints();
+    }
+    else
+    {
+        qWarning() << "unknown command" << command_;
+        qWarning() << qPrintable(usage());
+        return UsageError;
+    }
+
+    if(!metricsOutput_.isEmpty() && !writeMetrics() && (exitCode == Success))
+    {
+        exitCode = Failure;
+    }
+
+    return exitCode;
+}
+
+QString CommandLine::usage()
+{
+    return QString("usage: number-analysis-cli <command> [options]\n"
+                   "commands:\n"
+                   "  import <file.csv>   append the points of a CSV file to the database\n"
+                   "  analyze             analyze every sequence of the database\n"
+                   "  statistics          print the storage statistics\n"
+                   "  export              write the points to a CSV file\n"
+                   "options:\n"
+                   "  --database <file>       SQLite database, required\n"
+                   "  --table <name>          points table, default points\n"
+                   "  --analyses <ids>        comma separated: %1\n"
+                   "  --threads <n>           analysis workers, default the CPU count\n"
+                   "  --range-size <n>        items per work range\n"
+                   "  --output <path>         .csv file, - for stdout or SQLite database\n"
+                   "  --results-table <name>  results table of a database output, default results\n"
+                   "  --metrics <path>        file or - for stdout, counters and timers of the run")
+            .arg(QStringList(analysisIDs()).join(","));
+}
+
+AbstractAnalysis *CommandLine::createAnalysis(const IDAnalysis &id)
+{
+    if(id == "average") return new AverageAnalysis;
+    if(id == "average-ignore-null") return new AverageIgnoreNullAnalysis;
+    if(id == "standard-deviation") return new StandardDeviationAnalysis;
+    if(id == "median") return new MedianAnalysis;
+    if(id == "first-quartile") return new FirstQuartileAnalysis;
+    if(id == "third-quartile") return new ThirdQuartileAnalysis;
+    if(id == "percentiles") return new PercentileAnalysis;
+
+    return 0;
+}
+
+IDAnalysisList CommandLine::analysisIDs()
+{
+    return IDAnalysisList() << "average" << "average-ignore-null" << "standard-deviation"
+                            << "median" << "first-quartile" << "third-quartile" << "percentiles";
+}
+
+bool CommandLine::parse()
+{
+    // the first argument is the program
+    for(int i = 1; i < arguments_.count(); i++)
+    {
+        const QString argument = arguments_.at(i);
+
+        if(!argument.startsWith("--"))
+        {
+            if(command_.isEmpty())
+            {
+                command_ = argument;
+            }
+            else if(input_.isEmpty())
+            {
+                input_ = argument;
+            }
+            else
+            {
+                qWarning() << "unexpected argument" << argument;
+                return false;
+            }
+            continue;
+        }
+
+        if((i + 1) >= arguments_.count())
+        {
+            qWarning() << "missing value of" << argument;
+            return false;
+        }
+
+        const QString value = arguments_.at(++i);
+        bool isNumber = true;
+
+        if(argument == "--database")
+        {
+            dataBaseName_ = value;
+        }
+        else if(argument == "--table")
+        {
+            tableName_ = value;
+        }
+        else if(argument == "--analyses")
+        {
+            analyses_ = value.split(",", QString::SkipEmptyParts);
+        }
+        else if(argument == "--threads")
+        {
+            threads_ = value.toInt(&isNumber);
+        }
+        else if(argument == "--range-size")
+        {
+            rangeSize_ = value.toInt(&isNumber);
+        }
+        else if(argument == "--output")
+        {
+            output_ = value;
+        }
+        else if(argument == "--results-table")
+        {
+            resultsTable_ = value;
+        }
+        else if(argument == "--metrics")
+        {
+            metricsOutput_ = value;
+        }
+        else
+        {
+            qWarning() << "unknown option" << argument;
+            return false;
+        }
+
+        if(!isNumber)
+        {
+            qWarning() << "not a number" << argument << value;
+            return false;
+        }
+    }
+
+    if(command_.isEmpty() || dataBaseName_.isEmpty())
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool CommandLine::isDataBase() const
+{
+    if(!QFile::exists(dataBaseName_))
+    {
+        qWarning() << "database" << dataBaseName_ << "not exists";
+        return false;
+    }
+
+    return true;
+}
+
+bool CommandLine::isPointsTable(const QString &dataBaseName, const QString &tableName) const
+{
+    if(QFileInfo(dataBaseName).absoluteFilePath() != QFileInfo(dataBaseName_).absoluteFilePath())
+    {
+        return false;
+    }
+
+    // SQLite table names ignore the case, the state table is named like SqlPointListInterface::stateTableName
+    return (tableName.compare(tableName_, Qt::CaseInsensitive) == 0)
+            || (tableName.compare(tableName_ + "_state", Qt::CaseInsensitive) == 0);
+}
+
+int CommandLine::importPoints()
+{
+    if(input_.isEmpty() || !QFile::exists(input_))
+    {
+        qWarning() << "import file" << input_ << "not exists";
+        return UsageError;
+    }
+
+    CSVPointListImporter importer(input_, dataBaseName_, tableName_);
+
+    return importer.import() ? Success : Failure;
+}
+
+int CommandLine::analyze()
+{
+    if(!isDataBase())
+    {
+        return Failure;
+    }
+
+    AnalysisCollection collection;
+    foreach(const QString &id, analyses_)
+    {
+        AbstractAnalysis *analysis = createAnalysis(id);
+        if(analysis == 0)
+        {
+            qWarning() << "unknown analysis" << id;
+            return UsageError;
+        }
+
+        collection.addAnalysis(analysis);
+        delete analysis;
+    }
+
+    const QString output = output_.isEmpty() ? QString("-") : output_;
+    const bool isCSV = (output == "-") || output.endsWith(".csv", Qt::CaseInsensitive);
+
+    if(!isCSV && isPointsTable(output, resultsTable_))
+    {
+        qWarning() << "results table" << resultsTable_ << "would replace the points of" << dataBaseName_;
+        return UsageError;
+    }
+
+    QScopedPointer<AbstractAnalysisSink> sink(isCSV
+                                              ? static_cast<AbstractAnalysisSink*>(new CSVAnalysisSink(output))
+                                              : static_cast<AbstractAnalysisSink*>(new SqlAnalysisSink(output, resultsTable_)));
+
+    DatabaseAnalysisJob job(dataBaseName_, tableName_);
+    job.setWorkersCount(threads_);
+    if(rangeSize_ > 0)
+    {
+        job.setRangeSize(rangeSize_);
+    }
+
+    if(!job.run(collection, sink.data()))
+    {
+        qWarning() << "analysis of" << dataBaseName_ << "failed";
+        return Failure;
+    }
+
+    qWarning() << "analyzed" << job.processedCount() << "sequences";
+
+    return Success;
+}
+
+int CommandLine::statistics()
+{
+    if(!isDataBase())
+    {
+        return Failure;
+    }
+
+    SqlPointListReader reader(dataBaseName_, tableName_);
+    reader.appendStatistics(allStatistics());
+
+    if(!reader.open())
+    {
+        qWarning() << "can't open database" << dataBaseName_;
+        return Failure;
+    }
+
+    QStringList lines = reader.statistics().toString();
+    lines.sort();
+
+    foreach(const QString &line, lines)
+    {
+        out_ << line << '\n';
+    }
+    out_.flush();
+
+    return Success;
+}
+
+int CommandLine::exportPoints()
+{
+    if(!isDataBase())
+    {
+        return Failure;
+    }
+
+    if(output_.isEmpty())
+    {
+        qWarning() << "export needs --output";
+        return UsageError;
+    }
+
+    // a file left by an earlier export isn't taken for a result
+    if(QFile::exists(output_) && !QFile::remove(output_))
+    {
+        qWarning() << "can't replace" << output_;
+        return Failure;
+    }
+
+    CSVPointListExporter exporter(dataBaseName_, tableName_, output_);
+
+    return exporter.exportFromDataBase() ? Success : Failure;
+}
+
+bool CommandLine::writeMetrics()
+{
+    if(!Metrics::isEnabled())
+    {
+        qWarning() << "built without metrics, rebuild with CONFIG+=metrics";
+        return false;
+    }
+
+    const QStringList lines = Metrics::toString(Metrics::snapshot());
+
+    if(metricsOutput_ == "-")
+    {
+        foreach(const QString &line, lines)
+        {
+            out_ << line << '\n';
+        }
+        out_.flush();
+
+        return true;
+    }
+
+    QFile file(metricsOutput_);
+    if(!file.open(QFile::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+    {
+        qWarning() << metricsOutput_ << "not open to write";
+        return false;
+    }
+
+    QTextStream stream(&file);
+    foreach(const QString &line, lines)
+    {
+        stream << line << '\n';
+    }
+
+    return true;
+}
@@ -0,0 +1,71 @@
+#ifndef COMMANDLINE_H
+
+#define COMMANDLINE_H
+
+#include <QStringList>
+#include <QTextStream>
+
+#include "src/AnalysisCollection.h"
+
+// Headless runner for scripts, cron jobs and containers. It only opens the
+// given database, nothing is generated:
+//   number-analysis-cli import <file.csv> --database <db> [--table <name>]
+//   number-analysis-cli analyze --database <db> [--table <name>]
+//       [--analyses average,median,...] [--threads <n>] [--range-size <n>]
+//       [--output <file.csv|results.db|->] [--results-table <name>]
+//   number-analysis-cli statistics --database <db> [--table <name>]
+//   number-analysis-cli export --database <db> [--table <name>] --output <file.csv>
+// Every command takes --metrics <file|-> to dump the counters and timers
+// of the run, see Metrics.h.
+class CommandLine
+{
+    friend class TCommandLine;
+
+public:
+    enum ExitCode
+    {
+        Success = 0,
+        Failure = 1,
+        UsageError = 2
+    };
+
+    CommandLine(const QStringList &arguments);
+
+    int run();
+
+    static QString usage();
+
+    // analysis for an id of the --analyses option, 0 for unknown ids
+    static AbstractAnalysis* createAnalysis(const IDAnalysis &id);
+    static IDAnalysisList analysisIDs();
+
+private:
+    QStringList arguments_;
+
+    QString command_;
+    QString input_;
+    QString dataBaseName_;
+    QString tableName_;
+    QStringList analyses_;
+    int threads_;
+    int rangeSize_;
+    QString output_;
+    QString resultsTable_;
+    QString metricsOutput_;
+
+    QTextStream out_;
+
+    bool parse();
+    bool isDataBase() const;
+    // true when the table of the database is the points or state table
+    bool isPointsTable(const QString &dataBaseName, const QString &tableName) const;
+
+    int importPoints();
+    int analyze();
+    int statistics();
+    int exportPoints();
+
+    bool writeMetrics();
+};
+
+#endif // COMMANDLINE_H
@@ -5,7 +5,13 @@ BAnalysisCollections::BAnalysisCollections(const int nRuns) :
 {
 }
 
-void BAnalysisCollections::run()
+void BAnalysisCollections::run(BenchmarkRunner &runner)
+{
+    runner.measure(QString("analysis collections/create and analyze x%1").arg(nRuns_),
+                   this, &BAnalysisCollections::createAndAnalyze);
+}
+
+void BAnalysisCollections::createAndAnalyze()
 {
     for(int i = 0; i < nRuns_; ++i)
     {
@@ -18,7 +24,5 @@ void BAnalysisCollections::run()
         delete analysis;
 
         collection.analyze(PointList());
-
-        qWarning() << QString("iteration : " + QString::number(i)).toLocal8Bit();
     }
 }
@@ -2,6 +2,8 @@
 
 #define BANALYSISCOLLECTIONS_H
 
+#include "BenchmarkRunner.h"
+
 #include "../src/AnalysisCollection.h"
 #include "../src/StupidAnalysis.h"
 
@@ -10,10 +12,12 @@ class BAnalysisCollections
 public:
     BAnalysisCollections(const int nRuns);
 
-    void run();
+    void run(BenchmarkRunner &runner);
 
 private:
     int nRuns_;
+
+    void createAndAnalyze();
 };
 
 #endif // BANALYSISCOLLECTIONS_H
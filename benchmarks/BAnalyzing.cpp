@@ -1,62 +1,107 @@
 #include "BAnalyzing.h"
 
+#include <QFile>
+#include <QFileInfo>
+
+const int BAnalyzing::pointsPerList_ = 100;
+
 BAnalyzing::BAnalyzing(const int pointsCount) :
-    pointsCount_(pointsCount)
+    pointsCount_(pointsCount),
+    dataBaseName_("analysingbenchmark.db"),
+    tableName_("testtable"),
+    writer_(0),
+    reader_(0),
+    analysisModel_(0)
 {
 
 }
 
-void BAnalyzing::run()
+BAnalyzing::~BAnalyzing()
 {
-    QString dataBaseName = "analysingbenchmark.db";
-    QString tableName = "testtable";
-
-    if(QFile::exists(dataBaseName))
-    {
-        if(!QFile::remove(dataBaseName))
-        {
-            qWarning() << "can't remove testing database";
-        }
-    }
-
-    SqlPointListWriter* writer = new SqlPointListWriter(dataBaseName, tableName);
-    if(!writer->open())
-    {
-        qWarning() << "can't open writer";
-    }
+    delete analysisModel_;
+    delete writer_;
+    delete reader_;
+}
 
-    SequencePointList seqPoints;
-    qsrand(QTime(0,0).secsTo(QTime::currentTime()));
+void BAnalyzing::run(BenchmarkRunner &runner)
+{
+    seqPoints_.clear();
     for(int j = 0; j < pointsCount_; j++)
     {
         PointList points(QString("id%1").arg(j));
-        for(int pointNum = 0; pointNum < 100; pointNum++)
+        for(int pointNum = 0; pointNum < pointsPerList_; pointNum++)
         {
             points << pointNum;
         }
 
-        seqPoints.append(points);
+        seqPoints_.append(points);
     }
 
-    QTime timer;
-    timer.start();
-    writer->write(seqPoints);
-    qWarning() << "write "
-               << seqPoints.count()
-               << " pointslist "
-               << timer.elapsed() / 1000.0
-               << "seconds";
+    const double points = double(pointsCount_) * double(pointsPerList_);
 
-    seqPoints.clear();
-    delete writer;
+    BenchmarkResult &writeResult = runner.measure(QString("analyzing/write %1 lists").arg(pointsCount_),
+                                                  this, &BAnalyzing::write, points, 0.0,
+                                                  &BAnalyzing::reopenWriter);
 
-    SqlPointListReader* reader = new SqlPointListReader(dataBaseName, tableName);
-    if(!reader->open())
+    seqPoints_.clear();
+    delete writer_;
+    writer_ = 0;
+
+    SqlPointListInterface::removeConnection();
+
+    const double dataBaseSize = QFileInfo(dataBaseName_).size();
+    writeResult.bytes = dataBaseSize;
+
+    reader_ = new SqlPointListReader(dataBaseName_, tableName_);
+    if(!reader_->open())
     {
         qWarning() << "sqlreader not open";
         return;
     }
 
+    runner.measure("analyzing/read all ids", this, &BAnalyzing::readAllItems);
+
+    idList_ = reader_->readAllItems();
+
+    runner.measure("analyzing/add to analyzing", this, &BAnalyzing::appendToModel, 0.0, 0.0,
+                   &BAnalyzing::recreateModel);
+    runner.measure("analyzing/analyze all", this, &BAnalyzing::analyzeAll, points, dataBaseSize);
+
+    delete analysisModel_;
+    analysisModel_ = 0;
+    delete reader_;
+    reader_ = 0;
+
+    SqlPointListInterface::removeConnection();
+}
+
+void BAnalyzing::reopenWriter()
+{
+    delete writer_;
+    writer_ = 0;
+
+    SqlPointListInterface::removeConnection();
+
+    if(QFile::exists(dataBaseName_))
+    {
+        if(!QFile::remove(dataBaseName_))
+        {
+            qWarning() << "can't remove testing database";
+        }
+    }
+
+    writer_ = new SqlPointListWriter(dataBaseName_, tableName_);
+    if(!writer_->open())
+    {
+        qWarning() << "can't open writer";
+    }
+}
+
+void BAnalyzing::recreateModel()
+{
+    delete analysisModel_;
+    analysisModel_ = new AnalysisTableModel(reader_);
+
     AnalysisList analysisList;
     analysisList
             << new StupidAnalysis
@@ -67,31 +112,29 @@ void BAnalyzing::run()
             << new FirstQuartileAnalysis
             << new ThirdQuartileAnalysis;
 
-    timer.start();
-    const IDList idList = reader->readAllItems();
-    qWarning() << "Read time" <<timer.elapsed() / 1000.0;
-
-    AnalysisTableModel* analysisModel = new AnalysisTableModel(reader);
-
-
     foreach(AbstractAnalysis* analysis, analysisList)
     {
-        analysisModel->addAnalysis(analysis);
+        analysisModel_->addAnalysis(analysis);
         delete analysis;
     }
+}
 
-    timer.start();
-    analysisModel->appendPointList(idList);
-    qWarning() << "Add to analyzing time" <<timer.elapsed() / 1000.0;
-
-    timer.start();
-    analysisModel->analyzeAll();
+void BAnalyzing::write()
+{
+    writer_->write(seqPoints_);
+}
 
-    qWarning() << "Analyzing time" <<timer.elapsed() / 1000.0;
+void BAnalyzing::readAllItems()
+{
+    reader_->readAllItems();
+}
 
-    analysisList.clear();
-    delete analysisModel;
-    delete reader;
+void BAnalyzing::appendToModel()
+{
+    analysisModel_->appendPointList(idList_);
+}
 
-    SqlPointListInterface::removeConnection();
+void BAnalyzing::analyzeAll()
+{
+    analysisModel_->analyzeAll();
 }
@@ -2,6 +2,8 @@
 
 #define BANALYZING_H
 
+#include "BenchmarkRunner.h"
+
 #include "../src/SqlPointListReader.h"
 #include "../src/SqlPointListWriter.h"
 #include "../src/AnalysisTableModel.h"
@@ -18,11 +20,31 @@ class BAnalyzing
 {
 public:
     BAnalyzing(const int pointsCount);
+    ~BAnalyzing();
 
-    void run();
+    void run(BenchmarkRunner &runner);
 
 private:
     int pointsCount_;
+
+    const QString dataBaseName_;
+    const QString tableName_;
+
+    SequencePointList seqPoints_;
+    IDList idList_;
+    SqlPointListWriter* writer_;
+    SqlPointListReader* reader_;
+    AnalysisTableModel* analysisModel_;
+
+    static const int pointsPerList_;
+
+    void reopenWriter();
+    void recreateModel();
+
+    void write();
+    void readAllItems();
+    void appendToModel();
+    void analyzeAll();
 };
 
 #endif // BANALYZING_H
@@ -2,56 +2,67 @@
 
 BCSVImporterExporter::BCSVImporterExporter(const int seqCount, const int pointsCount) :
     seqCount_(seqCount),
-    pointsCount_(pointsCount)
+    pointsCount_(pointsCount),
+    dataBaseName_("csvbenchmarck.db"),
+    tableName_("points"),
+    importFileName_("csvbenchmarck_import.csv"),
+    exportFileName_("csvbenchmarck_export.csv")
 {
 
 }
 
-void BCSVImporterExporter::run()
+void BCSVImporterExporter::run(BenchmarkRunner &runner)
 {
-    const QString dataBaseName = "csvbenchmarck.db";
-    const QString tableName = "points";
-    const QString importFileName = "csvbenchmarck_import.csv";
-    const QString exportFileName = "csvbenchmarck_export.csv";
-
-    if(QFile::exists(dataBaseName))
+    if(!writeImportFile())
     {
-        if(!QFile::remove(dataBaseName))
-        {
-            qWarning() << "can't remove data base";
-            return;
-        }
+        return;
     }
 
-    if(QFile::exists(importFileName))
-    {
-        if(!QFile::remove(importFileName))
-        {
-            qWarning() << "can't remove import file";
-        }
-    }
+    const double points = double(seqCount_) * double(pointsCount_);
+    const double importSize = QFileInfo(importFileName_).size();
+
+    qWarning() << "Sequence count: " << seqCount_;
+    qWarning() << "Points count: " << pointsCount_;
+    qWarning() << "Import file size: " << importSize / 1024 << "kb";
 
-    if(QFile::exists(exportFileName))
+    runner.measure("csv/validation", this, &BCSVImporterExporter::validate, points, importSize);
+    runner.measure("csv/import", this, &BCSVImporterExporter::import, points, importSize,
+                   &BCSVImporterExporter::removeDataBase);
+
+    qWarning() << "Database size: " << QFileInfo(dataBaseName_).size() / 1024 << "kb";
+
+    BenchmarkResult &result = runner.measure("csv/export", this, &BCSVImporterExporter::exportToFile, points, 0.0,
+                                             &BCSVImporterExporter::removeExportFile);
+    result.bytes = QFileInfo(exportFileName_).size();
+
+    qWarning() << "Export file size: "  << QFileInfo(exportFileName_).size() / 1024 << "kb";
+}
+
+bool BCSVImporterExporter::writeImportFile()
+{
+    removeDataBase();
+
+    if(QFile::exists(importFileName_))
     {
-        if(!QFile::remove(exportFileName))
+        if(!QFile::remove(importFileName_))
         {
-            qWarning() << "can't remove export file";
+            qWarning() << "can't remove import file";
         }
     }
 
+    removeExportFile();
 
-    QFile importFile(importFileName);
+    QFile importFile(importFileName_);
 
     if(!importFile.open(QFile::WriteOnly | QIODevice::Text))
     {
-        qWarning() << importFileName << "not open to write";
-        return;
+        qWarning() << importFileName_ << "not open to write";
+        return false;
     }
 
     QTextStream textStream(&importFile);
     for(int i = 0; i < seqCount_; i++)
     {
-        const PointList pointList = PointList();
         for(int j = 0; j < pointsCount_; j++)
         {
             textStream << QString("id%1").arg(i) << ";" << j;
@@ -66,37 +77,54 @@ void BCSVImporterExporter::run()
         }
     }
 
-    importFile.flush();
+    textStream.flush();
     importFile.close();
 
-    qWarning() << "Sequence count: " << seqCount_;
-    qWarning() << "Points count: " << pointsCount_;
-    qWarning() << "Import file size: " << QFileInfo(importFileName).size() / 1024 << "kb";
+    return true;
+}
 
-    CSVPointListValidator csvValidator;
-    const QTime validationTime(QTime::currentTime());
-    if(!csvValidator.validation(importFileName))
+void BCSVImporterExporter::removeDataBase()
+{
+    if(QFile::exists(dataBaseName_))
     {
-        qWarning() << importFileName << "not valid";
+        if(!QFile::remove(dataBaseName_))
+        {
+            qWarning() << "can't remove data base";
+        }
     }
-    qWarning() << "Validation time: " << validationTime.secsTo(QTime::currentTime()) << "s";
-
-    CSVPointListImporter csvImporter(importFileName, dataBaseName, tableName);
+}
 
-    const QTime importTime(QTime::currentTime());
-    if(!csvImporter.import())
+void BCSVImporterExporter::removeExportFile()
+{
+    if(QFile::exists(exportFileName_))
     {
-        qWarning() << importFileName << "not imported";
+        if(!QFile::remove(exportFileName_))
+        {
+            qWarning() << "can't remove export file";
+        }
     }
-    qWarning() << "Import time: " << importTime.secsTo(QTime::currentTime()) << "s";
-    qWarning() << "Database size: " << QFileInfo(dataBaseName).size() / 1024 << "kb";
-
+}
 
+void BCSVImporterExporter::validate()
+{
+    CSVPointListValidator csvValidator;
+    if(!csvValidator.validation(importFileName_))
+    {
+        qWarning() << importFileName_ << "not valid";
+    }
+}
 
-    CSVPointListExporter csvExporter(dataBaseName, tableName, exportFileName);
+void BCSVImporterExporter::import()
+{
+    CSVPointListImporter csvImporter(importFileName_, dataBaseName_, tableName_);
+    if(!csvImporter.import())
+    {
+        qWarning() << importFileName_ << "not imported";
+    }
+}
 
-    const QTime exportTime(QTime::currentTime());
+void BCSVImporterExporter::exportToFile()
+{
+    CSVPointListExporter csvExporter(dataBaseName_, tableName_, exportFileName_);
     csvExporter.exportFromDataBase();
-    qWarning() << "Export time: " << exportTime.secsTo(QTime::currentTime()) << "s";
-    qWarning() << "Export file size: "  << QFileInfo(exportFileName).size() / 1024 << "kb";
 }
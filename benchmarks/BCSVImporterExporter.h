@@ -1,6 +1,8 @@
 #ifndef BCSVIMPORTEREXPORTER_H
 #define BCSVIMPORTEREXPORTER_H
 
+#include "BenchmarkRunner.h"
+
 #include "../src/SequencePointList.h"
 #include "../src/CSVPointListImporter.h"
 #include "../src/CSVPointListExporter.h"
@@ -9,11 +11,25 @@ class BCSVImporterExporter
 {
 public:
     BCSVImporterExporter(const int seqCount, const int pointsCount);
-    void run();
+    void run(BenchmarkRunner &runner);
 
 private:
     int seqCount_;
     int pointsCount_;
+
+    const QString dataBaseName_;
+    const QString tableName_;
+    const QString importFileName_;
+    const QString exportFileName_;
+
+    bool writeImportFile();
+
+    void removeDataBase();
+    void removeExportFile();
+
+    void validate();
+    void import();
+    void exportToFile();
 };
 
 #endif // BCSVIMPORTEREXPORTER_H
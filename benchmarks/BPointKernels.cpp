@@ -0,0 +1,91 @@
+#include "BPointKernels.h"
+
+BPointKernels::BPointKernels(const int pointsCount, const int repeats) :
+    pointsCount_(pointsCount),
+    repeats_(repeats),
+    checksum_(0.0)
+{
+}
+
+void BPointKernels::run(BenchmarkRunner &runner)
+{
+    qsrand(QTime(0,0).secsTo(QTime::currentTime()));
+
+    values_ = QVector<double>(pointsCount_);
+    for(int i = 0; i < pointsCount_; i++)
+    {
+        values_[i] = (qrand() % 4 == 0) ? 0.0 : double(qrand() % 1000) / 10.0;
+    }
+
+    const PointKernels::Instructions supported = PointKernels::supportedInstructions();
+
+    qWarning() << "points" << pointsCount_
+               << "repeats" << repeats_
+               << "supported" << PointKernels::instructionsName(supported);
+
+    // one repetition calls a kernel repeats_ times, so short arrays are above the timer resolution
+    const double points = double(pointsCount_) * double(repeats_);
+    const double bytes = points * sizeof(double);
+
+    for(int instructions = PointKernels::Scalar; instructions <= supported; instructions++)
+    {
+        PointKernels::setInstructions(PointKernels::Instructions(instructions));
+
+        const QString name = QString("point kernels/%1/%2/")
+                .arg(PointKernels::instructionsName(PointKernels::instructions()))
+                .arg(pointsCount_);
+
+        runner.measure(name + "sum", this, &BPointKernels::runSum, points, bytes);
+        runner.measure(name + "sum of squares", this, &BPointKernels::runSumOfSquares, points, bytes);
+        runner.measure(name + "min max", this, &BPointKernels::runMinMax, points, bytes);
+        runner.measure(name + "count non zero", this, &BPointKernels::runCountNonZero, points, bytes);
+        runner.measure(name + "count equal", this, &BPointKernels::runCountEqual, points, bytes);
+    }
+
+    PointKernels::setInstructions(supported);
+
+    qWarning() << "checksum" << checksum_;
+}
+
+void BPointKernels::runSum()
+{
+    for(int i = 0; i < repeats_; i++)
+    {
+        checksum_ += PointKernels::sum(values_);
+    }
+}
+
+void BPointKernels::runSumOfSquares()
+{
+    for(int i = 0; i < repeats_; i++)
+    {
+        checksum_ += PointKernels::sumOfSquares(values_, 50.0);
+    }
+}
+
+void BPointKernels::runMinMax()
+{
+    for(int i = 0; i < repeats_; i++)
+    {
+        double min;
+        double max;
+        PointKernels::minMax(values_.constData(), values_.count(), &min, &max);
+        checksum_ += max - min;
+    }
+}
+
+void BPointKernels::runCountNonZero()
+{
+    for(int i = 0; i < repeats_; i++)
+    {
+        checksum_ += PointKernels::countNonZero(values_);
+    }
+}
+
+void BPointKernels::runCountEqual()
+{
+    for(int i = 0; i < repeats_; i++)
+    {
+        checksum_ += PointKernels::countEqual(values_.constData(), values_.count(), 50.0);
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef BPOINTKERNELS_H
+
+#define BPOINTKERNELS_H
+
+#include "BenchmarkRunner.h"
+
+#include "../src/PointKernels.h"
+
+class BPointKernels
+{
+public:
+    BPointKernels(const int pointsCount, const int repeats);
+
+    void run(BenchmarkRunner &runner);
+
+private:
+    int pointsCount_;
+    int repeats_;
+
+    QVector<double> values_;
+    double checksum_;
+
+    void runSum();
+    void runSumOfSquares();
+    void runMinMax();
+    void runCountNonZero();
+    void runCountEqual();
+};
+
+#endif // BPOINTKERNELS_H
@@ -0,0 +1,415 @@
+#include "BScaling.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <qmath.h>
+#include <cstdlib>
+
+#include "../src/DatabaseAnalysisJob.h"
+#include "../src/CSVPointListImporter.h"
+#include "../src/CSVPointListExporter.h"
+
+#include "../src/AverageAnalysis.h"
+#include "../src/StandardDeviationAnalysis.h"
+#include "../src/MedianAnalysis.h"
+
+const int BScaling::maxLengthFactor = 100;
+
+// drops the results, so the analysis is measured without a storage behind it
+class NullAnalysisSink : public AbstractAnalysisSink
+{
+public:
+    NullAnalysisSink() : rows(0) {}
+
+    bool begin(const IDAnalysisList &outputIDs) { Q_UNUSED(outputIDs); rows = 0; return true;}
+    bool write(const IDList &items, const QVector<double> &values)
+    { Q_UNUSED(values); rows += items.count(); return true;}
+    bool finish() { return true;}
+
+    int rows;
+};
+
+BScaling::BScaling(const QList<int> &sequenceCounts, const int meanPoints) :
+    sequenceCounts_(sequenceCounts),
+    meanPoints_(meanPoints),
+    dataBaseName_("scalingbenchmark.db"),
+    importDataBaseName_("scalingbenchmark_import.db"),
+    tableName_("testtable"),
+    exportFileName_("scalingbenchmark_export.csv"),
+    writer_(0),
+    reader_(0),
+    collection_(0),
+    workersCount_(1)
+{
+    const int idealThreads = qMax(1, QThread::idealThreadCount());
+    for(int threads = 1; threads < idealThreads; threads *= 2)
+    {
+        threadCounts_ << threads;
+    }
+    threadCounts_ << idealThreads;
+
+    distributions_ << ConstantLength << UniformLength << HeavyTailedLength;
+}
+
+BScaling::~BScaling()
+{
+    closeWriter();
+    closeReader();
+    delete collection_;
+}
+
+QList<int> BScaling::threadCounts() const
+{
+    return threadCounts_;
+}
+
+void BScaling::setThreadCounts(const QList<int> &counts)
+{
+    threadCounts_ = counts;
+}
+
+QList<BScaling::LengthDistribution> BScaling::distributions() const
+{
+    return distributions_;
+}
+
+void BScaling::setDistributions(const QList<LengthDistribution> &distributions)
+{
+    distributions_ = distributions;
+}
+
+QString BScaling::distributionName(const LengthDistribution distribution)
+{
+    switch(distribution)
+    {
+    case ConstantLength:
+        return "constant";
+    case UniformLength:
+        return "uniform";
+    case HeavyTailedLength:
+        return "heavy-tailed";
+    }
+
+    return QString();
+}
+
+void BScaling::run(BenchmarkRunner &runner)
+{
+    sweep_.clear();
+
+    AnalysisList analysisList;
+    analysisList
+            << new AverageAnalysis
+            << new StandardDeviationAnalysis
+            << new MedianAnalysis;
+
+    delete collection_;
+    collection_ = new AnalysisCollection(analysisList);
+
+    foreach(AbstractAnalysis* analysis, analysisList)
+    {
+        delete analysis;
+    }
+
+    foreach(const LengthDistribution distribution, distributions_)
+    {
+        foreach(const int sequenceCount, sequenceCounts_)
+        {
+            runConfiguration(runner, sequenceCount, distribution);
+        }
+    }
+
+    removeFile(dataBaseName_);
+    removeFile(importDataBaseName_);
+    removeFile(exportFileName_);
+
+    reportCurves();
+}
+
+int BScaling::pointsCount(const LengthDistribution distribution)
+{
+    const double random = (qrand() + 1.0) / (RAND_MAX + 2.0);
+
+    switch(distribution)
+    {
+    case ConstantLength:
+        return meanPoints_;
+    case UniformLength:
+        // 1 .. 2 * mean - 1
+        return 1 + int(random * (2 * meanPoints_ - 1));
+    case HeavyTailedLength:
+    {
+        // Pareto with shape 1.5 has the mean 3 * scale, most sequences are
+        // short and a few are up to maxLengthFactor times the mean
+        const double shape = 1.5;
+        const double scale = meanPoints_ / 3.0;
+        const double length = scale / qPow(random, 1.0 / shape);
+
+        return qBound(1, int(length), maxLengthFactor * meanPoints_);
+    }
+    }
+
+    return meanPoints_;
+}
+
+double BScaling::generate(const int sequenceCount, const LengthDistribution distribution)
+{
+    // the same lengths for the same configuration on every run
+    qsrand(uint(sequenceCount) * 31u + uint(distribution));
+
+    seqPoints_.clear();
+
+    double points = 0.0;
+    for(int j = 0; j < sequenceCount; j++)
+    {
+        const int count = pointsCount(distribution);
+
+        PointList list(QString("id%1").arg(j));
+        for(int pointNum = 0; pointNum < count; pointNum++)
+        {
+            list << ((pointNum % 7 == 0) ? 0.0 : double(qrand() % 1000));
+        }
+
+        seqPoints_.append(list);
+        points += count;
+    }
+
+    return points;
+}
+
+void BScaling::runConfiguration(BenchmarkRunner &runner, const int sequenceCount,
+                                const LengthDistribution distribution)
+{
+    const double points = generate(sequenceCount, distribution);
+    const QString configuration = QString("%1x%2 %3")
+            .arg(sequenceCount).arg(meanPoints_).arg(distributionName(distribution));
+
+    qWarning() << "Configuration:" << configuration << "points:" << points;
+
+    BenchmarkResult &writeResult = runner.measure("scaling/write " + configuration,
+                                                  this, &BScaling::write, points, 0.0,
+                                                  &BScaling::reopenWriter);
+    closeWriter();
+    seqPoints_.clear();
+
+    const double dataBaseSize = QFileInfo(dataBaseName_).size();
+    writeResult.bytes = dataBaseSize;
+    record(writeResult, "write", sequenceCount, distribution, 1);
+
+    reader_ = new SqlPointListReader(dataBaseName_, tableName_);
+    if(!reader_->open())
+    {
+        qWarning() << "sqlreader not open";
+        closeReader();
+        return;
+    }
+
+    reader_->appendStatistics(allStatistics());
+    idList_ = reader_->readAllItems();
+
+    record(runner.measure("scaling/read " + configuration, this, &BScaling::read, points, dataBaseSize),
+           "read", sequenceCount, distribution, 1);
+    record(runner.measure("scaling/statistics " + configuration, this, &BScaling::statistics, points, dataBaseSize),
+           "statistics", sequenceCount, distribution, 1);
+
+    closeReader();
+
+    foreach(const int threads, threadCounts_)
+    {
+        workersCount_ = threads;
+        record(runner.measure(QString("scaling/analyze %1 threads %2").arg(configuration).arg(threads),
+                              this, &BScaling::analyze, points, dataBaseSize),
+               "analyze", sequenceCount, distribution, threads);
+    }
+
+    BenchmarkResult &exportResult = runner.measure("scaling/export " + configuration,
+                                                   this, &BScaling::exportToFile, points, 0.0,
+                                                   &BScaling::removeExportFile);
+    const double exportSize = QFileInfo(exportFileName_).size();
+    exportResult.bytes = exportSize;
+    record(exportResult, "export", sequenceCount, distribution, 1);
+
+    record(runner.measure("scaling/import " + configuration, this, &BScaling::import, points, exportSize,
+                          &BScaling::removeImportDataBase),
+           "import", sequenceCount, distribution, 1);
+
+    idList_.clear();
+}
+
+void BScaling::record(BenchmarkResult &result, const QString &operation, const int sequenceCount,
+                      const LengthDistribution distribution, const int threads)
+{
+    result.parameters["operation"] = operation;
+    result.parameters["sequences"] = sequenceCount;
+    result.parameters["mean_points"] = meanPoints_;
+    result.parameters["distribution"] = distributionName(distribution);
+    result.parameters["threads"] = threads;
+
+    sweep_.append(result);
+}
+
+void BScaling::reportCurves() const
+{
+    QStringList operations;
+    operations << "write" << "read" << "analyze" << "statistics" << "export" << "import";
+
+    foreach(const QString &operation, operations)
+    {
+        qWarning() << "\n" << "Scaling of" << operation.toLocal8Bit().constData();
+        qWarning() << QString("%1 %2 %3 %4 %5 %6 %7")
+                      .arg("distribution", -13)
+                      .arg("sequences", 10)
+                      .arg("threads", 8)
+                      .arg("points/s", 12)
+                      .arg("speedup", 8)
+                      .arg("efficiency", 11)
+                      .arg("peak rss", 10).toLocal8Bit().constData();
+
+        // the speedup is relative to the first configuration of the same
+        // distribution and, for the analysis, the same sequence count
+        const BenchmarkResult *base = 0;
+
+        for(int i = 0; i < sweep_.count(); i++)
+        {
+            const BenchmarkResult &result = sweep_.at(i);
+
+            if(result.parameters.value("operation").toString() != operation)
+            {
+                continue;
+            }
+
+            const int threads = result.parameters.value("threads").toInt();
+            const bool isBase = (base == 0)
+                    || (base->parameters.value("distribution") != result.parameters.value("distribution"))
+                    || ((operation == "analyze")
+                        && (base->parameters.value("sequences") != result.parameters.value("sequences")));
+
+            if(isBase)
+            {
+                base = &result;
+            }
+
+            const double baseRate = base->pointsPerSecond();
+            const double speedup = (baseRate > 0.0) ? result.pointsPerSecond() / baseRate : 0.0;
+
+            // for the threads ideal scaling keeps the speedup at the thread
+            // count, for the data size it keeps the rate constant
+            const int baseThreads = base->parameters.value("threads").toInt();
+            const double efficiency = (operation == "analyze")
+                    ? speedup * baseThreads / qMax(1, threads)
+                    : speedup;
+
+            qWarning() << QString("%1 %2 %3 %4 %5 %6 %7")
+                          .arg(result.parameters.value("distribution").toString(), -13)
+                          .arg(result.parameters.value("sequences").toInt(), 10)
+                          .arg(threads, 8)
+                          .arg(BenchmarkRunner::formatRate(result.pointsPerSecond()), 12)
+                          .arg(speedup, 8, 'f', 2)
+                          .arg(QString("%1%").arg(efficiency * 100.0, 0, 'f', 0), 11)
+                          .arg(QString("%1 MB").arg(result.peakResidentSize / (1024.0 * 1024.0), 0, 'f', 1), 10)
+                          .toLocal8Bit().constData();
+        }
+    }
+}
+
+void BScaling::closeWriter()
+{
+    if(writer_ != 0)
+    {
+        delete writer_;
+        writer_ = 0;
+
+        SqlPointListInterface::removeConnection();
+    }
+}
+
+void BScaling::closeReader()
+{
+    if(reader_ != 0)
+    {
+        delete reader_;
+        reader_ = 0;
+
+        SqlPointListInterface::removeConnection();
+    }
+}
+
+void BScaling::removeFile(const QString &fileName)
+{
+    if(QFile::exists(fileName))
+    {
+        if(!QFile::remove(fileName))
+        {
+            qWarning() << "can't remove" << fileName;
+        }
+    }
+}
+
+void BScaling::reopenWriter()
+{
+    closeWriter();
+    removeFile(dataBaseName_);
+
+    writer_ = new SqlPointListWriter(dataBaseName_, tableName_);
+    if(!writer_->open())
+    {
+        qWarning() << "can't open writer";
+    }
+}
+
+void BScaling::removeExportFile()
+{
+    removeFile(exportFileName_);
+}
+
+void BScaling::removeImportDataBase()
+{
+    removeFile(importDataBaseName_);
+}
+
+void BScaling::write()
+{
+    writer_->write(seqPoints_);
+}
+
+void BScaling::read()
+{
+    foreach(const ID &item, idList_)
+    {
+        reader_->readValues(item);
+    }
+}
+
+void BScaling::analyze()
+{
+    NullAnalysisSink sink;
+
+    DatabaseAnalysisJob job(dataBaseName_, tableName_);
+    job.setWorkersCount(workersCount_);
+
+    if(!job.run(*collection_, &sink))
+    {
+        qWarning() << "analysis failed";
+    }
+}
+
+void BScaling::statistics()
+{
+    reader_->statistics();
+}
+
+void BScaling::exportToFile()
+{
+    CSVPointListExporter csvExporter(dataBaseName_, tableName_, exportFileName_);
+    csvExporter.exportFromDataBase();
+}
+
+void BScaling::import()
+{
+    CSVPointListImporter csvImporter(exportFileName_, importDataBaseName_, tableName_);
+    if(!csvImporter.import())
+    {
+        qWarning() << exportFileName_ << "not imported";
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef BSCALING_H
+
+#define BSCALING_H
+
+#include "BenchmarkRunner.h"
+
+#include "../src/SqlPointListReader.h"
+#include "../src/SqlPointListWriter.h"
+#include "../src/AnalysisCollection.h"
+#include "../src/AbstractAnalysisSink.h"
+
+// Sweeps the sequence count, the distribution of the sequence lengths and
+// the workers of the analysis over write, read, analyze, statistics, CSV
+// export and CSV import. Every result carries its configuration in the
+// parameters, the curves print the throughput of each operation over the
+// sweep, so the point where a subsystem stops scaling stands out.
+class BScaling
+{
+public:
+    enum LengthDistribution
+    {
+        ConstantLength,
+        UniformLength,
+        HeavyTailedLength
+    };
+
+    BScaling(const QList<int> &sequenceCounts, const int meanPoints);
+    ~BScaling();
+
+    // workers of the analysis, by default 1, 2, 4 .. up to the ideal thread count
+    QList<int> threadCounts() const;
+    void setThreadCounts(const QList<int> &counts);
+
+    QList<LengthDistribution> distributions() const;
+    void setDistributions(const QList<LengthDistribution> &distributions);
+
+    void run(BenchmarkRunner &runner);
+
+    static QString distributionName(const LengthDistribution distribution);
+
+    // heavy tailed lengths are Pareto distributed and capped at this multiple of the mean
+    static const int maxLengthFactor;
+
+private:
+    QList<int> sequenceCounts_;
+    int meanPoints_;
+    QList<int> threadCounts_;
+    QList<LengthDistribution> distributions_;
+
+    const QString dataBaseName_;
+    const QString importDataBaseName_;
+    const QString tableName_;
+    const QString exportFileName_;
+
+    SequencePointList seqPoints_;
+    IDList idList_;
+    SqlPointListWriter* writer_;
+    SqlPointListReader* reader_;
+    AnalysisCollection* collection_;
+    int workersCount_;
+
+    BenchmarkResultList sweep_;
+
+    int pointsCount(const LengthDistribution distribution);
+    double generate(const int sequenceCount, const LengthDistribution distribution);
+
+    void runConfiguration(BenchmarkRunner &runner, const int sequenceCount, const LengthDistribution distribution);
+    void record(BenchmarkResult &result, const QString &operation, const int sequenceCount,
+                const LengthDistribution distribution, const int threads);
+    void reportCurves() const;
+
+    void closeWriter();
+    void closeReader();
+    void removeFile(const QString &fileName);
+
+    void reopenWriter();
+    void removeExportFile();
+    void removeImportDataBase();
+
+    void write();
+    void read();
+    void analyze();
+    void statistics();
+    void exportToFile();
+    void import();
+};
+
+#endif // BSCALING_H
@@ -0,0 +1,95 @@
+#include "BSequenceBatch.h"
+
+BSequenceBatch::BSequenceBatch(const int sequencesCount, const int maxPoints) :
+    sequencesCount_(sequencesCount),
+    maxPoints_(maxPoints),
+    checksum_(0.0)
+{
+}
+
+void BSequenceBatch::run(BenchmarkRunner &runner)
+{
+    qsrand(QTime(0,0).secsTo(QTime::currentTime()));
+
+    AverageAnalysis average;
+    StandardDeviationAnalysis deviation;
+    collection_.addAnalysis(&average);
+    collection_.addAnalysis(&deviation);
+
+    sequences_.clear();
+    qint64 pointsCount = 0;
+
+    for(int i = 0; i < sequencesCount_; i++)
+    {
+        QVector<Point> points(1 + qrand() % maxPoints_);
+        for(int j = 0; j < points.count(); j++)
+        {
+            points[j] = double(qrand() % 1000) / 10.0;
+        }
+
+        pointsCount += points.count();
+        sequences_.append(points);
+    }
+
+    qWarning() << "sequences" << sequencesCount_ << "points" << pointsCount;
+
+    const double points = double(pointsCount);
+    const double bytes = points * sizeof(Point);
+
+    runner.measure("sequence batch/per sequence", this, &BSequenceBatch::analyzePerSequence, points, bytes);
+
+    const PointKernels::Instructions supported = PointKernels::supportedInstructions();
+
+    for(int instructions = PointKernels::Scalar; instructions <= supported; instructions++)
+    {
+        PointKernels::setInstructions(PointKernels::Instructions(instructions));
+
+        runner.measure(QString("sequence batch/batched %1").arg(PointKernels::instructionsName(PointKernels::instructions())),
+                       this, &BSequenceBatch::analyzeBatched, points, bytes);
+    }
+
+    PointKernels::setInstructions(supported);
+
+    QVector<Point> longSequence(int(qMin(pointsCount, Q_INT64_C(10000000))));
+    for(int j = 0; j < longSequence.count(); j++)
+    {
+        longSequence[j] = double(qrand() % 1000) / 10.0;
+    }
+
+    longList_ = PointList::fromVector("long", longSequence);
+
+    runner.measure("sequence batch/one long sequence", this, &BSequenceBatch::analyzeLong,
+                   longSequence.count(), longSequence.count() * sizeof(Point));
+
+    qWarning() << "checksum" << checksum_;
+}
+
+void BSequenceBatch::analyzePerSequence()
+{
+    for(int i = 0; i < sequences_.count(); i++)
+    {
+        const PointList list = PointList::fromVector(QString::number(i), sequences_.at(i));
+        checksum_ += collection_.analyzeValues(list).first();
+    }
+}
+
+void BSequenceBatch::analyzeBatched()
+{
+    SequenceBatch batch;
+
+    for(int i = 0; i < sequences_.count(); i++)
+    {
+        batch.append(QString::number(i), sequences_.at(i));
+
+        if((batch.count() == 256) || (i == sequences_.count() - 1))
+        {
+            checksum_ += collection_.analyzeBatch(batch).first();
+            batch.clear();
+        }
+    }
+}
+
+void BSequenceBatch::analyzeLong()
+{
+    checksum_ += collection_.analyzeValues(longList_).first();
+}
@@ -0,0 +1,32 @@
+#ifndef BSEQUENCEBATCH_H
+
+#define BSEQUENCEBATCH_H
+
+#include "BenchmarkRunner.h"
+
+#include "../src/AnalysisCollection.h"
+#include "../src/AverageAnalysis.h"
+#include "../src/StandardDeviationAnalysis.h"
+
+class BSequenceBatch
+{
+public:
+    BSequenceBatch(const int sequencesCount, const int maxPoints);
+
+    void run(BenchmarkRunner &runner);
+
+private:
+    int sequencesCount_;
+    int maxPoints_;
+
+    AnalysisCollection collection_;
+    QList< QVector<Point> > sequences_;
+    PointList longList_;
+    double checksum_;
+
+    void analyzePerSequence();
+    void analyzeBatched();
+    void analyzeLong();
+};
+
+#endif // BSEQUENCEBATCH_H
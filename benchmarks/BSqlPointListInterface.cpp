@@ -1,18 +1,27 @@
 #include "BSqlPointListInterface.h"
 
+#include <QFile>
+
 BSqlPointListInterface::BSqlPointListInterface(const int nRuns):
     nRuns_(nRuns)
 {
 
 }
 
-void BSqlPointListInterface::run()
+void BSqlPointListInterface::run(BenchmarkRunner &runner)
+{
+    runner.measure(QString("sql interface/create and open x%1").arg(nRuns_),
+                   this, &BSqlPointListInterface::openDatabases, 0.0, 0.0,
+                   &BSqlPointListInterface::removeDatabases);
+
+    removeDatabases();
+}
+
+void BSqlPointListInterface::removeDatabases()
 {
     for(int i = 0; i < nRuns_; ++i)
     {
-        qWarning() << "iteration : " << i << " / " << nRuns_;
         QString dataBaseName = QString("test%1.db").arg(i);
-        QString tableName = QString("table%1").arg(i);
 
         if(QFile::exists(dataBaseName))
         {
@@ -21,6 +30,15 @@ void BSqlPointListInterface::run()
                 qWarning() << "can't remove testing database";
             }
         }
+    }
+}
+
+void BSqlPointListInterface::openDatabases()
+{
+    for(int i = 0; i < nRuns_; ++i)
+    {
+        QString dataBaseName = QString("test%1.db").arg(i);
+        QString tableName = QString("table%1").arg(i);
 
         SqlPointListWriter* writer = new SqlPointListWriter(dataBaseName, tableName);
         writer->open();
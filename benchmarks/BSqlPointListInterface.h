@@ -2,22 +2,23 @@
 
 #define BSQLPOINTLISTINTERFACE_H
 
+#include "BenchmarkRunner.h"
+
 #include "../src/SqlPointListReader.h"
 #include "../src/SqlPointListWriter.h"
 
-#include "../src/ItemListModel.h"
-#include "../src/AnalysisTableModel.h"
-
 class BSqlPointListInterface
 {
 public:
     BSqlPointListInterface(const int nRuns);
 
-    void run();
+    void run(BenchmarkRunner &runner);
 
 private:
     int nRuns_;
 
+    void removeDatabases();
+    void openDatabases();
 };
 
 #endif // BSQLPOINTLISTINTERFACE_H
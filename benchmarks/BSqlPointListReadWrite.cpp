@@ -1,72 +1,102 @@
 #include "BSqlPointListReadWrite.h"
 
+#include <QFile>
+#include <QFileInfo>
+
+static const char* benchmarkTableName = "testtable";
+
 BSqlPointListReadWrite::BSqlPointListReadWrite(const int pointsCount):
-    pointsCount_(pointsCount)
+    pointsCount_(pointsCount),
+    writer_(0),
+    reader_(0)
+{
+}
+
+BSqlPointListReadWrite::~BSqlPointListReadWrite()
 {
+    closeWriter();
+    closeReader();
 }
 
-void BSqlPointListReadWrite::runRead()
-{   
+void BSqlPointListReadWrite::runRead(BenchmarkRunner &runner)
+{
     qWarning() << "Read";
-    QString dataBaseName = "benchmarkreadwrite.db";
-    QString tableName = "testtable";
 
-    if(!QFile::exists(dataBaseName))
+    if(!openReader("benchmarkreadwrite.db"))
     {
-
-        qWarning() << "can't find " << dataBaseName << ". first need runWrite()";
         return;
     }
 
-    SqlPointListReader* reader = new SqlPointListReader(dataBaseName, tableName);
-    reader->open();
-
-    SequencePointList seqList;
+    double points = 0.0;
     for(int j = 0; j < pointsCount_; j++)
     {
-        PointList points;
-
-        QTime readTime;
-        readTime.start();
-        points = reader->read(QString("id%1").arg(j));
-        qWarning() << "read pointlist"
-                   << QString("id%1").arg(j)
-                   << " with "
-                   << points.count()
-                   << " points "
-                   << readTime.elapsed() / 1000.0
-                   << "seconds";
-
-        seqList.append(points);
+        points += reader_->readPointsCount(QString("id%1").arg(j));
     }
 
-    delete reader;
+    runner.measure(QString("sql read write/read %1 lists").arg(pointsCount_),
+                   this, &BSqlPointListReadWrite::readLists, points, dataBaseSize());
 
-
-    SqlPointListInterface::removeConnection();
+    closeReader();
 }
 
-void BSqlPointListReadWrite::runWrite()
+void BSqlPointListReadWrite::runWrite(BenchmarkRunner &runner)
 {
     qDebug() << "Write";
-    QString dataBaseName = "benchmarkreadwrite.db";
-    QString tableName = "testtable";
+    dataBaseName_ = "benchmarkreadwrite.db";
+    generate();
+
+    BenchmarkResult &result = runner.measure(QString("sql read write/write %1 lists").arg(pointsCount_),
+                                             this, &BSqlPointListReadWrite::writeLists, generatedPoints(), 0.0,
+                                             &BSqlPointListReadWrite::reopenWriter);
+    closeWriter();
 
-    if(QFile::exists(dataBaseName))
+    result.bytes = dataBaseSize();
+}
+
+void BSqlPointListReadWrite::runReadAll(BenchmarkRunner &runner)
+{
+    qWarning() << "Read";
+
+    if(!openReader("benchmarkreadwriteall.db"))
     {
-        if(!QFile::remove(dataBaseName))
-        {
-            qWarning() << "can't remove testing database";
-        }
+        return;
     }
 
+    runner.measure(QString("sql read write/read all ids"),
+                   this, &BSqlPointListReadWrite::readAllItems);
+
+    items_ = reader_->readAllItems();
 
-    SqlPointListWriter* writer = new SqlPointListWriter(dataBaseName, tableName);
-    if(!writer->open())
+    double points = 0.0;
+    foreach(const ID& id, items_)
     {
-        qWarning() << "can't open writer";
+        points += reader_->readPointsCount(id);
     }
 
+    runner.measure(QString("sql read write/read all %1 lists").arg(items_.count()),
+                   this, &BSqlPointListReadWrite::readAllLists, points, dataBaseSize());
+
+    closeReader();
+}
+
+void BSqlPointListReadWrite::runWriteAll(BenchmarkRunner &runner)
+{
+    qDebug() << "Write";
+    dataBaseName_ = "benchmarkreadwriteall.db";
+    generate();
+
+    BenchmarkResult &result = runner.measure(QString("sql read write/write all %1 lists").arg(pointsCount_),
+                                             this, &BSqlPointListReadWrite::writeAll, generatedPoints(), 0.0,
+                                             &BSqlPointListReadWrite::reopenWriter);
+    closeWriter();
+
+    result.bytes = dataBaseSize();
+}
+
+void BSqlPointListReadWrite::generate()
+{
+    seqPoints_.clear();
+
     qsrand(QTime(0,0).secsTo(QTime::currentTime()));
     for(int j = 0; j < pointsCount_; j++)
     {
@@ -77,115 +107,120 @@ void BSqlPointListReadWrite::runWrite()
             points << pointNum;
         }
 
+        seqPoints_.append(points);
+    }
+}
 
-        QTime writeTime;
-        writeTime.start();
-        writer->write(points);
-        qWarning() << "write pointlist"
-                   << points.id()
-                   << " with "
-                   << pointsCount
-                   << " points "
-                   << writeTime.elapsed() / 1000.0
-                   << "seconds";
+double BSqlPointListReadWrite::generatedPoints() const
+{
+    double points = 0.0;
+    foreach(const PointList& list, seqPoints_)
+    {
+        points += list.count();
     }
 
-    delete writer;
+    return points;
+}
 
-    SqlPointListInterface::removeConnection();
+double BSqlPointListReadWrite::dataBaseSize() const
+{
+    return QFileInfo(dataBaseName_).size();
 }
 
-void BSqlPointListReadWrite::runReadAll()
+bool BSqlPointListReadWrite::openReader(const QString &dataBaseName)
 {
-    qWarning() << "Read";
-    QString dataBaseName = "benchmarkreadwriteall.db";
-    QString tableName = "testtable";
+    dataBaseName_ = dataBaseName;
 
-    if(!QFile::exists(dataBaseName))
+    if(!QFile::exists(dataBaseName_))
     {
-
-        qWarning() << "can't find " << dataBaseName << ". first need runWrite()";
-        return;
+        qWarning() << "can't find " << dataBaseName_ << ". first need runWrite()";
+        return false;
     }
 
-    SqlPointListReader* reader = new SqlPointListReader(dataBaseName, tableName);
-    if(!reader->open())
+    closeReader();
+
+    reader_ = new SqlPointListReader(dataBaseName_, benchmarkTableName);
+    if(!reader_->open())
     {
         qWarning() << "sqlreader not open";
-        return;
+        closeReader();
+        return false;
     }
 
-    QTime readTime;
-    readTime.start();
-    IDList list = reader->readAllItems();
-    qWarning() << "read"
-               << list.count()
-               << " ids "
-               << readTime.elapsed() / 1000.0
-               << "seconds";
-
+    return true;
+}
 
-    readTime.start();
-    foreach(const ID& id, list)
+void BSqlPointListReadWrite::closeReader()
+{
+    if(reader_ != 0)
     {
-        reader->read(id);
-    }
-    qWarning() << "read"
-               << list.count()
-               << " pointslist"
-               << readTime.elapsed() / 1000.0
-               << "seconds";
-
-    delete reader;
+        delete reader_;
+        reader_ = 0;
 
-
-    SqlPointListInterface::removeConnection();
+        SqlPointListInterface::removeConnection();
+    }
 }
 
-void BSqlPointListReadWrite::runWriteAll()
+void BSqlPointListReadWrite::reopenWriter()
 {
-    qDebug() << "Write";
-    QString dataBaseName = "benchmarkreadwriteall.db";
-    QString tableName = "testtable";
+    closeWriter();
 
-    if(QFile::exists(dataBaseName))
+    if(QFile::exists(dataBaseName_))
     {
-        if(!QFile::remove(dataBaseName))
+        if(!QFile::remove(dataBaseName_))
         {
             qWarning() << "can't remove testing database";
         }
     }
 
-    SqlPointListWriter* writer = new SqlPointListWriter(dataBaseName, tableName);
-    if(!writer->open())
+    writer_ = new SqlPointListWriter(dataBaseName_, benchmarkTableName);
+    if(!writer_->open())
     {
         qWarning() << "can't open writer";
     }
+}
 
-    SequencePointList seqPoints;
-    qsrand(QTime(0,0).secsTo(QTime::currentTime()));
-    for(int j = 0; j < pointsCount_; j++)
+void BSqlPointListReadWrite::closeWriter()
+{
+    if(writer_ != 0)
     {
-        const int pointsCount = (qrand() % (500) + 1);
-        PointList points(QString("id%1").arg(j));
-        for(int pointNum = 0; pointNum < pointsCount; pointNum++)
-        {
-            points << pointNum;
-        }
+        delete writer_;
+        writer_ = 0;
 
-        seqPoints.append(points);
+        SqlPointListInterface::removeConnection();
+    }
+}
+
+void BSqlPointListReadWrite::writeLists()
+{
+    foreach(const PointList& points, seqPoints_)
+    {
+        writer_->write(points);
     }
+}
+
+void BSqlPointListReadWrite::writeAll()
+{
+    writer_->write(seqPoints_);
+}
 
-    QTime writeTime;
-    writeTime.start();
-    writer->write(seqPoints);
-    qWarning() << "write "
-               << seqPoints.count()
-               << " pointslist "
-               << writeTime.elapsed() / 1000.0
-               << "seconds";
+void BSqlPointListReadWrite::readLists()
+{
+    for(int j = 0; j < pointsCount_; j++)
+    {
+        reader_->read(QString("id%1").arg(j));
+    }
+}
 
-    delete writer;
+void BSqlPointListReadWrite::readAllItems()
+{
+    reader_->readAllItems();
+}
 
-    SqlPointListInterface::removeConnection();
+void BSqlPointListReadWrite::readAllLists()
+{
+    foreach(const ID& id, items_)
+    {
+        reader_->read(id);
+    }
 }
@@ -2,6 +2,8 @@
 
 #define BSQLPOINTLISTREADWRITE_H
 
+#include "BenchmarkRunner.h"
+
 #include "../src/SqlPointListReader.h"
 #include "../src/SqlPointListWriter.h"
 
@@ -9,15 +11,38 @@ class BSqlPointListReadWrite
 {
 public:
     BSqlPointListReadWrite(const int pointsCount);
+    ~BSqlPointListReadWrite();
 
-    void runRead();
-    void runWrite();
+    void runRead(BenchmarkRunner &runner);
+    void runWrite(BenchmarkRunner &runner);
 
-    void runReadAll();
-    void runWriteAll();
+    void runReadAll(BenchmarkRunner &runner);
+    void runWriteAll(BenchmarkRunner &runner);
 
 private:
     int pointsCount_;
+
+    QString dataBaseName_;
+    SequencePointList seqPoints_;
+    IDList items_;
+    SqlPointListWriter* writer_;
+    SqlPointListReader* reader_;
+
+    void generate();
+    double generatedPoints() const;
+    double dataBaseSize() const;
+
+    bool openReader(const QString &dataBaseName);
+    void closeReader();
+
+    void reopenWriter();
+    void closeWriter();
+
+    void writeLists();
+    void writeAll();
+    void readLists();
+    void readAllItems();
+    void readAllLists();
 };
 
 #endif // BSQLPOINTLISTREADWRITE_H
@@ -0,0 +1,77 @@
+#include "BStaticAnalysisSet.h"
+
+typedef StaticAnalysisSet<StaticAverage, StaticStandardDeviation, StaticMedian> BenchmarkStaticAnalyses;
+
+BStaticAnalysisSet::BStaticAnalysisSet(const int sequencesCount, const int maxPoints) :
+    sequencesCount_(sequencesCount),
+    maxPoints_(maxPoints),
+    checksum_(0.0)
+{
+}
+
+void BStaticAnalysisSet::run(BenchmarkRunner &runner)
+{
+    qsrand(QTime(0,0).secsTo(QTime::currentTime()));
+
+    AverageAnalysis average;
+    StandardDeviationAnalysis deviation;
+    MedianAnalysis median;
+    collection_.addAnalysis(&average);
+    collection_.addAnalysis(&deviation);
+    collection_.addAnalysis(&median);
+
+    StaticAnalysisAdapter<BenchmarkStaticAnalyses> adapter;
+    adapterCollection_.addAnalysis(&adapter);
+
+    sequences_.clear();
+    qint64 pointsCount = 0;
+
+    for(int i = 0; i < sequencesCount_; i++)
+    {
+        QVector<Point> points(1 + qrand() % maxPoints_);
+        for(int j = 0; j < points.count(); j++)
+        {
+            points[j] = double(qrand() % 1000) / 10.0;
+        }
+
+        pointsCount += points.count();
+        sequences_.append(PointList::fromVector(QString::number(i), points));
+    }
+
+    qWarning() << "sequences" << sequencesCount_ << "points" << pointsCount;
+
+    const double points = double(pointsCount);
+    const double bytes = points * sizeof(Point);
+
+    runner.measure("static analysis set/analysis collection", this, &BStaticAnalysisSet::analyzeCollection, points, bytes);
+    runner.measure("static analysis set/static analysis set", this, &BStaticAnalysisSet::analyzeStaticSet, points, bytes);
+    runner.measure("static analysis set/static analysis adapter", this, &BStaticAnalysisSet::analyzeAdapter, points, bytes);
+
+    qWarning() << "checksum" << checksum_;
+}
+
+void BStaticAnalysisSet::analyzeCollection()
+{
+    for(int i = 0; i < sequences_.count(); i++)
+    {
+        checksum_ += collection_.analyzeValues(sequences_.at(i)).last();
+    }
+}
+
+void BStaticAnalysisSet::analyzeStaticSet()
+{
+    for(int i = 0; i < sequences_.count(); i++)
+    {
+        double outputs[BenchmarkStaticAnalyses::size];
+        BenchmarkStaticAnalyses::analyze(sequences_.at(i).toVector(), outputs);
+        checksum_ += outputs[BenchmarkStaticAnalyses::size - 1];
+    }
+}
+
+void BStaticAnalysisSet::analyzeAdapter()
+{
+    for(int i = 0; i < sequences_.count(); i++)
+    {
+        checksum_ += adapterCollection_.analyzeValues(sequences_.at(i)).last();
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef BSTATICANALYSISSET_H
+
+#define BSTATICANALYSISSET_H
+
+#include "BenchmarkRunner.h"
+
+#include "../src/AnalysisCollection.h"
+#include "../src/StaticAnalysisSet.h"
+#include "../src/AverageAnalysis.h"
+#include "../src/StandardDeviationAnalysis.h"
+#include "../src/MedianAnalysis.h"
+
+class BStaticAnalysisSet
+{
+public:
+    BStaticAnalysisSet(const int sequencesCount, const int maxPoints);
+
+    void run(BenchmarkRunner &runner);
+
+private:
+    int sequencesCount_;
+    int maxPoints_;
+
+    AnalysisCollection collection_;
+    AnalysisCollection adapterCollection_;
+    QList<PointList> sequences_;
+    double checksum_;
+
+    void analyzeCollection();
+    void analyzeStaticSet();
+    void analyzeAdapter();
+};
+
+#endif // BSTATICANALYSISSET_H
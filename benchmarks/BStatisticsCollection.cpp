@@ -1,30 +1,27 @@
 #include "BStatisticsCollection.h"
 
+#include <QFile>
+#include <QFileInfo>
+
 BStatisticsCollection::BStatisticsCollection() :
     dataBaseName_("benchmarkCollectionStatistics.db"),
-    tableName_("test")
+    tableName_("test"),
+    pointsCount_(0.0),
+    writer_(0),
+    statistics_(0)
 {
 
 }
 
 BStatisticsCollection::~BStatisticsCollection()
 {
-
+    delete writer_;
+    delete statistics_;
 }
 
-void BStatisticsCollection::generateDatabase(const int seqCount, const int pointsCount)
+void BStatisticsCollection::generateDatabase(BenchmarkRunner &runner, const int seqCount, const int pointsCount)
 {
-    if(QFile::exists(dataBaseName_))
-    {
-        if(!QFile::remove(dataBaseName_))
-        {
-            qWarning() << "cannot remove database";
-        }
-    }
-
-    SqlPointListWriter writer(dataBaseName_, tableName_);
-    writer.open();
-    SequencePointList seqPoints;
+    seqPoints_.clear();
     for(int i = 0; i < seqCount; i++)
     {
         PointList pointList(QString("id%1").arg(i));
@@ -32,30 +29,60 @@ void BStatisticsCollection::generateDatabase(const int seqCount, const int point
         {
             pointList << Point(j);
         }
-        seqPoints << pointList;
-        qDebug() << i << " / " << seqCount;
+        seqPoints_ << pointList;
     }
 
+    pointsCount_ = double(seqCount) * double(pointsCount);
+
+    BenchmarkResult &result = runner.measure(QString("statistics collection/write %1x%2").arg(seqCount).arg(pointsCount),
+                                             this, &BStatisticsCollection::write, pointsCount_, 0.0,
+                                             &BStatisticsCollection::reopenWriter);
+
+    delete writer_;
+    writer_ = 0;
+    seqPoints_.clear();
 
-    qWarning() << "----Start Write to DataBase----";
-    QTime time(QTime::currentTime());
-    writer.write(seqPoints);
-    const int timeElapsed = time.secsTo(QTime::currentTime());
-    qWarning() << "----End Write to DataBase----";
+    SqlPointListInterface::removeConnection();
+
+    result.bytes = QFileInfo(dataBaseName_).size();
+    qWarning() << "Database size: " << QFileInfo(dataBaseName_).size() / 1024 << " kb";
+}
+
+void BStatisticsCollection::statistics(BenchmarkRunner &runner)
+{
+    delete statistics_;
+    statistics_ = new IncSequenceCountStatistics;
+    statistics_->open(dataBaseName_, tableName_);
 
-    qWarning() << "Database writen " << seqCount << " sequence with " << pointsCount << " points";
-    qWarning() << "Database write time: " << timeElapsed << " s";
-    QFileInfo info(dataBaseName_);
-    qWarning() << "Database size: " << info.size() / 1024 << " kb";
+    runner.measure("statistics collection/inc sequence count", this, &BStatisticsCollection::execStatistics,
+                   pointsCount_, QFileInfo(dataBaseName_).size());
 }
 
-void BStatisticsCollection::statistics()
+void BStatisticsCollection::reopenWriter()
 {
-    IncSequenceCountStatistics statistics;
-    statistics.open(dataBaseName_, tableName_);
+    delete writer_;
+    writer_ = 0;
 
-    QTime time(QTime::currentTime());
-    statistics.exec();
-    const int timeElapsed = time.secsTo(QTime::currentTime());
-    qWarning() << "statistics exec time " << timeElapsed << " s";
+    SqlPointListInterface::removeConnection();
+
+    if(QFile::exists(dataBaseName_))
+    {
+        if(!QFile::remove(dataBaseName_))
+        {
+            qWarning() << "cannot remove database";
+        }
+    }
+
+    writer_ = new SqlPointListWriter(dataBaseName_, tableName_);
+    writer_->open();
+}
+
+void BStatisticsCollection::write()
+{
+    writer_->write(seqPoints_);
+}
+
+void BStatisticsCollection::execStatistics()
+{
+    statistics_->exec();
 }
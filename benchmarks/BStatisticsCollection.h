@@ -2,6 +2,8 @@
 
 #define BSTATISTICSCOLLECTION_H
 
+#include "BenchmarkRunner.h"
+
 #include "../src/StatisticsCollection.h"
 #include "../src/SqlPointListWriter.h"
 
@@ -11,12 +13,21 @@ class BStatisticsCollection
 public:
     BStatisticsCollection();
     ~BStatisticsCollection();
-    void generateDatabase(const int seqCount, const int pointsCount);
-    void statistics();
+    void generateDatabase(BenchmarkRunner &runner, const int seqCount, const int pointsCount);
+    void statistics(BenchmarkRunner &runner);
 
 private:
     const QString dataBaseName_;
     const QString tableName_;
+
+    SequencePointList seqPoints_;
+    double pointsCount_;
+    SqlPointListWriter* writer_;
+    IncSequenceCountStatistics* statistics_;
+
+    void reopenWriter();
+    void write();
+    void execStatistics();
 };
 
 #endif // BSTATISTICSCOLLECTION_H
@@ -0,0 +1,320 @@
+#include "BenchmarkComparison.h"
+
+#include <QHash>
+#include <QSet>
+#include <QPair>
+#include <qmath.h>
+
+const int BenchmarkComparison::exactSamples_ = 20;
+
+BenchmarkDifference::BenchmarkDifference() :
+    status(Unchanged),
+    baselineMedian(0),
+    currentMedian(0),
+    change(0.0),
+    pValue(1.0)
+{
+}
+
+BenchmarkComparison::BenchmarkComparison(const double threshold, const double significance) :
+    threshold_(threshold),
+    significance_(significance)
+{
+}
+
+double BenchmarkComparison::threshold() const
+{
+    return threshold_;
+}
+
+void BenchmarkComparison::setThreshold(const double threshold)
+{
+    threshold_ = qMax(0.0, threshold);
+}
+
+double BenchmarkComparison::significance() const
+{
+    return significance_;
+}
+
+void BenchmarkComparison::setSignificance(const double significance)
+{
+    significance_ = qBound(0.0, significance, 1.0);
+}
+
+bool BenchmarkComparison::compare(const BenchmarkResultList &baseline, const BenchmarkResultList &current)
+{
+    differences_.clear();
+
+    QHash<QString, int> baselineIndexes;
+    for(int i = 0; i < baseline.count(); i++)
+    {
+        baselineIndexes.insert(baseline.at(i).name, i);
+    }
+
+    QSet<QString> compared;
+
+    foreach(const BenchmarkResult &result, current)
+    {
+        BenchmarkDifference difference;
+        difference.name = result.name;
+        difference.currentMedian = result.median();
+
+        compared.insert(result.name);
+
+        if(!baselineIndexes.contains(result.name))
+        {
+            difference.status = BenchmarkDifference::Added;
+            differences_.append(difference);
+            continue;
+        }
+
+        const BenchmarkResult &base = baseline.at(baselineIndexes.value(result.name));
+        difference.baselineMedian = base.median();
+
+        if(difference.baselineMedian > 0)
+        {
+            difference.change = double(difference.currentMedian - difference.baselineMedian)
+                    / difference.baselineMedian;
+        }
+
+        difference.pValue = mannWhitneyPValue(base.samples, result.samples);
+
+        if(difference.pValue < significance_)
+        {
+            if(difference.change > threshold_)
+            {
+                difference.status = BenchmarkDifference::Regression;
+            }
+            else if(difference.change < -threshold_)
+            {
+                difference.status = BenchmarkDifference::Improvement;
+            }
+        }
+
+        differences_.append(difference);
+    }
+
+    foreach(const BenchmarkResult &base, baseline)
+    {
+        if(!compared.contains(base.name))
+        {
+            BenchmarkDifference difference;
+            difference.name = base.name;
+            difference.status = BenchmarkDifference::Removed;
+            difference.baselineMedian = base.median();
+
+            differences_.append(difference);
+        }
+    }
+
+    return !hasRegression();
+}
+
+const BenchmarkDifferenceList &BenchmarkComparison::differences() const
+{
+    return differences_;
+}
+
+bool BenchmarkComparison::hasRegression() const
+{
+    foreach(const BenchmarkDifference &difference, differences_)
+    {
+        if(difference.status == BenchmarkDifference::Regression)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void BenchmarkComparison::report() const
+{
+    qWarning() << QString("%1 %2 %3 %4 %5 %6")
+                  .arg("benchmark", -48)
+                  .arg("baseline", 12)
+                  .arg("current", 12)
+                  .arg("change", 9)
+                  .arg("p-value", 8)
+                  .arg("status", -11).toLocal8Bit().constData();
+
+    int regressions = 0;
+
+    foreach(const BenchmarkDifference &difference, differences_)
+    {
+        const bool isCompared = (difference.status != BenchmarkDifference::Added)
+                && (difference.status != BenchmarkDifference::Removed);
+
+        qWarning() << QString("%1 %2 %3 %4 %5 %6")
+                      .arg(difference.name, -48)
+                      .arg((difference.status == BenchmarkDifference::Added)
+                           ? QString("-") : BenchmarkRunner::formatNanoseconds(difference.baselineMedian), 12)
+                      .arg((difference.status == BenchmarkDifference::Removed)
+                           ? QString("-") : BenchmarkRunner::formatNanoseconds(difference.currentMedian), 12)
+                      .arg(isCompared ? QString("%1%").arg(difference.change * 100.0, 0, 'f', 1) : QString("-"), 9)
+                      .arg(isCompared ? QString::number(difference.pValue, 'f', 4) : QString("-"), 8)
+                      .arg(statusName(difference.status), -11).toLocal8Bit().constData();
+
+        if(difference.status == BenchmarkDifference::Regression)
+        {
+            regressions++;
+        }
+    }
+
+    qWarning() << QString("%1 regressions over %2% with p < %3")
+                  .arg(regressions)
+                  .arg(threshold_ * 100.0)
+                  .arg(significance_).toLocal8Bit().constData();
+}
+
+double BenchmarkComparison::mannWhitneyPValue(const QVector<qint64> &first, const QVector<qint64> &second)
+{
+    const int firstCount = first.count();
+    const int secondCount = second.count();
+
+    if((firstCount == 0) || (secondCount == 0))
+    {
+        return 1.0;
+    }
+
+    // samples with the sample they belong to, 0 first and 1 second
+    QVector< QPair<qint64, int> > samples;
+    samples.reserve(firstCount + secondCount);
+
+    foreach(const qint64 sample, first)
+    {
+        samples.append(qMakePair(sample, 0));
+    }
+    foreach(const qint64 sample, second)
+    {
+        samples.append(qMakePair(sample, 1));
+    }
+
+    qSort(samples);
+
+    // rank sum of the first sample, ties get their average rank
+    double firstRanks = 0.0;
+    double ties = 0.0;
+
+    int i = 0;
+    while(i < samples.count())
+    {
+        int j = i + 1;
+        while((j < samples.count()) && (samples.at(j).first == samples.at(i).first))
+        {
+            j++;
+        }
+
+        const double rank = (i + 1 + j) / 2.0;
+        for(int k = i; k < j; k++)
+        {
+            if(samples.at(k).second == 0)
+            {
+                firstRanks += rank;
+            }
+        }
+
+        const double tied = j - i;
+        ties += tied * tied * tied - tied;
+
+        i = j;
+    }
+
+    const double pairs = double(firstCount) * double(secondCount);
+    const double firstU = firstRanks - firstCount * (firstCount + 1.0) / 2.0;
+    const double u = qMin(firstU, pairs - firstU);
+
+    if((ties == 0.0) && (firstCount <= exactSamples_) && (secondCount <= exactSamples_))
+    {
+        return exactPValue(firstCount, secondCount, u);
+    }
+
+    const double count = firstCount + secondCount;
+    const double variance = pairs / 12.0 * ((count + 1.0) - ties / (count * (count - 1.0)));
+
+    if(variance <= 0.0)
+    {
+        return 1.0;
+    }
+
+    const double z = (pairs / 2.0 - u - 0.5) / qSqrt(variance);
+
+    return (z <= 0.0) ? 1.0 : qMin(1.0, normalPValue(z));
+}
+
+QString BenchmarkComparison::statusName(const BenchmarkDifference::Status status)
+{
+    switch(status)
+    {
+    case BenchmarkDifference::Unchanged:
+        return "unchanged";
+    case BenchmarkDifference::Improvement:
+        return "improvement";
+    case BenchmarkDifference::Regression:
+        return "REGRESSION";
+    case BenchmarkDifference::Added:
+        return "added";
+    case BenchmarkDifference::Removed:
+        return "removed";
+    }
+
+    return QString();
+}
+
+double BenchmarkComparison::exactPValue(const int firstCount, const int secondCount, const double u)
+{
+    // counts[j][k] is the number of orderings of i first and j second samples
+    // with U = k; the largest of i + j samples either belongs to the first
+    // sample and is above all j second ones, or belongs to the second sample
+    QVector< QVector<double> > previous(secondCount + 1, QVector<double>(1, 1.0));
+    QVector< QVector<double> > counts = previous;
+
+    for(int i = 1; i <= firstCount; i++)
+    {
+        counts[0] = QVector<double>(1, 1.0);
+
+        for(int j = 1; j <= secondCount; j++)
+        {
+            counts[j] = QVector<double>(i * j + 1, 0.0);
+
+            for(int k = 0; k < previous.at(j).count(); k++)
+            {
+                counts[j][k + j] += previous.at(j).at(k);
+            }
+            for(int k = 0; k < counts.at(j - 1).count(); k++)
+            {
+                counts[j][k] += counts.at(j - 1).at(k);
+            }
+        }
+
+        previous = counts;
+    }
+
+    const QVector<double> &distribution = counts.at(secondCount);
+
+    double total = 0.0;
+    double tail = 0.0;
+    for(int k = 0; k < distribution.count(); k++)
+    {
+        total += distribution.at(k);
+        if(k <= u)
+        {
+            tail += distribution.at(k);
+        }
+    }
+
+    return qMin(1.0, 2.0 * tail / total);
+}
+
+double BenchmarkComparison::normalPValue(const double z)
+{
+    // erfc(z / sqrt(2)) with the Abramowitz and Stegun 7.1.26 approximation,
+    // absolute error below 1.5e-7
+    const double x = z / qSqrt(2.0);
+    const double t = 1.0 / (1.0 + 0.3275911 * x);
+    const double polynomial = t * (0.254829592 + t * (-0.284496736 + t * (1.421413741
+                              + t * (-1.453152027 + t * 1.061405429))));
+
+    return polynomial * qExp(-x * x);
+}
@@ -0,0 +1,76 @@
+#ifndef BENCHMARKCOMPARISON_H
+
+#define BENCHMARKCOMPARISON_H
+
+#include "BenchmarkRunner.h"
+
+// Change of one benchmark between a baseline and the current run. change is
+// relative to the baseline median, 0.1 is 10% slower; pValue is the two
+// sided Mann-Whitney U test of the samples, 1 when it can't be tested.
+class BenchmarkDifference
+{
+public:
+    enum Status
+    {
+        Unchanged,
+        Improvement,
+        Regression,
+        Added,
+        Removed
+    };
+
+    BenchmarkDifference();
+
+    QString name;
+    Status status;
+    qint64 baselineMedian;
+    qint64 currentMedian;
+    double change;
+    double pValue;
+};
+
+typedef QList<BenchmarkDifference> BenchmarkDifferenceList;
+
+// Compares the samples of every benchmark with the baseline by name. A
+// benchmark regressed when its median is slower by more than threshold()
+// and the samples differ with a p-value below significance(); noise of a
+// few runs or a significant but negligible change doesn't fail the gate.
+class BenchmarkComparison
+{
+public:
+    BenchmarkComparison(const double threshold = 0.05, const double significance = 0.05);
+
+    double threshold() const;
+    void setThreshold(const double threshold);
+
+    double significance() const;
+    void setSignificance(const double significance);
+
+    // false when a benchmark regressed
+    bool compare(const BenchmarkResultList &baseline, const BenchmarkResultList &current);
+
+    const BenchmarkDifferenceList& differences() const;
+    bool hasRegression() const;
+
+    void report() const;
+
+    // two sided p-value that both samples come from the same distribution,
+    // exact for small samples without ties, else the normal approximation
+    // with tie and continuity correction
+    static double mannWhitneyPValue(const QVector<qint64> &first, const QVector<qint64> &second);
+
+    static QString statusName(const BenchmarkDifference::Status status);
+
+private:
+    double threshold_;
+    double significance_;
+    BenchmarkDifferenceList differences_;
+
+    // largest sample count of the exact test
+    static const int exactSamples_;
+
+    static double exactPValue(const int firstCount, const int secondCount, const double u);
+    static double normalPValue(const double z);
+};
+
+#endif // BENCHMARKCOMPARISON_H
@@ -0,0 +1,475 @@
+#include "BenchmarkRunner.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <QDateTime>
+#include <QRegExp>
+#include <qmath.h>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+const int BenchmarkRunner::defaultWarmups_ = 1;
+const int BenchmarkRunner::defaultRepetitions_ = 10;
+
+BenchmarkResult::BenchmarkResult(const QString &name, const double points, const double bytes) :
+    name(name),
+    points(points),
+    bytes(bytes),
+    peakResidentSize(-1)
+{
+}
+
+qint64 BenchmarkResult::minimum() const
+{
+    return percentile(0.0);
+}
+
+qint64 BenchmarkResult::median() const
+{
+    if(samples.isEmpty())
+    {
+        return 0;
+    }
+
+    QVector<qint64> sorted = samples;
+    qSort(sorted);
+
+    const int middle = sorted.count() / 2;
+    return (sorted.count() % 2 == 1) ? sorted.at(middle) : (sorted.at(middle - 1) + sorted.at(middle)) / 2;
+}
+
+qint64 BenchmarkResult::percentile(const double p) const
+{
+    if(samples.isEmpty())
+    {
+        return 0;
+    }
+
+    QVector<qint64> sorted = samples;
+    qSort(sorted);
+
+    const int rank = qBound(1, int(qCeil(p / 100.0 * sorted.count())), sorted.count());
+    return sorted.at(rank - 1);
+}
+
+double BenchmarkResult::mean() const
+{
+    if(samples.isEmpty())
+    {
+        return 0.0;
+    }
+
+    double sum = 0.0;
+    foreach(const qint64 sample, samples)
+    {
+        sum += sample;
+    }
+
+    return sum / samples.count();
+}
+
+double BenchmarkResult::pointsPerSecond() const
+{
+    const qint64 nanoseconds = median();
+    return (nanoseconds > 0) ? points * 1e9 / nanoseconds : 0.0;
+}
+
+double BenchmarkResult::bytesPerSecond() const
+{
+    const qint64 nanoseconds = median();
+    return (nanoseconds > 0) ? bytes * 1e9 / nanoseconds : 0.0;
+}
+
+BenchmarkRunner::BenchmarkRunner(const QString &suite) :
+    suite_(suite),
+    warmups_(defaultWarmups_),
+    repetitions_(defaultRepetitions_)
+{
+}
+
+QString BenchmarkRunner::suite() const
+{
+    return suite_;
+}
+
+int BenchmarkRunner::warmups() const
+{
+    return warmups_;
+}
+
+void BenchmarkRunner::setWarmups(const int warmups)
+{
+    warmups_ = qMax(0, warmups);
+}
+
+int BenchmarkRunner::repetitions() const
+{
+    return repetitions_;
+}
+
+void BenchmarkRunner::setRepetitions(const int repetitions)
+{
+    repetitions_ = qMax(1, repetitions);
+}
+
+const BenchmarkResultList &BenchmarkRunner::results() const
+{
+    return results_;
+}
+
+void BenchmarkRunner::clear()
+{
+    results_.clear();
+}
+
+void BenchmarkRunner::report() const
+{
+    qWarning() << QString("%1 %2 %3 %4 %5 %6")
+                  .arg("benchmark", -48)
+                  .arg("min", 12)
+                  .arg("median", 12)
+                  .arg("p95", 12)
+                  .arg("points/s", 12)
+                  .arg("bytes/s", 12).toLocal8Bit().constData();
+
+    foreach(const BenchmarkResult &result, results_)
+    {
+        qWarning() << QString("%1 %2 %3 %4 %5 %6")
+                      .arg(result.name, -48)
+                      .arg(formatNanoseconds(result.minimum()), 12)
+                      .arg(formatNanoseconds(result.median()), 12)
+                      .arg(formatNanoseconds(result.percentile(95.0)), 12)
+                      .arg(formatRate(result.pointsPerSecond()), 12)
+                      .arg(formatRate(result.bytesPerSecond()), 12).toLocal8Bit().constData();
+    }
+}
+
+static QString jsonString(const QString &value)
+{
+    QString escaped = value;
+    escaped.replace('\\', "\\\\").replace('"', "\\\"");
+    return "\"" + escaped + "\"";
+}
+
+static QString jsonNumber(const double value)
+{
+    return QString::number(value, 'g', 17);
+}
+
+static QString jsonObject(const QVariantMap &values)
+{
+    QStringList members;
+
+    for(QVariantMap::const_iterator i = values.constBegin(); i != values.constEnd(); ++i)
+    {
+        const bool isNumber = (i.value().type() == QVariant::Int)
+                || (i.value().type() == QVariant::LongLong)
+                || (i.value().type() == QVariant::Double);
+
+        members << jsonString(i.key()) + ": "
+                   + (isNumber ? jsonNumber(i.value().toDouble()) : jsonString(i.value().toString()));
+    }
+
+    return "{" + members.join(", ") + "}";
+}
+
+QString BenchmarkRunner::toJson() const
+{
+    QStringList benchmarks;
+
+    foreach(const BenchmarkResult &result, results_)
+    {
+        QStringList samples;
+        foreach(const qint64 sample, result.samples)
+        {
+            samples << QString::number(sample);
+        }
+
+        benchmarks << QString("    {\"name\": %1, \"repetitions\": %2, \"min_ns\": %3, \"median_ns\": %4, "
+                              "\"p95_ns\": %5, \"mean_ns\": %6, \"points\": %7, \"bytes\": %8, "
+                              "\"points_per_second\": %9, \"bytes_per_second\": %10, \"peak_rss_bytes\": %11, "
+                              "\"parameters\": %12, \"samples_ns\": [%13]}")
+                      .arg(jsonString(result.name))
+                      .arg(result.samples.count())
+                      .arg(result.minimum())
+                      .arg(result.median())
+                      .arg(result.percentile(95.0))
+                      .arg(jsonNumber(result.mean()))
+                      .arg(jsonNumber(result.points))
+                      .arg(jsonNumber(result.bytes))
+                      .arg(jsonNumber(result.pointsPerSecond()))
+                      .arg(jsonNumber(result.bytesPerSecond()))
+                      .arg(result.peakResidentSize)
+                      .arg(jsonObject(result.parameters))
+                      .arg(samples.join(", "));
+    }
+
+    return QString("{\n  \"suite\": %1,\n  \"date\": %2,\n  \"warmups\": %3,\n  \"repetitions\": %4,\n"
+                   "  \"benchmarks\": [\n%5\n  ]\n}\n")
+            .arg(jsonString(suite_))
+            .arg(jsonString(QDateTime::currentDateTime().toString(Qt::ISODate)))
+            .arg(warmups_)
+            .arg(repetitions_)
+            .arg(benchmarks.join(",\n"));
+}
+
+bool BenchmarkRunner::writeJson(const QString &fileName) const
+{
+    QFile file(fileName);
+    if(!file.open(QFile::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+    {
+        qWarning() << fileName << "not open to write";
+        return false;
+    }
+
+    QTextStream stream(&file);
+    stream << toJson();
+
+    return true;
+}
+
+// pattern of a string written by jsonString(), the content is captured
+static const char* jsonStringPattern = "\"((?:[^\"\\\\]|\\\\.)*)\"";
+
+static QString jsonUnescape(const QString &value)
+{
+    QString unescaped;
+    unescaped.reserve(value.count());
+
+    for(int i = 0; i < value.count(); i++)
+    {
+        if((value.at(i) == '\\') && (i + 1 < value.count()))
+        {
+            i++;
+        }
+
+        unescaped.append(value.at(i));
+    }
+
+    return unescaped;
+}
+
+static bool jsonMember(const QString &line, const QString &key, QString *value)
+{
+    QRegExp member("\"" + QRegExp::escape(key) + "\": ([^,}\\]]+)");
+    if(member.indexIn(line) < 0)
+    {
+        return false;
+    }
+
+    *value = member.cap(1).trimmed();
+    return true;
+}
+
+bool BenchmarkRunner::parseJsonResult(const QString &line, BenchmarkResult *result)
+{
+    QRegExp name(QString("\"name\": ") + jsonStringPattern);
+    QRegExp samples("\"samples_ns\": \\[([^\\]]*)\\]");
+
+    if((name.indexIn(line) < 0) || (samples.indexIn(line) < 0))
+    {
+        return false;
+    }
+
+    *result = BenchmarkResult(jsonUnescape(name.cap(1)));
+
+    QString value;
+    if(jsonMember(line, "points", &value))
+    {
+        result->points = value.toDouble();
+    }
+    if(jsonMember(line, "bytes", &value))
+    {
+        result->bytes = value.toDouble();
+    }
+    if(jsonMember(line, "peak_rss_bytes", &value))
+    {
+        result->peakResidentSize = value.toLongLong();
+    }
+
+    foreach(const QString &sample, samples.cap(1).split(',', QString::SkipEmptyParts))
+    {
+        bool isNumber = false;
+        const qint64 nanoseconds = sample.trimmed().toLongLong(&isNumber);
+        if(!isNumber)
+        {
+            return false;
+        }
+
+        result->samples.append(nanoseconds);
+    }
+
+    // the values of the parameters are strings or numbers, never objects
+    QRegExp parameters("\"parameters\": \\{([^}]*)\\}");
+    if(parameters.indexIn(line) >= 0)
+    {
+        const QString members = parameters.cap(1);
+        QRegExp parameter(QString(jsonStringPattern) + ": (" + jsonStringPattern + "|[^,]+)");
+
+        int position = 0;
+        while((position = parameter.indexIn(members, position)) >= 0)
+        {
+            const QString key = jsonUnescape(parameter.cap(1));
+            if(parameter.cap(2).startsWith('"'))
+            {
+                result->parameters[key] = jsonUnescape(parameter.cap(3));
+            }
+            else
+            {
+                result->parameters[key] = parameter.cap(2).trimmed().toDouble();
+            }
+
+            position += parameter.matchedLength();
+        }
+    }
+
+    return true;
+}
+
+bool BenchmarkRunner::readJson(const QString &fileName, BenchmarkResultList *results)
+{
+    QFile file(fileName);
+    if(!file.open(QFile::ReadOnly | QIODevice::Text))
+    {
+        qWarning() << fileName << "not open to read";
+        return false;
+    }
+
+    results->clear();
+
+    // toJson() writes one benchmark per line
+    QTextStream stream(&file);
+    while(!stream.atEnd())
+    {
+        const QString line = stream.readLine().trimmed();
+        if(!line.startsWith("{\"name\""))
+        {
+            continue;
+        }
+
+        BenchmarkResult result;
+        if(!parseJsonResult(line, &result))
+        {
+            qWarning() << fileName << "has a malformed benchmark:" << line;
+            return false;
+        }
+
+        results->append(result);
+    }
+
+    return true;
+}
+
+QString BenchmarkRunner::formatNanoseconds(const double nanoseconds)
+{
+    if(nanoseconds >= 1e9)
+    {
+        return QString::number(nanoseconds / 1e9, 'f', 3) + " s";
+    }
+    if(nanoseconds >= 1e6)
+    {
+        return QString::number(nanoseconds / 1e6, 'f', 3) + " ms";
+    }
+    if(nanoseconds >= 1e3)
+    {
+        return QString::number(nanoseconds / 1e3, 'f', 3) + " us";
+    }
+
+    return QString::number(nanoseconds, 'f', 0) + " ns";
+}
+
+QString BenchmarkRunner::formatRate(const double perSecond)
+{
+    if(perSecond <= 0.0)
+    {
+        return "-";
+    }
+    if(perSecond >= 1e9)
+    {
+        return QString::number(perSecond / 1e9, 'f', 2) + " G";
+    }
+    if(perSecond >= 1e6)
+    {
+        return QString::number(perSecond / 1e6, 'f', 2) + " M";
+    }
+    if(perSecond >= 1e3)
+    {
+        return QString::number(perSecond / 1e3, 'f', 2) + " k";
+    }
+
+    return QString::number(perSecond, 'f', 2);
+}
+
+qint64 BenchmarkRunner::peakResidentSize()
+{
+#if defined(Q_OS_LINUX)
+    QFile status("/proc/self/status");
+    if(status.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        const QStringList lines = QString(status.readAll()).split('\n');
+        foreach(const QString &line, lines)
+        {
+            // "VmHWM:     1234 kB"
+            if(line.startsWith("VmHWM:"))
+            {
+                return line.section(':', 1).trimmed().section(' ', 0, 0).toLongLong() * 1024;
+            }
+        }
+    }
+#endif
+
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return qint64(counters.PeakWorkingSetSize);
+    }
+#elif defined(Q_OS_MAC)
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        return qint64(usage.ru_maxrss);
+    }
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        return qint64(usage.ru_maxrss) * 1024;
+    }
+#endif
+
+    return -1;
+}
+
+bool BenchmarkRunner::resetPeakResidentSize()
+{
+#if defined(Q_OS_LINUX)
+    // since Linux 4.0 writing 5 resets VmHWM to the current resident size
+    QFile clearRefs("/proc/self/clear_refs");
+    if(clearRefs.open(QIODevice::WriteOnly))
+    {
+        return clearRefs.write("5") == 1;
+    }
+#endif
+
+    return false;
+}
+
+BenchmarkResult &BenchmarkRunner::append(const BenchmarkResult &result)
+{
+    results_.append(result);
+
+    qWarning() << QString("%1 median %2 p95 %3 min %4 peak rss %5 MB")
+                  .arg(result.name)
+                  .arg(formatNanoseconds(result.median()))
+                  .arg(formatNanoseconds(result.percentile(95.0)))
+                  .arg(formatNanoseconds(result.minimum()))
+                  .arg(result.peakResidentSize / (1024.0 * 1024.0), 0, 'f', 1).toLocal8Bit().constData();
+
+    return results_.last();
+}
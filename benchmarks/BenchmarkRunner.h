@@ -0,0 +1,122 @@
+#ifndef BENCHMARKRUNNER_H
+
+#define BENCHMARKRUNNER_H
+
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QVector>
+#include <QVariant>
+#include <QDebug>
+
+// Timings of one benchmark, one sample in nanoseconds per repetition.
+// points and bytes are processed by one repetition and give the throughput
+// at the median time. parameters describe the configuration of a sweep.
+class BenchmarkResult
+{
+public:
+    BenchmarkResult(const QString &name = QString(), const double points = 0.0, const double bytes = 0.0);
+
+    qint64 minimum() const;
+    qint64 median() const;
+    // nearest rank percentile, p from 0 to 100
+    qint64 percentile(const double p) const;
+    double mean() const;
+
+    double pointsPerSecond() const;
+    double bytesPerSecond() const;
+
+    QString name;
+    double points;
+    double bytes;
+    QVector<qint64> samples;
+
+    // peak resident set size of the process during the benchmark in bytes, -1 when unknown
+    qint64 peakResidentSize;
+    QVariantMap parameters;
+};
+
+typedef QList<BenchmarkResult> BenchmarkResultList;
+
+// Runs each benchmark warmups() times untimed and repetitions() times timed
+// with QElapsedTimer, prints a table of the results and writes them as JSON
+// with every sample, so runs can be compared later.
+class BenchmarkRunner
+{
+public:
+    BenchmarkRunner(const QString &suite = "number-analysis");
+
+    QString suite() const;
+
+    int warmups() const;
+    void setWarmups(const int warmups);
+
+    int repetitions() const;
+    void setRepetitions(const int repetitions);
+
+    // setUp is called untimed before every call of run
+    template<class T>
+    BenchmarkResult& measure(const QString &name, T *benchmark, void (T::*run)(),
+                             const double points = 0.0, const double bytes = 0.0,
+                             void (T::*setUp)() = 0)
+    {
+        BenchmarkResult result(name, points, bytes);
+        result.samples.reserve(repetitions_);
+
+        resetPeakResidentSize();
+
+        QElapsedTimer timer;
+
+        for(int i = 0; i < warmups_ + repetitions_; i++)
+        {
+            if(setUp != 0)
+            {
+                (benchmark->*setUp)();
+            }
+
+            timer.start();
+            (benchmark->*run)();
+            const qint64 elapsed = timer.nsecsElapsed();
+
+            if(i >= warmups_)
+            {
+                result.samples.append(elapsed);
+            }
+        }
+
+        result.peakResidentSize = peakResidentSize();
+
+        return append(result);
+    }
+
+    const BenchmarkResultList& results() const;
+    void clear();
+
+    void report() const;
+
+    QString toJson() const;
+    bool writeJson(const QString &fileName) const;
+
+    // results of a file written by writeJson(), e.g. a baseline of an earlier run
+    static bool readJson(const QString &fileName, BenchmarkResultList *results);
+    static bool parseJsonResult(const QString &line, BenchmarkResult *result);
+
+    static QString formatNanoseconds(const double nanoseconds);
+    static QString formatRate(const double perSecond);
+
+    // without a reset, as on Windows, the peak is the one of the whole process so far
+    static qint64 peakResidentSize();
+    static bool resetPeakResidentSize();
+
+private:
+    QString suite_;
+    int warmups_;
+    int repetitions_;
+    BenchmarkResultList results_;
+
+    static const int defaultWarmups_;
+    static const int defaultRepetitions_;
+
+    BenchmarkResult& append(const BenchmarkResult &result);
+};
+
+#endif // BENCHMARKRUNNER_H
@@ -0,0 +1,103 @@
+# Analysis engine: points, analyses, storage, import/export and the
+# workers. Only QtCore and QtSql are used, see engine.pro.
+
+INCLUDEPATH += $$PWD/src
+
+# hot path counters and timers of Metrics.h, compiled out without it
+CONFIG(metrics){
+    DEFINES += METRICS
+}
+
+SOURCES += src/StupidAnalysis.cpp \
+    src/AverageAnalysis.cpp \
+    src/AverageIgnoreNullAnalysis.cpp \
+    src/AbstractAnalysis.cpp \
+    src/AnalysisCollection.cpp \
+    src/AnalysisResultMatrix.cpp \
+    src/AnalysisRowOrder.cpp \
+    src/AnalysisWorker.cpp \
+    src/AnalysisEvaluator.cpp \
+    src/ItemPages.cpp \
+    src/StandardDeviationAnalysis.cpp \
+    src/AbstractPointListReader.cpp \
+    src/SqlPointListReader.cpp \
+    src/SqlPointListWriter.cpp \
+    src/SqlPointListInterface.cpp \
+    src/DatabaseGenerator.cpp \
+    src/PointListGenerator.cpp \
+    src/PointListStorageStatistics.cpp \
+    src/CSVPointListImporter.cpp \
+    src/CSVPointListValidator.cpp \
+    src/CSVPointListExporter.cpp \
+    src/MedianAnalysis.cpp \
+    src/PointList.cpp \
+    src/PointKernels.cpp \
+    src/SequenceBatch.cpp \
+    src/PointAccumulator.cpp \
+    src/ParallelPoints.cpp \
+    src/TDigest.cpp \
+    src/QuantileSketchAnalysis.cpp \
+    src/PercentileAnalysis.cpp \
+    src/WindowAnalysis.cpp \
+    src/SequenceState.cpp \
+    src/AnalysisIntermediates.cpp \
+    src/AnalysisCostModel.cpp \
+    src/SqliteAggregateFunctions.cpp \
+    src/AbstractAnalysisSink.cpp \
+    src/SqlAnalysisSink.cpp \
+    src/CSVAnalysisSink.cpp \
+    src/DatabaseAnalysisJob.cpp \
+    src/StorageLoader.cpp \
+    src/Metrics.cpp \
+    src/SequencePointList.cpp \
+    src/FirstQuartileAnalysis.cpp \
+    src/ThirdQuartileAnalysis.cpp
+
+HEADERS += src/StupidAnalysis.h \
+    src/AbstractAnalysis.h \
+    src/AnalysisCollection.h \
+    src/AverageIgnoreNullAnalysis.h \
+    src/AverageAnalysis.h \
+    src/AnalysisResultMatrix.h \
+    src/AnalysisRowOrder.h \
+    src/AnalysisWorker.h \
+    src/AnalysisEvaluator.h \
+    src/ItemPages.h \
+    src/StandardDeviationAnalysis.h \
+    src/AbstractPointListReader.h \
+    src/SqlPointListReader.h \
+    src/SqlPointListWriter.h \
+    src/SqlPointListInterface.h \
+    src/DatabaseGenerator.h \
+    src/PointListGenerator.h \
+    src/PointListStorageStatistics.h \
+    src/Metatypes.h \
+    src/StatisticsCollection.h \
+    src/CSVPointListImporter.h \
+    src/CSVPointListValidator.h \
+    src/CSVPointListExporter.h \
+    src/MedianAnalysis.h \
+    src/PointList.h \
+    src/PointKernels.h \
+    src/SequenceBatch.h \
+    src/PointAccumulator.h \
+    src/ParallelPoints.h \
+    src/TDigest.h \
+    src/QuantileSketchAnalysis.h \
+    src/PercentileAnalysis.h \
+    src/WindowAnalysis.h \
+    src/SequenceState.h \
+    src/StaticAnalysisSet.h \
+    src/AnalysisIntermediates.h \
+    src/StorageAggregate.h \
+    src/AnalysisCostModel.h \
+    src/SqliteAggregateFunctions.h \
+    src/AbstractAnalysisSink.h \
+    src/SqlAnalysisSink.h \
+    src/CSVAnalysisSink.h \
+    src/DatabaseAnalysisJob.h \
+    src/StorageLoader.h \
+    src/Metrics.h \
+    src/SequencePointList.h \
+    src/FirstQuartileAnalysis.h \
+    src/ThirdQuartileAnalysis.h
@@ -0,0 +1,33 @@
+#-------------------------------------------------
+#
+# Analysis engine as a static library without QtGui,
+# for programs that embed the analyses.
+#
+#-------------------------------------------------
+
+QT       = core sql
+
+TARGET = number-analysis-engine
+TEMPLATE = lib
+CONFIG += staticlib
+
+# native SQLite aggregate functions, needs the SQLite library used by the Qt driver:
+# Qt must be configured with -system-sqlite, a driver with its own copy of SQLite
+# doesn't share the library, install() then finds another version and skips them
+CONFIG(sqlite_functions){
+    DEFINES += SQLITE_FUNCTIONS
+    LIBS += -lsqlite3
+}
+
+include(engine.pri)
+
+CONFIG(debug, debug|release) {
+    DESTDIR = build/debug
+    OBJECTS_DIR = build/debug/.engine-obj
+    MOC_DIR = build/debug/.engine-moc
+}
+CONFIG(release, debug|release) {
+    DESTDIR = build/release
+    OBJECTS_DIR = build/release/.engine-obj
+    MOC_DIR = build/release/.engine-moc
+}
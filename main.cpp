@@ -1,6 +1,12 @@
-#include <QtGui/QApplication>
 #include <QTextCodec>
 
+#ifdef CLI
+#include <QCoreApplication>
+#include "CommandLine.h"
+#else
+#include <QtGui/QApplication>
+#endif
+
 #ifdef TEST
 #include "tests/TAnalysis.h"
 #include "tests/TAnalysisCollection.h"
@@ -13,15 +19,40 @@
 #include "tests/TCSVPointListValidator.h"
 #include "tests/TCSVPointListExporter.h"
 #include "tests/TPointList.h"
+#include "tests/TAnalysisResultMatrix.h"
+#include "tests/TAnalysisRowOrder.h"
+#include "tests/TPointKernels.h"
+#include "tests/TSequenceBatch.h"
+#include "tests/TParallelPoints.h"
+#include "tests/TTDigest.h"
+#include "tests/TWindowAnalysis.h"
+#include "tests/TSequenceState.h"
+#include "tests/TStaticAnalysisSet.h"
+#include "tests/TAnalysisIntermediates.h"
+#include "tests/TAnalysisCostModel.h"
+#include "tests/TSqliteAggregateFunctions.h"
+#include "tests/TDatabaseAnalysisJob.h"
+#include "tests/TAnalysisEvaluator.h"
+#include "tests/TStorageLoader.h"
+#include "tests/TBenchmarkComparison.h"
+#include "tests/TMetrics.h"
+#include "tests/TAnalysisWorker.h"
+#include "tests/TCommandLine.h"
 #endif
 
 #ifdef STRESS
+#include "benchmarks/BenchmarkRunner.h"
+#include "benchmarks/BenchmarkComparison.h"
 #include "benchmarks/BAnalysisCollections.h"
 #include "benchmarks/BSqlPointListInterface.h"
 #include "benchmarks/BSqlPointListReadWrite.h"
 #include "benchmarks/BStatisticsCollection.h"
 #include "benchmarks/BCSVImporterExporter.h"
 #include "benchmarks/BAnalyzing.h"
+#include "benchmarks/BPointKernels.h"
+#include "benchmarks/BSequenceBatch.h"
+#include "benchmarks/BStaticAnalysisSet.h"
+#include "benchmarks/BScaling.h"
 #endif
 
 
@@ -35,6 +66,11 @@ int main(int argc, char *argv[])
     QTextCodec::setCodecForLocale(QTextCodec::codecForName("UTF-8"));
     QTextCodec::setCodecForTr(QTextCodec::codecForName("UTF-8"));
 
+#ifdef CLI
+    // no widgets, no testing files directory and no event loop
+    QCoreApplication application(argc, argv);
+    return CommandLine(application.arguments()).run();
+#else
     QApplication a(argc, argv);
 
     const QString currentDir = QDir::currentPath();
@@ -99,50 +135,226 @@ int main(int argc, char *argv[])
 
     TPointList tPointList;
     QTest::qExec(&tPointList);
+
+    qWarning() << "\n";
+
+    TAnalysisResultMatrix tAnalysisResultMatrix;
+    QTest::qExec(&tAnalysisResultMatrix);
+
+    qWarning() << "\n";
+
+    TAnalysisRowOrder tAnalysisRowOrder;
+    QTest::qExec(&tAnalysisRowOrder);
+
+    qWarning() << "\n";
+
+    TPointKernels tPointKernels;
+    QTest::qExec(&tPointKernels);
+
+    qWarning() << "\n";
+
+    TSequenceBatch tSequenceBatch;
+    QTest::qExec(&tSequenceBatch);
+
+    qWarning() << "\n";
+
+    TParallelPoints tParallelPoints;
+    QTest::qExec(&tParallelPoints);
+
+    qWarning() << "\n";
+
+    TTDigest tTDigest;
+    QTest::qExec(&tTDigest);
+
+    qWarning() << "\n";
+
+    TWindowAnalysis tWindowAnalysis;
+    QTest::qExec(&tWindowAnalysis);
+
+    qWarning() << "\n";
+
+    TSequenceState tSequenceState;
+    QTest::qExec(&tSequenceState);
+
+    qWarning() << "\n";
+
+    TStaticAnalysisSet tStaticAnalysisSet;
+    QTest::qExec(&tStaticAnalysisSet);
+
+    qWarning() << "\n";
+
+    TAnalysisIntermediates tAnalysisIntermediates;
+    QTest::qExec(&tAnalysisIntermediates);
+
+    qWarning() << "\n";
+
+    TAnalysisCostModel tAnalysisCostModel;
+    QTest::qExec(&tAnalysisCostModel);
+
+    qWarning() << "\n";
+
+    TSqliteAggregateFunctions tSqliteAggregateFunctions;
+    QTest::qExec(&tSqliteAggregateFunctions);
+
+    qWarning() << "\n";
+
+    TDatabaseAnalysisJob tDatabaseAnalysisJob;
+    QTest::qExec(&tDatabaseAnalysisJob);
+
+    qWarning() << "\n";
+
+    TAnalysisEvaluator tAnalysisEvaluator;
+    QTest::qExec(&tAnalysisEvaluator);
+
+    qWarning() << "\n";
+
+    TStorageLoader tStorageLoader;
+    QTest::qExec(&tStorageLoader);
+
+    qWarning() << "\n";
+
+    TBenchmarkComparison tBenchmarkComparison;
+    QTest::qExec(&tBenchmarkComparison);
+
+    qWarning() << "\n";
+
+    TMetrics tMetrics;
+    QTest::qExec(&tMetrics);
+
+    qWarning() << "\n";
+
+    TAnalysisWorker tAnalysisWorker;
+    QTest::qExec(&tAnalysisWorker);
+
+    qWarning() << "\n";
+
+    TCommandLine tCommandLine;
+    QTest::qExec(&tCommandLine);
 #endif
 
 #ifdef STRESS
-//    qWarning() << "\n" << "Analysis collection benchmark" << "\n";
+    BenchmarkRunner benchmarkRunner;
+
+    // the storage and collection benchmarks are scaled down to run in seconds,
+    // so that every suite of the run is gated by --baseline
+    qWarning() << "\n" << "Analysis collection benchmark" << "\n";
 
-//    BAnalysisCollections bAnalysisCollections(10000);
-//    bAnalysisCollections.run();
+    BAnalysisCollections bAnalysisCollections(1000);
+    bAnalysisCollections.run(benchmarkRunner);
 
-//    qWarning() << "\n" << "SqlInterface benchmark"  << "\n";;
+    qWarning() << "\n" << "SqlInterface benchmark"  << "\n";
 
-//    BSqlPointListInterface bSqlPointListInterface(10000);
-//    bSqlPointListInterface.run();
+    BSqlPointListInterface bSqlPointListInterface(1000);
+    bSqlPointListInterface.run(benchmarkRunner);
 
-//    qWarning() << "\n" << "SqlPointListReadWrite benchmark"  << "\n";
+    qWarning() << "\n" << "SqlPointListReadWrite benchmark"  << "\n";
 
-//    BSqlPointListReadWrite bSqlPointListReadWrite(10000);
-//    bSqlPointListReadWrite.runWriteAll();
-//    bSqlPointListReadWrite.runReadAll();
+    BSqlPointListReadWrite bSqlPointListReadWrite(2000);
+    bSqlPointListReadWrite.runWriteAll(benchmarkRunner);
+    bSqlPointListReadWrite.runReadAll(benchmarkRunner);
 
-//    bSqlPointListReadWrite.runWrite();
-//    bSqlPointListReadWrite.runRead();
+    bSqlPointListReadWrite.runWrite(benchmarkRunner);
+    bSqlPointListReadWrite.runRead(benchmarkRunner);
 
-//    qWarning() << "\n" << "StaticCollection benchmark"  << "\n";
+    qWarning() << "\n" << "StaticCollection benchmark"  << "\n";
 
-//    BStatisticsCollection  bStatisticsCollection;
-//    bStatisticsCollection.generateDatabase(10000, 100);
-//    bStatisticsCollection.statistics();
+    BStatisticsCollection  bStatisticsCollection;
+    bStatisticsCollection.generateDatabase(benchmarkRunner, 2000, 100);
+    bStatisticsCollection.statistics(benchmarkRunner);
 
-//    qWarning() << "\n" << "CSV import, export and validation benchmarck"  << "\n";
+    qWarning() << "\n" << "CSV import, export and validation benchmarck"  << "\n";
 
-//    BCSVImporterExporter  bCSVImporterExporter(20000, 200);
-//    bCSVImporterExporter.run();
+    BCSVImporterExporter  bCSVImporterExporter(5000, 100);
+    bCSVImporterExporter.run(benchmarkRunner);
 
     qWarning() << "\n" << "Analyzing benchmark"  << "\n";
 
+    // one repetition writes and analyzes 10M points; five samples are the
+    // fewest the baseline comparison can find significant at 5%
+    benchmarkRunner.setRepetitions(5);
+
     BAnalyzing  bAnalyzing(100000);
-    bAnalyzing.run();
+    bAnalyzing.run(benchmarkRunner);
+
+    benchmarkRunner.setRepetitions(10);
+
+    qWarning() << "\n" << "Point kernels benchmark"  << "\n";
+
+    BPointKernels bPointKernels(100, 100000);
+    bPointKernels.run(benchmarkRunner);
+
+    BPointKernels bPointKernelsLarge(1000000, 100);
+    bPointKernelsLarge.run(benchmarkRunner);
+
+    qWarning() << "\n" << "Short sequences benchmark"  << "\n";
+
+    BSequenceBatch bSequenceBatch(1000000, 20);
+    bSequenceBatch.run(benchmarkRunner);
+
+    qWarning() << "\n" << "Static analysis set benchmark"  << "\n";
+
+    BStaticAnalysisSet bStaticAnalysisSet(1000000, 20);
+    bStaticAnalysisSet.run(benchmarkRunner);
+
+    qWarning() << "\n" << "Scaling benchmark"  << "\n";
+
+    // the largest configuration writes and analyzes 10M points per repetition
+    benchmarkRunner.setRepetitions(5);
+
+    BScaling bScaling(QList<int>() << 1000 << 10000 << 100000, 100);
+    bScaling.run(benchmarkRunner);
+
+    qWarning() << "\n";
+
+    benchmarkRunner.report();
+    benchmarkRunner.writeJson("benchmarks.json");
+
+    // --save-baseline FILE keeps this run for later comparisons, --baseline FILE
+    // compares with a kept run and exits with 1 on a regression of more than
+    // --threshold PERCENT (5 by default)
+    const QStringList arguments = a.arguments();
+
+    const int saveBaselineIndex = arguments.indexOf("--save-baseline");
+    if((saveBaselineIndex >= 0) && (saveBaselineIndex + 1 < arguments.count()))
+    {
+        benchmarkRunner.writeJson(QDir(currentDir).absoluteFilePath(arguments.at(saveBaselineIndex + 1)));
+    }
+
+    const int baselineIndex = arguments.indexOf("--baseline");
+    if((baselineIndex >= 0) && (baselineIndex + 1 < arguments.count()))
+    {
+        BenchmarkResultList baseline;
+        if(!BenchmarkRunner::readJson(QDir(currentDir).absoluteFilePath(arguments.at(baselineIndex + 1)), &baseline))
+        {
+            QDir::setCurrent(currentDir);
+            return 2;
+        }
+
+        BenchmarkComparison comparison;
+
+        const int thresholdIndex = arguments.indexOf("--threshold");
+        if((thresholdIndex >= 0) && (thresholdIndex + 1 < arguments.count()))
+        {
+            comparison.setThreshold(arguments.at(thresholdIndex + 1).toDouble() / 100.0);
+        }
+
+        qWarning() << "\n" << "Comparison with the baseline" << "\n";
+
+        const bool isPassed = comparison.compare(baseline, benchmarkRunner.results());
+        comparison.report();
+
+        QDir::setCurrent(currentDir);
+        return isPassed ? 0 : 1;
+    }
 
 #endif
     QDir::setCurrent(currentDir);
 
 
 #ifdef APP
-    AnalysisWindow analysisWindow;
+    // a database of a previous run is opened as is, only the first run generates one
+    AnalysisWindow analysisWindow(QFile::exists("database.db") ? AnalysisWindow::OpenDatabase
+                                                               : AnalysisWindow::GenerateDatabase);
     analysisWindow.show();  
 #endif
 
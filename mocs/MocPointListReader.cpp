@@ -18,6 +18,26 @@ IDList MocPointListReader::readAllItems()
     return table_.keys();
 }
 
+IDList MocPointListReader::readItems(const ID &after, const int limit)
+{
+    IDList allItems = table_.keys();
+    qSort(allItems);
+
+    IDList::const_iterator item = allItems.constBegin();
+    if(!after.isNull())
+    {
+        item = qUpperBound(allItems.constBegin(), allItems.constEnd(), after);
+    }
+
+    IDList items;
+    for(; (item != allItems.constEnd()) && (items.count() < limit); ++item)
+    {
+        items << *item;
+    }
+
+    return items;
+}
+
 PointListStorageStatistics MocPointListReader::statistics()
 {
     PointListStorageStatistics storageStatistics;
@@ -32,3 +52,8 @@ PointListStorageStatistics MocPointListReader::statistics()
 
     return storageStatistics;
 }
+
+MocPointListReader *MocPointListReader::clone() const
+{
+    return new MocPointListReader(*this);
+}
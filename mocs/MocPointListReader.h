@@ -11,9 +11,12 @@ public:
 
     PointList read(const ID &item);
     IDList readAllItems();
+    IDList readItems(const ID &after, const int limit);
 
     PointListStorageStatistics statistics();
 
+    MocPointListReader* clone() const;
+
 private:
     QHash<ID, PointList> table_;
 };
@@ -20,6 +20,28 @@ CONFIG(app){
     HEADERS += AnalysisWindow.h
 }
 
+# headless command line runner on QCoreApplication
+CONFIG(cli){
+    message("bulding command line")
+    TARGET = number-analysis-cli
+    TEMPLATE = app
+    DEFINES += CLI
+    QT -= gui
+
+    SOURCES += CommandLine.cpp
+
+    HEADERS += CommandLine.h
+}
+
+# native SQLite aggregate functions, needs the SQLite library used by the Qt driver:
+# Qt must be configured with -system-sqlite, a driver with its own copy of SQLite
+# doesn't share the library, install() then finds another version and skips them
+CONFIG(sqlite_functions){
+    message("bulding with sqlite aggregate functions")
+    DEFINES += SQLITE_FUNCTIONS
+    LIBS += -lsqlite3
+}
+
 CONFIG(test){
     message("bulding tests")
     DEFINES += TEST
@@ -33,7 +55,26 @@ CONFIG(test){
         tests/TPointListStorageStatistics.cpp \
         tests/TCSVPointListImporter.cpp \
         tests/TCSVPointListValidator.cpp \
-        tests/TCSVPointListExporter.cpp
+        tests/TCSVPointListExporter.cpp \
+        tests/TAnalysisResultMatrix.cpp \
+        tests/TAnalysisRowOrder.cpp \
+        tests/TPointKernels.cpp \
+        tests/TSequenceBatch.cpp \
+        tests/TParallelPoints.cpp \
+        tests/TTDigest.cpp \
+        tests/TWindowAnalysis.cpp \
+        tests/TSequenceState.cpp \
+        tests/TStaticAnalysisSet.cpp \
+        tests/TAnalysisIntermediates.cpp \
+        tests/TAnalysisCostModel.cpp \
+        tests/TSqliteAggregateFunctions.cpp \
+        tests/TDatabaseAnalysisJob.cpp \
+        tests/TAnalysisEvaluator.cpp \
+        tests/TStorageLoader.cpp \
+        tests/TBenchmarkComparison.cpp \
+        tests/TMetrics.cpp \
+        tests/TAnalysisWorker.cpp \
+        tests/TCommandLine.cpp
 
 
     HEADERS += tests/TAnalysis.h \
@@ -46,7 +87,48 @@ CONFIG(test){
         tests/TCSVPointListImporter.h \
         tests/TCSVPointListValidator.h \
         tests/TCSVPointListExporter.h \
-        tests/TPointListStorageStatistics.h
+        tests/TPointListStorageStatistics.h \
+        tests/TAnalysisResultMatrix.h \
+        tests/TAnalysisRowOrder.h \
+        tests/TPointKernels.h \
+        tests/TSequenceBatch.h \
+        tests/TParallelPoints.h \
+        tests/TTDigest.h \
+        tests/TWindowAnalysis.h \
+        tests/TSequenceState.h \
+        tests/TStaticAnalysisSet.h \
+        tests/TAnalysisIntermediates.h \
+        tests/TAnalysisCostModel.h \
+        tests/TSqliteAggregateFunctions.h \
+        tests/TDatabaseAnalysisJob.h \
+        tests/TAnalysisEvaluator.h \
+        tests/TStorageLoader.h \
+        tests/TBenchmarkComparison.h \
+        tests/TMetrics.h \
+        tests/TAnalysisWorker.h \
+        tests/TCommandLine.h
+
+    # in-memory reader of the model tests
+    SOURCES += mocs/MocPointListReader.cpp
+    HEADERS += mocs/MocPointListReader.h
+
+    # the options of the command line build are tested in the test build
+    !CONFIG(cli){
+        SOURCES += CommandLine.cpp
+        HEADERS += CommandLine.h
+    }
+}
+
+# benchmark runner and baseline comparison, shared by the benchmarks and their tests
+CONFIG(test)|CONFIG(stress){
+    SOURCES += benchmarks/BenchmarkRunner.cpp \
+        benchmarks/BenchmarkComparison.cpp
+
+    HEADERS += benchmarks/BenchmarkRunner.h \
+        benchmarks/BenchmarkComparison.h
+
+    # peak working set of the benchmarks
+    win32:LIBS += -lpsapi
 }
 
 CONFIG(stress){
@@ -58,76 +140,45 @@ CONFIG(stress){
         benchmarks/BSqlPointListReadWrite.cpp \
         benchmarks/BStatisticsCollection.cpp \
         benchmarks/BCSVImporterExporter.cpp \
-        benchmarks/BAnalyzing.cpp
+        benchmarks/BAnalyzing.cpp \
+        benchmarks/BPointKernels.cpp \
+        benchmarks/BSequenceBatch.cpp \
+        benchmarks/BStaticAnalysisSet.cpp \
+        benchmarks/BScaling.cpp
 
     HEADERS += benchmarks/BAnalysisCollections.h \
         benchmarks/BSqlPointListInterface.h \
         benchmarks/BSqlPointListReadWrite.h \
         benchmarks/BStatisticsCollection.h \
         benchmarks/BCSVImporterExporter.h \
-        benchmarks/BAnalyzing.h
+        benchmarks/BAnalyzing.h \
+        benchmarks/BPointKernels.h \
+        benchmarks/BSequenceBatch.h \
+        benchmarks/BStaticAnalysisSet.h \
+        benchmarks/BScaling.h
 }
 
-SOURCES += main.cpp\
-    src/StupidAnalysis.cpp \
-    src/AverageAnalysis.cpp \
-    src/AverageIgnoreNullAnalysis.cpp \
-    src/AbstractAnalysis.cpp \
-    src/AnalysisCollection.cpp \
-    src/AnalysisTableModel.cpp \
-    src/ItemListModel.cpp \
-    src/StandardDeviationAnalysis.cpp \
-    src/ItemListView.cpp \
-    mocs/MocPointListReader.cpp \
-    src/AbstractPointListReader.cpp \
-    src/SqlPointListReader.cpp \
-    src/SqlPointListWriter.cpp \
-    src/SqlPointListInterface.cpp \
-    src/DatabaseGenerator.cpp \
-    src/PointListGenerator.cpp \
-    src/PointListStorageStatistics.cpp \
-    src/PointListStorageStatisticsDialog.cpp \
-    src/CSVPointListImporter.cpp \
-    src/CSVPointListValidator.cpp \
-    src/CSVPointListExporter.cpp \
-    src/MedianAnalysis.cpp \
-    src/PointList.cpp \
-    src/SequencePointList.cpp \
-    src/FirstQuartileAnalysis.cpp \
-    src/ThirdQuartileAnalysis.cpp \
+SOURCES += main.cpp \
     tests/TPointList.cpp
 
-HEADERS  += src/StupidAnalysis.h \
-    src/AbstractAnalysis.h \    
-    src/AnalysisCollection.h \    
-    src/AverageIgnoreNullAnalysis.h \
-    src/AverageAnalysis.h \    
-    src/AnalysisTableModel.h \
-    src/ItemListModel.h \
-    src/StandardDeviationAnalysis.h \
-    src/ItemListView.h \
-    mocs/MocPointListReader.h \
-    src/AbstractPointListReader.h \
-    src/SqlPointListReader.h \    
-    src/SqlPointListWriter.h \
-    src/SqlPointListInterface.h \    
-    src/DatabaseGenerator.h \    
-    src/PointListGenerator.h \
-    src/PointListStorageStatistics.h \
-    src/Metatypes.h \
-    src/PointListStorageStatisticsDialog.h \
-    src/StatisticsCollection.h \    
-    src/CSVPointListImporter.h \    
-    src/CSVPointListValidator.h \    
-    src/CSVPointListExporter.h \
-    src/MedianAnalysis.h \
-    src/PointList.h \
-    src/SequencePointList.h \    
-    src/FirstQuartileAnalysis.h \
-    src/ThirdQuartileAnalysis.h \
-    tests/TPointList.h
+HEADERS += tests/TPointList.h
+
+include(engine.pri)
 
+# models and widgets over the engine, not needed by the command line runner
+!CONFIG(cli){
+    SOURCES += src/AnalysisTableModel.cpp \
+        src/ItemListModel.cpp \
+        src/ItemListView.cpp \
+        src/PointListStorageStatisticsDialog.cpp \
+        src/MetricsDialog.cpp
 
+    HEADERS += src/AnalysisTableModel.h \
+        src/ItemListModel.h \
+        src/ItemListView.h \
+        src/PointListStorageStatisticsDialog.h \
+        src/MetricsDialog.h
+}
 
 CONFIG(debug, debug|release) {
     message(building debug)
@@ -8,12 +8,57 @@ AbstractAnalysis::AbstractAnalysis(const IDAnalysis &id) :
 
 double AbstractAnalysis::listSum(const PointList &list)
 {
-    double sum = 0.0;
-    foreach(const Point e, list.points())
+    return PointKernels::sum(list.toVector());
+}
+
+int AbstractAnalysis::outputCount() const
+{
+    return 1;
+}
+
+IDAnalysisList AbstractAnalysis::outputIDs() const
+{
+    return IDAnalysisList() << id_;
+}
+
+void AbstractAnalysis::analyzeOutputs(const PointList &list, double *outputs) const
+{
+    outputs[0] = analyze(list);
+}
+
+int AbstractAnalysis::intermediates() const
+{
+    return AnalysisIntermediates::Points;
+}
+
+void AbstractAnalysis::analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const
+{
+    analyzeOutputs(intermediates.pointList(), outputs);
+}
+
+SequenceBatch::Statistic AbstractAnalysis::batchStatistic() const
+{
+    return SequenceBatch::NoStatistic;
+}
+
+bool AbstractAnalysis::isIncremental() const
+{
+    return false;
+}
+
+void AbstractAnalysis::analyzeState(const SequenceState &state, double *outputs) const
+{
+    qWarning() << QString("Analysis %1 is not incremental").arg(id_);
+
+    for(int i = 0; i < outputCount(); i++)
     {
-        sum += e;
+        outputs[i] = 0.0;
     }
-    return sum;
+}
+
+StorageAggregateList AbstractAnalysis::storageAggregates() const
+{
+    return StorageAggregateList();
 }
 
 bool AbstractAnalysis::isValid() const
@@ -3,6 +3,12 @@
 #define ABSTRACTANALYSIS_H
 
 #include "SequencePointList.h"
+#include "PointKernels.h"
+#include "ParallelPoints.h"
+#include "SequenceBatch.h"
+#include "SequenceState.h"
+#include "AnalysisIntermediates.h"
+#include "StorageAggregate.h"
 
 typedef QString IDAnalysis;
 typedef QList<IDAnalysis> IDAnalysisList;
@@ -19,8 +25,30 @@ public:
     virtual double analyze(const PointList &list) const = 0;
     virtual AbstractAnalysis* clone() = 0;
 
+    // analyses with several results write outputCount() values, one per output id
+    virtual int outputCount() const;
+    virtual IDAnalysisList outputIDs() const;
+    virtual void analyzeOutputs(const PointList &list, double *outputs) const;
+
+    // intermediates read by analyzeIntermediates(), shared with the other
+    // analyses of a collection; by default the analysis gets the point list
+    virtual int intermediates() const;
+    virtual void analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const;
+
     virtual bool isValid() const;
 
+    // statistic of SequenceBatch that gives the same result for short sequences
+    virtual SequenceBatch::Statistic batchStatistic() const;
+
+    // incremental analyses take their outputs from the state of a whole
+    // sequence instead of its points
+    virtual bool isIncremental() const;
+    virtual void analyzeState(const SequenceState &state, double *outputs) const;
+
+    // aggregates of the point storage that give the same results, one per
+    // output; empty when the storage can't compute the analysis
+    virtual StorageAggregateList storageAggregates() const;
+
     IDAnalysis id() const;
 
 protected:
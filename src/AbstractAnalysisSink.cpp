@@ -0,0 +1,9 @@
+#include "AbstractAnalysisSink.h"
+
+AbstractAnalysisSink::AbstractAnalysisSink()
+{
+}
+
+AbstractAnalysisSink::~AbstractAnalysisSink()
+{
+}
@@ -0,0 +1,23 @@
+#ifndef ABSTRACTANALYSISSINK_H
+
+#define ABSTRACTANALYSISSINK_H
+
+#include "AnalysisCollection.h"
+
+// Destination of the results of a whole database analysis. Rows arrive in
+// batches in no particular order, one row of outputIDs.count() values per
+// item. All calls are made on the thread that runs the analysis, so a sink
+// may keep a database connection of that thread.
+class AbstractAnalysisSink
+{
+public:
+    AbstractAnalysisSink();
+
+    virtual ~AbstractAnalysisSink();
+
+    virtual bool begin(const IDAnalysisList &outputIDs) = 0;
+    virtual bool write(const IDList &items, const QVector<double> &values) = 0;
+    virtual bool finish() = 0;
+};
+
+#endif // ABSTRACTANALYSISSINK_H
@@ -10,3 +10,28 @@ AbstractPointListReader::AbstractPointListReader()
 AbstractPointListReader::~AbstractPointListReader()
 {
 }
+
+QVector<Point> AbstractPointListReader::readValues(const ID &item)
+{
+    return read(item).toVector();
+}
+
+bool AbstractPointListReader::readState(const ID &item, SequenceState *state)
+{
+    return false;
+}
+
+bool AbstractPointListReader::canAggregate(const StorageAggregateList &aggregates) const
+{
+    return false;
+}
+
+bool AbstractPointListReader::readAggregates(const IDList &items, const StorageAggregateList &aggregates, QVector<double> *values)
+{
+    return false;
+}
+
+int AbstractPointListReader::readPointsCount(const ID &item)
+{
+    return readValues(item).count();
+}
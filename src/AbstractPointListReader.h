@@ -13,9 +13,24 @@ public:
     virtual ~AbstractPointListReader();
 
     virtual PointList read(const ID &item) = 0;
+    virtual QVector<Point> readValues(const ID &item);
+
+    // stored state of the sequence, false when there is none
+    virtual bool readState(const ID &item, SequenceState *state);
+
+    // aggregates of the items computed by the storage, values gets one row
+    // of aggregates.count() values per item in the order of items; false
+    // when the storage can't compute them
+    virtual bool canAggregate(const StorageAggregateList &aggregates) const;
+    virtual bool readAggregates(const IDList &items, const StorageAggregateList &aggregates, QVector<double> *values);
+    virtual int readPointsCount(const ID &item);
+
     virtual IDList readAllItems() = 0;
+    virtual IDList readItems(const ID &after, const int limit) = 0;
 
     virtual PointListStorageStatistics statistics() = 0;
+
+    virtual AbstractPointListReader* clone() const = 0;
 };
 
 #endif // ABSTRACTPOINTLISTREADER_H
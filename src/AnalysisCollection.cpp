@@ -1,4 +1,6 @@
 #include "AnalysisCollection.h"
+#include "AbstractPointListReader.h"
+#include "Metrics.h"
 
 AnalysisCollection::AnalysisCollection()
 {   
@@ -8,7 +10,7 @@ AnalysisCollection::AnalysisCollection(AnalysisList analyzes)
 {
     foreach(AbstractAnalysis* item, analyzes)
     {
-        addAnalysis(item->clone());
+        addAnalysis(item);
     }
 }
 
@@ -16,7 +18,7 @@ AnalysisCollection::AnalysisCollection(const AnalysisCollection &collection)
 {
     foreach(AbstractAnalysis* item, collection.analysisTable_)
     {
-        addAnalysis(item->clone());
+        addAnalysis(item);
     }
 }
 
@@ -30,14 +32,206 @@ AnalysisResult AnalysisCollection::analyze(const PointList &list) const
 {
     AnalysisResult analysisResult;
 
-    foreach(AbstractAnalysis* item, analysisTable_)
+    const QVector<double> values = analyzeValues(list);
+    const IDAnalysisList outputIDs = getOutputIDList();
+
+    for(int i = 0; i < outputIDs.count(); i++)
     {
-        analysisResult.insert(item->id(), item->analyze(list));
+        analysisResult.insert(outputIDs.at(i), values.at(i));
     }
 
     return analysisResult;
 }
 
+QVector<double> AnalysisCollection::analyzeValues(const PointList &list) const
+{
+    METRICS_TIMER("analysis/analyze");
+    METRICS_COUNT("analysis/points", list.count());
+
+    QVector<double> values(outputCount());
+
+    // long sequences are split into chunks by the analyses themselves
+    if(ParallelPoints::isParallel(list.count()))
+    {
+        int column = 0;
+        for(int i = 0; i < analysisTable_.size(); i++)
+        {
+            analysisTable_.at(i)->analyzeOutputs(list, values.data() + column);
+            column += analysisTable_.at(i)->outputCount();
+        }
+
+        return values;
+    }
+
+    AnalysisIntermediates intermediates;
+    intermediates.reset(list.id(), list.toVector());
+    intermediates.prepare(plan_);
+
+    int column = 0;
+    for(int i = 0; i < analysisTable_.size(); i++)
+    {
+        analysisTable_.at(i)->analyzeIntermediates(intermediates, values.data() + column);
+        column += analysisTable_.at(i)->outputCount();
+    }
+
+    return values;
+}
+
+QVector<double> AnalysisCollection::analyzeBatch(const SequenceBatch &batch) const
+{
+    METRICS_TIMER("analysis/analyze batch");
+    METRICS_COUNT("analysis/batch sequences", batch.count());
+
+    const int width = outputCount();
+    QVector<double> values(batch.count() * width);
+
+    SequenceBatchResults results;
+    bool isAnalyzed = false;
+
+    QList<int> otherAnalyses;
+    QList<int> otherColumns;
+    int otherIntermediates = AnalysisIntermediates::NoIntermediates;
+
+    int column = 0;
+    for(int i = 0; i < analysisTable_.size(); column += analysisTable_.at(i)->outputCount(), i++)
+    {
+        const AbstractAnalysis *analysis = analysisTable_.at(i);
+        const SequenceBatch::Statistic statistic = analysis->batchStatistic();
+
+        if((statistic != SequenceBatch::NoStatistic) && !isAnalyzed)
+        {
+            results = batch.analyze();
+            isAnalyzed = true;
+        }
+
+        const QVector<double> *statisticValues = 0;
+        switch(statistic)
+        {
+        case SequenceBatch::Average: statisticValues = &results.averages; break;
+        case SequenceBatch::AverageIgnoreNull: statisticValues = &results.averagesIgnoreNull; break;
+        case SequenceBatch::StandardDeviation: statisticValues = &results.deviations; break;
+        case SequenceBatch::Minimum: statisticValues = &results.minimums; break;
+        case SequenceBatch::Maximum: statisticValues = &results.maximums; break;
+        case SequenceBatch::NoStatistic: break;
+        }
+
+        if(statisticValues != 0)
+        {
+            for(int sequence = 0; sequence < batch.count(); sequence++)
+            {
+                values[sequence * width + column] = statisticValues->at(sequence);
+            }
+            continue;
+        }
+
+        otherAnalyses.append(i);
+        otherColumns.append(column);
+        otherIntermediates |= analysis->intermediates();
+    }
+
+    if(otherAnalyses.isEmpty())
+    {
+        return values;
+    }
+
+    // the other analyses share the intermediates of every sequence,
+    // one scratch object serves the whole batch
+    const AnalysisIntermediates::Plan plan = AnalysisIntermediates::plan(otherIntermediates);
+    AnalysisIntermediates intermediates;
+
+    for(int sequence = 0; sequence < batch.count(); sequence++)
+    {
+        intermediates.reset(batch.id(sequence), batch.values(sequence));
+        intermediates.prepare(plan);
+
+        for(int i = 0; i < otherAnalyses.count(); i++)
+        {
+            analysisTable_.at(otherAnalyses.at(i))->analyzeIntermediates(intermediates,
+                                                                         values.data() + sequence * width + otherColumns.at(i));
+        }
+    }
+
+    return values;
+}
+
+bool AnalysisCollection::isIncremental() const
+{
+    if(analysisTable_.isEmpty())
+    {
+        return false;
+    }
+
+    foreach(AbstractAnalysis* item, analysisTable_)
+    {
+        if(!item->isIncremental())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QVector<double> AnalysisCollection::analyzeState(const SequenceState &state) const
+{
+    QVector<double> values(outputCount());
+
+    int column = 0;
+    for(int i = 0; i < analysisTable_.size(); i++)
+    {
+        analysisTable_.at(i)->analyzeState(state, values.data() + column);
+        column += analysisTable_.at(i)->outputCount();
+    }
+
+    return values;
+}
+
+bool AnalysisCollection::isAggregate() const
+{
+    if(analysisTable_.isEmpty())
+    {
+        return false;
+    }
+
+    foreach(AbstractAnalysis* item, analysisTable_)
+    {
+        if(item->storageAggregates().count() != item->outputCount())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+StorageAggregateList AnalysisCollection::storageAggregates() const
+{
+    StorageAggregateList aggregates;
+
+    foreach(AbstractAnalysis* item, analysisTable_)
+    {
+        aggregates << item->storageAggregates();
+    }
+
+    return aggregates;
+}
+
+bool AnalysisCollection::analyzeStorage(AbstractPointListReader *reader, const IDList &items, QVector<double> *values) const
+{
+    if(!isAggregate())
+    {
+        return false;
+    }
+
+    const StorageAggregateList aggregates = storageAggregates();
+    if(!reader->canAggregate(aggregates))
+    {
+        return false;
+    }
+
+    return reader->readAggregates(items, aggregates, values);
+}
+
 void AnalysisCollection::addAnalysis(AbstractAnalysis *analysis)
 {
     if(!analysis->isValid())
@@ -54,7 +248,17 @@ void AnalysisCollection::addAnalysis(AbstractAnalysis *analysis)
         return ;
     }
 
+    foreach(const IDAnalysis& idOutput, analysis->outputIDs())
+    {
+        if(containsOutput(idOutput))
+        {
+            qWarning() << QString("Analysis output %1 already exists").arg(idOutput);
+            return ;
+        }
+    }
+
     analysisTable_.append(analysis->clone());
+    updatePlan();
 }
 
 int AnalysisCollection::indexOfAnalysis(const IDAnalysis &idAnalysis)
@@ -77,6 +281,7 @@ void AnalysisCollection::removeAnalysis(const int index)
     {
         delete analysisTable_[index];
         analysisTable_.removeAt(index);
+        updatePlan();
     }
     else
     {
@@ -109,12 +314,61 @@ const IDAnalysis AnalysisCollection::getIDAt(const int index) const
     return analysisTable_.at(index)->id();
 }
 
+const IDAnalysisList AnalysisCollection::getOutputIDList() const
+{
+    IDAnalysisList list;
+
+    foreach (AbstractAnalysis* analysis, analysisTable_)
+    {
+        list << analysis->outputIDs();
+    }
+
+    return list;
+}
+
+bool AnalysisCollection::containsOutput(const IDAnalysis &idOutput) const
+{
+    foreach (AbstractAnalysis* analysis, analysisTable_)
+    {
+        if(analysis->outputIDs().contains(idOutput))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 int AnalysisCollection::size() const
 {
     return analysisTable_.size();
 }
 
-AnalysisCollection *AnalysisCollection::clone()
+int AnalysisCollection::outputCount() const
+{
+    int count = 0;
+
+    foreach (AbstractAnalysis* analysis, analysisTable_)
+    {
+        count += analysis->outputCount();
+    }
+
+    return count;
+}
+
+AnalysisCollection *AnalysisCollection::clone() const
 {
     return new AnalysisCollection(*this);
 }
+
+void AnalysisCollection::updatePlan()
+{
+    int intermediates = AnalysisIntermediates::NoIntermediates;
+
+    foreach (AbstractAnalysis* analysis, analysisTable_)
+    {
+        intermediates |= analysis->intermediates();
+    }
+
+    plan_ = AnalysisIntermediates::plan(intermediates);
+}
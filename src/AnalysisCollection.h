@@ -34,10 +34,8 @@ public:
 
     static bool fuzzyCompare(const AnalysisResult& actual, const AnalysisResult& expected)
     {
-        const QList<IDAnalysis> keysActual = actual.keys();
-        const QList<IDAnalysis> keysExpected = expected.keys();
-
-        if(keysActual != keysExpected)
+        // the order of keys() depends on the insertion order inside a bucket
+        if(actual.keys().toSet() != expected.keys().toSet())
         {
             return false;
         }
@@ -95,10 +93,8 @@ public:
 
     static bool fuzzyCompare(const AnalysisResults& actual, const AnalysisResults& expected)
     {
-        const QList<ID> keysActual = actual.keys();
-        const QList<ID> keysExpected = expected.keys();
-
-         if(keysActual != keysExpected)
+        // the order of keys() depends on the insertion order inside a bucket
+        if(actual.keys().toSet() != expected.keys().toSet())
         {
             return false;
         }
@@ -125,6 +121,8 @@ public:
 
 typedef QList<AbstractAnalysis*> AnalysisList;
 
+class AbstractPointListReader;
+
 
 class AnalysisCollection
 {
@@ -137,7 +135,21 @@ public:
     ~AnalysisCollection();
 
     AnalysisResult analyze(const PointList &list) const;
+    QVector<double> analyzeValues(const PointList &list) const;
+    QVector<double> analyzeBatch(const SequenceBatch &batch) const;
+
+    // true when every analysis is incremental, then analyzeState() gives all outputs
+    bool isIncremental() const;
+    QVector<double> analyzeState(const SequenceState &state) const;
 
+    // true when every output has a storage aggregate, then analyzeStorage()
+    // gives a row of outputs per item without reading points if the storage
+    // can compute all of them
+    bool isAggregate() const;
+    StorageAggregateList storageAggregates() const;
+    bool analyzeStorage(AbstractPointListReader *reader, const IDList &items, QVector<double> *values) const;
+
+    // stores a clone, the caller keeps the ownership of analysis
     void addAnalysis(AbstractAnalysis *analysis);
     int indexOfAnalysis(const IDAnalysis& idAnalysis);
     void removeAnalysis(const int index);
@@ -146,14 +158,24 @@ public:
     const IDAnalysisList getIDList() const;
     const IDAnalysis getIDAt(const int index) const;
 
+    // result columns, an analysis with several outputs gives several columns
+    const IDAnalysisList getOutputIDList() const;
+    bool containsOutput(const IDAnalysis& idOutput) const;
+
     int size() const;
+    int outputCount() const;
 
-    AnalysisCollection* clone();
+    AnalysisCollection* clone() const;
 
 private:
     AnalysisCollection(const AnalysisCollection& collection);
     AnalysisList analysisTable_;
 
+    // intermediates of all analyses in dependency order, rebuilt when analyses change
+    AnalysisIntermediates::Plan plan_;
+
+    void updatePlan();
+
 
 };
 
@@ -0,0 +1,105 @@
+#include "AnalysisCostModel.h"
+
+// one round trip to the storage
+const double AnalysisCostModel::queryCost_ = 40.0;
+// converting a point to a double in memory and analyzing it
+const double AnalysisCostModel::pointCost_ = 1.0;
+// decoding the stored state of a sequence
+const double AnalysisCostModel::stateCost_ = 20.0;
+// aggregating a point inside the storage, walking the covering index
+const double AnalysisCostModel::aggregateCost_ = 0.1;
+
+const int AnalysisCostModel::itemsPerQuery_ = 500;
+const int AnalysisCostModel::sampleSize_ = 16;
+
+AnalysisCostModel::Strategy AnalysisCostModel::choose(const AnalysisCollection &collection,
+                                                      AbstractPointListReader *reader,
+                                                      const IDList &items)
+{
+    const bool isAggregate = collection.isAggregate() && reader->canAggregate(collection.storageAggregates());
+    const bool isIncremental = collection.isIncremental();
+
+    if(!isAggregate && !isIncremental)
+    {
+        return InMemory;
+    }
+
+    // items requested later on demand are priced as a single item
+    return choose(isAggregate, isIncremental, qMax(1, items.count()), pointsPerItem(reader, items));
+}
+
+AnalysisCostModel::Strategy AnalysisCostModel::choose(const bool isAggregate,
+                                                      const bool isIncremental,
+                                                      const int itemsCount,
+                                                      const double pointsPerItem)
+{
+    Strategy strategy = InMemory;
+    double cost = inMemoryCost(itemsCount, pointsPerItem);
+
+    if(isIncremental && (incrementalCost(itemsCount) < cost))
+    {
+        strategy = Incremental;
+        cost = incrementalCost(itemsCount);
+    }
+
+    if(isAggregate && (pushdownCost(itemsCount, pointsPerItem) < cost))
+    {
+        strategy = Pushdown;
+    }
+
+    return strategy;
+}
+
+double AnalysisCostModel::pointsPerItem(AbstractPointListReader *reader, const IDList &items)
+{
+    const IDList sample = items.isEmpty() ? reader->readItems(ID(), sampleSize_) : items;
+
+    if(sample.isEmpty())
+    {
+        return 0.0;
+    }
+
+    const int sampleCount = qMin(sampleSize_, sample.count());
+
+    qint64 points = 0;
+    for(int i = 0; i < sampleCount; i++)
+    {
+        points += reader->readPointsCount(sample.at(i * sample.count() / sampleCount));
+    }
+
+    return points / static_cast<double>(sampleCount);
+}
+
+double AnalysisCostModel::inMemoryCost(const int itemsCount, const double pointsPerItem)
+{
+    return itemsCount * (queryCost_ + pointsPerItem * pointCost_);
+}
+
+double AnalysisCostModel::incrementalCost(const int itemsCount)
+{
+    return itemsCount * (queryCost_ + stateCost_);
+}
+
+double AnalysisCostModel::pushdownCost(const int itemsCount, const double pointsPerItem)
+{
+    const int queries = (itemsCount + itemsPerQuery_ - 1) / itemsPerQuery_;
+
+    return queries * queryCost_ + itemsCount * pointsPerItem * aggregateCost_;
+}
+
+int AnalysisCostModel::itemsPerQuery()
+{
+    return itemsPerQuery_;
+}
+
+QString AnalysisCostModel::strategyName(const Strategy strategy)
+{
+    switch(strategy)
+    {
+    case InMemory: return "in-memory";
+    case Incremental: return "incremental";
+    case Pushdown: return "pushdown";
+    }
+
+    return QString();
+}
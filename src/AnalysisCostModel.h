@@ -0,0 +1,45 @@
+#ifndef ANALYSISCOSTMODEL_H
+
+#define ANALYSISCOSTMODEL_H
+
+#include "AnalysisCollection.h"
+#include "AbstractPointListReader.h"
+
+// Chooses where the outputs of a collection are computed for a list of
+// items: from the points read into memory, from the stored states of the
+// sequences or by aggregate queries of the storage. Costs are estimates in
+// units of reading one point into memory, only their ratios matter.
+class AnalysisCostModel
+{
+public:
+    enum Strategy
+    {
+        InMemory,
+        Incremental,
+        Pushdown
+    };
+
+    static Strategy choose(const AnalysisCollection &collection, AbstractPointListReader *reader, const IDList &items);
+    static Strategy choose(const bool isAggregate, const bool isIncremental, const int itemsCount, const double pointsPerItem);
+
+    // average points count of a few items spread over the list, of the first
+    // items of the storage when the list is empty
+    static double pointsPerItem(AbstractPointListReader *reader, const IDList &items);
+
+    static double inMemoryCost(const int itemsCount, const double pointsPerItem);
+    static double incrementalCost(const int itemsCount);
+    static double pushdownCost(const int itemsCount, const double pointsPerItem);
+
+    static int itemsPerQuery();
+    static QString strategyName(const Strategy strategy);
+
+private:
+    static const double queryCost_;
+    static const double pointCost_;
+    static const double stateCost_;
+    static const double aggregateCost_;
+    static const int itemsPerQuery_;
+    static const int sampleSize_;
+};
+
+#endif // ANALYSISCOSTMODEL_H
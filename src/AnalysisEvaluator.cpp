@@ -0,0 +1,111 @@
+#include "AnalysisEvaluator.h"
+
+const int AnalysisEvaluator::sequencesPerBatch_ = 256;
+
+AnalysisEvaluator::AnalysisEvaluator(const AnalysisCollection &collection, AbstractPointListReader *reader) :
+    collection_(collection),
+    reader_(reader),
+    strategy_(AnalysisCostModel::InMemory)
+{
+}
+
+void AnalysisEvaluator::plan(const IDList &items)
+{
+    strategy_ = AnalysisCostModel::choose(collection_, reader_, items);
+}
+
+AnalysisCostModel::Strategy AnalysisEvaluator::strategy() const
+{
+    return strategy_;
+}
+
+int AnalysisEvaluator::itemsPerStep() const
+{
+    return (strategy_ == AnalysisCostModel::Pushdown) ? AnalysisCostModel::itemsPerQuery() : 1;
+}
+
+void AnalysisEvaluator::evaluate(const IDList &items, AnalysisBatch &batch)
+{
+    if(strategy_ == AnalysisCostModel::Pushdown)
+    {
+        for(int first = 0; first < items.count(); first += AnalysisCostModel::itemsPerQuery())
+        {
+            const IDList step = items.mid(first, AnalysisCostModel::itemsPerQuery());
+
+            QVector<double> values;
+            if(collection_.analyzeStorage(reader_, step, &values))
+            {
+                batch.append(step, values);
+                continue;
+            }
+
+            foreach(const ID &item, step)
+            {
+                evaluate(item, batch);
+            }
+        }
+        return;
+    }
+
+    foreach(const ID &item, items)
+    {
+        evaluate(item, batch);
+    }
+}
+
+void AnalysisEvaluator::evaluate(const ID &item, AnalysisBatch &batch)
+{
+    SequenceState state;
+    if((strategy_ == AnalysisCostModel::Incremental) && reader_->readState(item, &state))
+    {
+        batch.append(item, collection_.analyzeState(state));
+        return;
+    }
+
+    evaluateValues(item, reader_->readValues(item), batch);
+}
+
+void AnalysisEvaluator::evaluateValues(const ID &item, const QVector<Point> &points, AnalysisBatch &batch)
+{
+    if(!SequenceBatch::isShort(points.count()))
+    {
+        batch.append(item, collection_.analyzeValues(PointList::fromVector(item, points)));
+        return;
+    }
+
+    sequences_.append(item, points);
+    if(sequences_.count() >= sequencesPerBatch_)
+    {
+        flush(batch);
+    }
+}
+
+bool AnalysisEvaluator::hasPending() const
+{
+    return !sequences_.isEmpty();
+}
+
+void AnalysisEvaluator::flush(AnalysisBatch &batch)
+{
+    if(!sequences_.isEmpty())
+    {
+        batch.append(sequences_.ids(), collection_.analyzeBatch(sequences_));
+        sequences_.clear();
+    }
+}
+
+QVector<double> AnalysisEvaluator::evaluateRow(const ID &item)
+{
+    SequenceState state;
+    if(collection_.isIncremental() && reader_->readState(item, &state))
+    {
+        return collection_.analyzeState(state);
+    }
+
+    return collection_.analyzeValues(reader_->read(item));
+}
+
+int AnalysisEvaluator::sequencesPerBatch()
+{
+    return sequencesPerBatch_;
+}
@@ -0,0 +1,46 @@
+#ifndef ANALYSISEVALUATOR_H
+
+#define ANALYSISEVALUATOR_H
+
+#include "AbstractPointListReader.h"
+#include "AnalysisCollection.h"
+#include "AnalysisCostModel.h"
+#include "AnalysisResultMatrix.h"
+
+// Outputs of a collection for items of a reader, shared by the models, the
+// workers and the whole database job. The strategy of AnalysisCostModel is
+// chosen by plan(); short sequences are collected and analyzed together
+// when sequencesPerBatch() of them are pending or on flush().
+class AnalysisEvaluator
+{
+public:
+    AnalysisEvaluator(const AnalysisCollection &collection, AbstractPointListReader *reader);
+
+    void plan(const IDList &items);
+    AnalysisCostModel::Strategy strategy() const;
+
+    // items evaluate() takes at once with the chosen strategy
+    int itemsPerStep() const;
+
+    void evaluate(const IDList &items, AnalysisBatch &batch);
+    void evaluate(const ID &item, AnalysisBatch &batch);
+    void evaluateValues(const ID &item, const QVector<Point> &points, AnalysisBatch &batch);
+
+    bool hasPending() const;
+    void flush(AnalysisBatch &batch);
+
+    // outputs of one item, nothing is kept pending
+    QVector<double> evaluateRow(const ID &item);
+
+    static int sequencesPerBatch();
+
+private:
+    const AnalysisCollection &collection_;
+    AbstractPointListReader *reader_;
+    AnalysisCostModel::Strategy strategy_;
+    SequenceBatch sequences_;
+
+    static const int sequencesPerBatch_;
+};
+
+#endif // ANALYSISEVALUATOR_H
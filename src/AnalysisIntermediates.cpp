@@ -0,0 +1,157 @@
+#include "AnalysisIntermediates.h"
+
+#include <algorithm>
+
+AnalysisIntermediates::AnalysisIntermediates() :
+    prepared_(NoIntermediates),
+    sum_(0.0),
+    mean_(0.0),
+    sumOfSquares_(0.0),
+    nonZeroCount_(0),
+    minimum_(0.0),
+    maximum_(0.0)
+{
+}
+
+int AnalysisIntermediates::dependencies(const Intermediate intermediate)
+{
+    switch(intermediate)
+    {
+    case Mean: return Sum;
+    case SumOfSquares: return Mean;
+    default: return NoIntermediates;
+    }
+}
+
+AnalysisIntermediates::Plan AnalysisIntermediates::plan(const int intermediates)
+{
+    Plan order;
+    int planned = NoIntermediates;
+
+    // depth-first walk of the dependency graph, an intermediate is appended
+    // after everything it depends on
+    QVector<Intermediate> stack;
+    for(int bit = Sorted; bit > NoIntermediates; bit >>= 1)
+    {
+        if(intermediates & bit)
+        {
+            stack.append(Intermediate(bit));
+        }
+    }
+
+    while(!stack.isEmpty())
+    {
+        const Intermediate intermediate = stack.last();
+
+        if(planned & intermediate)
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        const int missing = dependencies(intermediate) & ~planned;
+        if(missing == NoIntermediates)
+        {
+            order.append(intermediate);
+            planned |= intermediate;
+            stack.pop_back();
+            continue;
+        }
+
+        for(int bit = Sorted; bit > NoIntermediates; bit >>= 1)
+        {
+            if(missing & bit)
+            {
+                stack.append(Intermediate(bit));
+            }
+        }
+    }
+
+    return order;
+}
+
+void AnalysisIntermediates::reset(const ID &id, const QVector<Point> &values)
+{
+    id_ = id;
+    values_ = values;
+    prepared_ = NoIntermediates;
+}
+
+void AnalysisIntermediates::prepare(const Plan &plan)
+{
+    for(int i = 0; i < plan.count(); i++)
+    {
+        if(!isPrepared(plan.at(i)))
+        {
+            compute(plan.at(i));
+            prepared_ |= plan.at(i);
+        }
+    }
+}
+
+double AnalysisIntermediates::sortedMedian(const int first, const int length) const
+{
+    return sortedMedian(sorted_, first, length);
+}
+
+double AnalysisIntermediates::sortedMedian(const QVector<Point> &sorted, const int first, const int length)
+{
+    if(length <= 0)
+    {
+        return 0.0;
+    }
+
+    const int middle = first + length / 2;
+    return (length % 2 == 1) ? sorted.at(middle) : (sorted.at(middle - 1) + sorted.at(middle)) / 2.0;
+}
+
+void AnalysisIntermediates::compute(const Intermediate intermediate)
+{
+    const int count = values_.count();
+
+    switch(intermediate)
+    {
+    case Points:
+        pointList_ = PointList::fromVector(id_, values_);
+        break;
+
+    case Sum:
+        sum_ = PointKernels::sum(values_);
+        break;
+
+    case Mean:
+        mean_ = (count == 0) ? 0.0 : sum_ / static_cast<double>(count);
+        break;
+
+    case SumOfSquares:
+        sumOfSquares_ = PointKernels::sumOfSquares(values_, mean_);
+        break;
+
+    case NonZeroCount:
+        nonZeroCount_ = PointKernels::countNonZero(values_);
+        break;
+
+    case MinMax:
+        minimum_ = 0.0;
+        maximum_ = 0.0;
+        if(count > 0)
+        {
+            PointKernels::minMax(values_.constData(), count, &minimum_, &maximum_);
+        }
+        break;
+
+    case Sorted:
+        // a reserved buffer keeps its capacity, sorting the next sequence does not allocate
+        if(sorted_.capacity() < count)
+        {
+            sorted_.reserve(count);
+        }
+        sorted_.resize(count);
+        std::copy(values_.constBegin(), values_.constEnd(), sorted_.begin());
+        std::sort(sorted_.begin(), sorted_.end());
+        break;
+
+    case NoIntermediates:
+        break;
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef ANALYSISINTERMEDIATES_H
+
+#define ANALYSISINTERMEDIATES_H
+
+#include "PointList.h"
+#include "PointKernels.h"
+
+// Values that several analyses of a sequence need, computed once per
+// sequence. Analyses declare the intermediates they read, the collection
+// takes the union with all dependencies, orders it once per set of
+// analyses and prepares the intermediates of every sequence in that order.
+// Buffers are kept between sequences, so one object serves as the scratch
+// space of a whole run.
+class AnalysisIntermediates
+{
+public:
+    enum Intermediate
+    {
+        NoIntermediates = 0,
+        Points = 1,
+        Sum = 2,
+        Mean = 4,
+        SumOfSquares = 8,
+        NonZeroCount = 16,
+        MinMax = 32,
+        Sorted = 64
+    };
+
+    typedef QVector<Intermediate> Plan;
+
+    AnalysisIntermediates();
+
+    // intermediates of the mask with all their dependencies, dependencies first
+    static Plan plan(const int intermediates);
+    static int dependencies(const Intermediate intermediate);
+
+    void reset(const ID &id, const QVector<Point> &values);
+    void prepare(const Plan &plan);
+
+    inline bool isPrepared(const Intermediate intermediate) const { return (prepared_ & intermediate) != 0;}
+
+    inline const ID& id() const { return id_;}
+    inline const QVector<Point>& values() const { return values_;}
+    inline int count() const { return values_.count();}
+
+    inline const PointList& pointList() const { return pointList_;}
+    inline double sum() const { return sum_;}
+    inline double mean() const { return mean_;}
+    inline double sumOfSquares() const { return sumOfSquares_;}
+    inline int nonZeroCount() const { return nonZeroCount_;}
+    inline double minimum() const { return minimum_;}
+    inline double maximum() const { return maximum_;}
+    inline const QVector<Point>& sorted() const { return sorted_;}
+
+    // median of the sorted points with ranks first .. first + length - 1
+    double sortedMedian(const int first, const int length) const;
+    static double sortedMedian(const QVector<Point> &sorted, const int first, const int length);
+
+private:
+    ID id_;
+    QVector<Point> values_;
+    int prepared_;
+
+    PointList pointList_;
+    double sum_;
+    double mean_;
+    double sumOfSquares_;
+    int nonZeroCount_;
+    double minimum_;
+    double maximum_;
+    QVector<Point> sorted_;
+
+    void compute(const Intermediate intermediate);
+};
+
+#endif // ANALYSISINTERMEDIATES_H
@@ -0,0 +1,149 @@
+#include "AnalysisResultMatrix.h"
+
+AnalysisResultMatrix::AnalysisResultMatrix()
+{
+}
+
+int AnalysisResultMatrix::appendRow(const ID &id)
+{
+    const int row = rowIDs_.count();
+
+    rowIDs_.append(id);
+    rowIndex_.insert(id, row);
+
+    for(int column = 0; column < columns_.count(); column++)
+    {
+        columns_[column].append(0.0);
+    }
+
+    analyzed_.resize(row + 1);
+
+    return row;
+}
+
+void AnalysisResultMatrix::reserveRows(const int rows)
+{
+    rowIDs_.reserve(rows);
+    rowIndex_.reserve(rows);
+
+    for(int column = 0; column < columns_.count(); column++)
+    {
+        columns_[column].reserve(rows);
+    }
+}
+
+int AnalysisResultMatrix::indexOfRow(const ID &id) const
+{
+    return rowIndex_.value(id, -1);
+}
+
+bool AnalysisResultMatrix::containsRow(const ID &id) const
+{
+    return rowIndex_.contains(id);
+}
+
+void AnalysisResultMatrix::appendColumn(const IDAnalysis &id)
+{
+    columnIDs_.append(id);
+    columns_.append(QVector<double>(rowIDs_.count(), 0.0));
+}
+
+void AnalysisResultMatrix::setValue(const int row, const int column, const double value)
+{
+    columns_[column][row] = value;
+}
+
+void AnalysisResultMatrix::setRow(const int row, const QVector<double> &values)
+{
+    setRow(row, values.constData(), values.count());
+}
+
+void AnalysisResultMatrix::setRow(const int row, const double *values, const int count)
+{
+    if(count != columns_.count())
+    {
+        qWarning() << "incorrect row size" << count << "expected" << columns_.count();
+        return;
+    }
+
+    for(int column = 0; column < columns_.count(); column++)
+    {
+        columns_[column][row] = values[column];
+    }
+
+    analyzed_.setBit(row);
+}
+
+void AnalysisResultMatrix::clearResults()
+{
+    for(int column = 0; column < columns_.count(); column++)
+    {
+        columns_[column].fill(0.0);
+    }
+
+    analyzed_.fill(false);
+}
+
+void AnalysisResultMatrix::clear()
+{
+    rowIDs_.clear();
+    rowIndex_.clear();
+    columnIDs_.clear();
+    columns_.clear();
+    analyzed_.clear();
+}
+
+AnalysisResult AnalysisResultMatrix::toResult(const int row) const
+{
+    AnalysisResult result;
+
+    if(!isAnalyzed(row))
+    {
+        return result;
+    }
+
+    for(int column = 0; column < columns_.count(); column++)
+    {
+        result.insert(columnIDs_.at(column), columns_.at(column).at(row));
+    }
+
+    return result;
+}
+
+AnalysisResults AnalysisResultMatrix::toResults() const
+{
+    AnalysisResults results;
+    results.reserve(rowIDs_.count());
+
+    for(int row = 0; row < rowIDs_.count(); row++)
+    {
+        results.insert(rowIDs_.at(row), toResult(row));
+    }
+
+    return results;
+}
+
+void AnalysisResultMatrix::setResults(const AnalysisResults &results)
+{
+    clearResults();
+
+    QHashIterator<ID, AnalysisResult> result(results);
+    while(result.hasNext())
+    {
+        result.next();
+
+        const int row = indexOfRow(result.key());
+        if(row < 0)
+        {
+            qWarning() << QString("AnalysisResultMatrix not contains ID: %1").arg(result.key());
+            continue;
+        }
+
+        for(int column = 0; column < columns_.count(); column++)
+        {
+            columns_[column][row] = result.value().value(columnIDs_.at(column), 0.0);
+        }
+
+        analyzed_.setBit(row, !result.value().isEmpty());
+    }
+}
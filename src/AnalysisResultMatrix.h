@@ -0,0 +1,87 @@
+#ifndef ANALYSISRESULTMATRIX_H
+
+#define ANALYSISRESULTMATRIX_H
+
+#include <QBitArray>
+
+#include "AnalysisCollection.h"
+
+class AnalysisBatch
+{
+public:
+    AnalysisBatch() :
+        run(0),
+        width(0)
+    {
+    }
+
+    AnalysisBatch(const int run, const int width) :
+        run(run),
+        width(width)
+    {
+    }
+
+    inline int count() const { return items.count();}
+    inline bool isEmpty() const { return items.isEmpty();}
+
+    inline void append(const ID &item, const QVector<double> &results)
+    { items.append(item); values << results; }
+
+    inline void append(const IDList &batchItems, const QVector<double> &results)
+    { items.append(batchItems); values << results; }
+
+    inline void clear() { items.clear(); values.clear();}
+
+    int run;
+    int width;
+    IDList items;
+    QVector<double> values;
+};
+
+class AnalysisResultMatrix
+{
+public:
+    AnalysisResultMatrix();
+
+    inline int rowCount() const { return rowIDs_.count();}
+    inline int columnCount() const { return columnIDs_.count();}
+
+    int appendRow(const ID &id);
+    void reserveRows(const int rows);
+    int indexOfRow(const ID &id) const;
+    bool containsRow(const ID &id) const;
+
+    inline const ID& rowID(const int row) const { return rowIDs_.at(row);}
+    inline const IDList& rowIDs() const { return rowIDs_;}
+
+    void appendColumn(const IDAnalysis &id);
+
+    inline const IDAnalysis& columnID(const int column) const { return columnIDs_.at(column);}
+    inline const IDAnalysisList& columnIDs() const { return columnIDs_;}
+    inline const QVector<double>& column(const int column) const { return columns_.at(column);}
+
+    inline double value(const int row, const int column) const { return columns_.at(column).at(row);}
+    void setValue(const int row, const int column, const double value);
+    void setRow(const int row, const QVector<double> &values);
+    void setRow(const int row, const double *values, const int count);
+
+    inline bool isAnalyzed(const int row) const { return analyzed_.testBit(row);}
+
+    void clearResults();
+    void clear();
+
+    AnalysisResult toResult(const int row) const;
+    AnalysisResults toResults() const;
+    void setResults(const AnalysisResults &results);
+
+private:
+    IDList rowIDs_;
+    QHash<ID, int> rowIndex_;
+
+    IDAnalysisList columnIDs_;
+    QVector< QVector<double> > columns_;
+
+    QBitArray analyzed_;
+};
+
+#endif // ANALYSISRESULTMATRIX_H
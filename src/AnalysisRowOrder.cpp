@@ -0,0 +1,278 @@
+#include "AnalysisRowOrder.h"
+
+#include <algorithm>
+#include <cstring>
+
+int AnalysisRowOrder::radixThreshold_ = 4096;
+
+AnalysisRowOrder::AnalysisRowOrder() :
+    sortedRows_(0),
+    sortingRows_(0)
+{
+}
+
+void AnalysisRowOrder::reset(const int rows)
+{
+    order_.resize(rows);
+    rows_.resize(rows);
+
+    for(int i = 0; i < rows; i++)
+    {
+        order_[i] = i;
+        rows_[i] = i;
+    }
+
+    keys_.clear();
+    sortedRows_ = rows;
+    sortingRows_ = rows;
+}
+
+void AnalysisRowOrder::appendRows(const int count)
+{
+    const bool wasSorted = isSorted();
+    const int firstRow = order_.count();
+
+    order_.reserve(firstRow + count);
+    rows_.reserve(firstRow + count);
+
+    for(int row = firstRow; row < firstRow + count; row++)
+    {
+        order_.append(row);
+        rows_.append(row);
+    }
+
+    // the view does not resort itself, new rows stay at the end. An unfinished
+    // sort keeps its own rows, so sortMore() never mixes the new rows into them
+    if(wasSorted)
+    {
+        sortedRows_ = order_.count();
+        sortingRows_ = order_.count();
+    }
+}
+
+void AnalysisRowOrder::sort(const AnalysisResultMatrix &matrix, const AnalysisSortKeys &keys, const int firstRows)
+{
+    if(matrix.rowCount() != order_.count())
+    {
+        qWarning() << "row order does not match results";
+        return;
+    }
+
+    if(keys.isEmpty())
+    {
+        reset(order_.count());
+        return;
+    }
+
+    keys_ = keys;
+    sortedRows_ = 0;
+    sortingRows_ = order_.count();
+
+    sortRange(matrix, 0, qMin(qMax(firstRows, 0), order_.count()));
+}
+
+void AnalysisRowOrder::sortMore(const AnalysisResultMatrix &matrix, const int rows)
+{
+    if(isSorted())
+    {
+        return;
+    }
+
+    if(matrix.rowCount() != order_.count())
+    {
+        qWarning() << "row order does not match results";
+        return;
+    }
+
+    const int remainingRows = sortingRows_ - sortedRows_;
+    sortRange(matrix, sortedRows_, (rows >= remainingRows) ? sortingRows_ : sortedRows_ + rows);
+}
+
+int AnalysisRowOrder::radixThreshold()
+{
+    return radixThreshold_;
+}
+
+void AnalysisRowOrder::setRadixThreshold(const int rows)
+{
+    radixThreshold_ = rows;
+}
+
+void AnalysisRowOrder::radixSort(int *rows, const int count, const QVector<double> &values, const Qt::SortOrder order)
+{
+    if(count < 2)
+    {
+        return;
+    }
+
+    const int digitBits = 16;
+    const int digits = 64 / digitBits;
+    const int buckets = 1 << digitBits;
+
+    QVector<quint64> keys(count);
+    for(int i = 0; i < count; i++)
+    {
+        const quint64 key = radixKey(values.at(rows[i]));
+        keys[i] = (order == Qt::AscendingOrder) ? key : ~key;
+    }
+
+    QVector<quint64> sortedKeys(count);
+    QVector<int> sortedRows(count);
+    QVector<int> offsets(buckets);
+
+    quint64 *keysFrom = keys.data();
+    quint64 *keysTo = sortedKeys.data();
+    int *rowsFrom = rows;
+    int *rowsTo = sortedRows.data();
+
+    for(int digit = 0; digit < digits; digit++)
+    {
+        const int shift = digit * digitBits;
+
+        offsets.fill(0);
+        for(int i = 0; i < count; i++)
+        {
+            offsets[int((keysFrom[i] >> shift) & (buckets - 1))]++;
+        }
+
+        // every key has the same digit, the pass would not move anything
+        if(offsets.at(int((keysFrom[0] >> shift) & (buckets - 1))) == count)
+        {
+            continue;
+        }
+
+        int offset = 0;
+        for(int bucket = 0; bucket < buckets; bucket++)
+        {
+            const int bucketSize = offsets.at(bucket);
+            offsets[bucket] = offset;
+            offset += bucketSize;
+        }
+
+        for(int i = 0; i < count; i++)
+        {
+            const int position = offsets[int((keysFrom[i] >> shift) & (buckets - 1))]++;
+            keysTo[position] = keysFrom[i];
+            rowsTo[position] = rowsFrom[i];
+        }
+
+        qSwap(keysFrom, keysTo);
+        qSwap(rowsFrom, rowsTo);
+    }
+
+    if(rowsFrom != rows)
+    {
+        std::memcpy(rows, rowsFrom, count * sizeof(int));
+    }
+}
+
+quint64 AnalysisRowOrder::radixKey(const double value)
+{
+    const quint64 signBit = Q_UINT64_C(0x8000000000000000);
+
+    if(value != value)
+    {
+        return ~quint64(0);
+    }
+
+    // -0.0 and 0.0 are equal for the comparator as well
+    const double canonicalValue = (value == 0.0) ? 0.0 : value;
+
+    quint64 bits;
+    std::memcpy(&bits, &canonicalValue, sizeof(bits));
+
+    return (bits & signBit) ? ~bits : (bits | signBit);
+}
+
+void AnalysisRowOrder::sortRange(const AnalysisResultMatrix &matrix, const int first, const int middle)
+{
+    int *begin = order_.data() + first;
+    int *end = order_.data() + sortingRows_;
+    const int count = sortingRows_ - first;
+
+    const RowLessThan lessThan(matrix, keys_);
+
+    if(middle < sortingRows_)
+    {
+        std::nth_element(begin, order_.data() + middle, end, lessThan);
+        std::sort(begin, order_.data() + middle, lessThan);
+    }
+    else if((keys_.count() == 1) && !keys_.first().isID() && (count >= radixThreshold_))
+    {
+        // radix sort keeps the input order of equal keys, so the rows go in matrix order
+        QBitArray isRemaining(sortingRows_);
+        for(int *row = begin; row != end; row++)
+        {
+            isRemaining.setBit(*row);
+        }
+
+        int *row = begin;
+        for(int sourceRow = 0; sourceRow < sortingRows_; sourceRow++)
+        {
+            if(isRemaining.testBit(sourceRow))
+            {
+                *row++ = sourceRow;
+            }
+        }
+
+        radixSort(begin, count, matrix.column(keys_.first().column), keys_.first().order);
+    }
+    else
+    {
+        std::sort(begin, end, lessThan);
+    }
+
+    sortedRows_ = qMin(middle, sortingRows_);
+    updateRows(first);
+}
+
+void AnalysisRowOrder::updateRows(const int first)
+{
+    for(int i = first; i < order_.count(); i++)
+    {
+        rows_[order_.at(i)] = i;
+    }
+}
+
+bool AnalysisRowOrder::RowLessThan::operator()(const int a, const int b) const
+{
+    for(int i = 0; i < keys_.count(); i++)
+    {
+        const AnalysisSortKey &key = keys_.at(i);
+        int result;
+
+        if(key.isID())
+        {
+            result = QString::compare(matrix_.rowID(a), matrix_.rowID(b));
+        }
+        else
+        {
+            result = compareValues(matrix_.value(a, key.column), matrix_.value(b, key.column));
+        }
+
+        if(result != 0)
+        {
+            return (key.order == Qt::AscendingOrder) ? (result < 0) : (result > 0);
+        }
+    }
+
+    return a < b;
+}
+
+int AnalysisRowOrder::RowLessThan::compareValues(const double a, const double b)
+{
+    const bool isANan = (a != a);
+    const bool isBNan = (b != b);
+
+    if(isANan || isBNan)
+    {
+        return int(isANan) - int(isBNan);
+    }
+
+    if(a < b)
+    {
+        return -1;
+    }
+
+    return (b < a) ? 1 : 0;
+}
@@ -0,0 +1,97 @@
+#ifndef ANALYSISROWORDER_H
+
+#define ANALYSISROWORDER_H
+
+#include "AnalysisResultMatrix.h"
+
+class AnalysisSortKey
+{
+public:
+    AnalysisSortKey() :
+        column(-1),
+        order(Qt::AscendingOrder)
+    {
+    }
+
+    AnalysisSortKey(const int column, const Qt::SortOrder order) :
+        column(column),
+        order(order)
+    {
+    }
+
+    inline bool isID() const { return column < 0;}
+
+    // -1 means row IDs, otherwise a column of AnalysisResultMatrix
+    int column;
+    Qt::SortOrder order;
+};
+
+typedef QList<AnalysisSortKey> AnalysisSortKeys;
+
+// View order over AnalysisResultMatrix rows. The matrix is never moved,
+// sorting only permutes order_. Rows equal by every key keep their matrix
+// order, so sorting is stable and does not depend on the sorting method.
+//
+// sort() orders only the first rows the view needs, the rest of the rows
+// are ordered later by sortMore(). Rows appended after sort() stay at the
+// end in matrix order, like the rows appended after a finished sort.
+class AnalysisRowOrder
+{
+public:
+    AnalysisRowOrder();
+
+    inline int rowCount() const { return order_.count();}
+    inline int sourceRow(const int viewRow) const { return order_.at(viewRow);}
+    inline int viewRow(const int sourceRow) const { return rows_.at(sourceRow);}
+    inline const QVector<int>& order() const { return order_;}
+
+    inline const AnalysisSortKeys& keys() const { return keys_;}
+    inline int sortedRows() const { return sortedRows_;}
+    inline bool isSorted() const { return sortedRows_ == sortingRows_;}
+
+    void reset(const int rows);
+    void appendRows(const int count);
+
+    void sort(const AnalysisResultMatrix &matrix, const AnalysisSortKeys &keys, const int firstRows);
+    void sortMore(const AnalysisResultMatrix &matrix, const int rows);
+
+    static int radixThreshold();
+    static void setRadixThreshold(const int rows);
+
+    static void radixSort(int *rows, const int count, const QVector<double> &values, const Qt::SortOrder order);
+    static quint64 radixKey(const double value);
+
+private:
+    QVector<int> order_;
+    QVector<int> rows_;
+
+    AnalysisSortKeys keys_;
+    int sortedRows_;
+    // rows of the last sort(), the rows after them were appended later
+    int sortingRows_;
+
+    static int radixThreshold_;
+
+    void sortRange(const AnalysisResultMatrix &matrix, const int first, const int middle);
+    void updateRows(const int first);
+
+    class RowLessThan
+    {
+    public:
+        RowLessThan(const AnalysisResultMatrix &matrix, const AnalysisSortKeys &keys) :
+            matrix_(matrix),
+            keys_(keys)
+        {
+        }
+
+        bool operator()(const int a, const int b) const;
+
+    private:
+        const AnalysisResultMatrix &matrix_;
+        const AnalysisSortKeys &keys_;
+
+        static int compareValues(const double a, const double b);
+    };
+};
+
+#endif // ANALYSISROWORDER_H
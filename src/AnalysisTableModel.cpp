@@ -1,17 +1,26 @@
 #include "AnalysisTableModel.h"
 
-
+const int AnalysisTableModel::defaultPrefetchRows_ = 100;
+const int AnalysisTableModel::defaultSortViewportRows_ = 1000;
+const int AnalysisTableModel::sortStepRows_ = 65536;
+const int AnalysisTableModel::maxSortKeys_ = 3;
 
 AnalysisTableModel::AnalysisTableModel(AbstractPointListReader *reader, QObject *parent):
     QAbstractItemModel(parent),
-    reader_(reader)
+    reader_(reader),
+    lazyWorker_(0),
+    backgroundFill_(false),
+    prefetchRows_(defaultPrefetchRows_),
+    requestsScheduled_(false),
+    sortViewportRows_(defaultSortViewportRows_),
+    sortingScheduled_(false)
 {
 
 }
 
 AnalysisTableModel::~AnalysisTableModel()
 {
-
+    delete lazyWorker_;
 }
 
 QModelIndex AnalysisTableModel::index(int row, int column, const QModelIndex &parent) const
@@ -26,12 +35,12 @@ QModelIndex AnalysisTableModel::parent(const QModelIndex &child) const
 
 int AnalysisTableModel::rowCount(const QModelIndex &parent) const
 {
-    return items_.count();
+    return results_.rowCount();
 }
 
 int AnalysisTableModel::columnCount(const QModelIndex &parent) const
 {
-    return collection_.size() + 1;
+    return results_.columnCount() + 1;
 }
 
 QVariant AnalysisTableModel::data(const QModelIndex &index, int role) const
@@ -41,27 +50,28 @@ QVariant AnalysisTableModel::data(const QModelIndex &index, int role) const
         return QVariant();
     }
 
-    IDAnalysisList listAnalysis = collection_.getIDList();
-
     if (role == Qt::DisplayRole)
     {
+        const int row = order_.sourceRow(index.row());
+
         if(index.column() == 0)
         {
-            return items_.at(index.row());
+            return results_.rowID(row);
         }
         else
         {
-            if(results_.isEmpty())
+            if(!results_.isAnalyzed(row))
             {
-                return 0.0;
-            }
+                if(lazyWorker_ != 0)
+                {
+                    requestRow(row);
+                    return QString("...");
+                }
 
-            if(!results_.value(items_.at(index.row())).contains(listAnalysis.at(index.column() - 1)))
-            {
                 return 0.0;
             }
 
-            return results_.value(items_.at(index.row())).value(listAnalysis.at(index.column() - 1));
+            return results_.value(row, index.column() - 1);
         }
     }
     else
@@ -79,8 +89,6 @@ QVariant AnalysisTableModel::headerData(int section, Qt::Orientation orientation
         return QVariant();
     }
 
-    QStringList list = collection_.getIDList();
-
     if (orientation == Qt::Horizontal)
     {
         if(section == 0)
@@ -89,7 +97,7 @@ QVariant AnalysisTableModel::headerData(int section, Qt::Orientation orientation
         }
         else
         {
-            return list.at(section-1);
+            return results_.columnID(section - 1);
         }
     }
 
@@ -101,158 +109,509 @@ QVariant AnalysisTableModel::headerData(int section, Qt::Orientation orientation
     return QVariant();
 }
 
-bool AnalysisTableModel::columnIDLessThan(const ID &s1, const ID &s2)
+void AnalysisTableModel::sort(int column, Qt::SortOrder order)
 {
-    return s1 < s2;
+    if(column >= columnCount())
+    {
+        return;
+    }
+
+    if(column < 0)
+    {
+        emit layoutAboutToBeChanged();
+
+        const QVector<int> oldOrder = order_.order();
+        order_.reset(results_.rowCount());
+        changePersistentRows(oldOrder);
+
+        emit layoutChanged();
+        return;
+    }
+
+    // the previous keys break ties, so sorting by several columns in turn is stable
+    AnalysisSortKeys keys = order_.keys();
+    for(int i = keys.count() - 1; i >= 0; i--)
+    {
+        if(keys.at(i).column == column - 1)
+        {
+            keys.removeAt(i);
+        }
+    }
+
+    keys.prepend(AnalysisSortKey(column - 1, order));
+    while(keys.count() > maxSortKeys_)
+    {
+        keys.removeLast();
+    }
+
+    emit layoutAboutToBeChanged();
+
+    const QVector<int> oldOrder = order_.order();
+    order_.sort(results_, keys, sortViewportRows_);
+    changePersistentRows(oldOrder);
+
+    emit layoutChanged();
+
+    scheduleSorting();
 }
 
-bool AnalysisTableModel::columnIDMoreThan(const ID &s1, const ID &s2)
+IDAnalysisList AnalysisTableModel::getHeaders() const
 {
-    return s1 > s2;
+    return results_.columnIDs();
 }
 
-void AnalysisTableModel::sort(int column, Qt::SortOrder order)
+IDList AnalysisTableModel::getPointsIDs() const
 {
-    if(column == 0)
+    IDList items;
+    items.reserve(order_.rowCount());
+
+    for(int row = 0; row < order_.rowCount(); row++)
     {
-        switch(order)
-        {
-        case Qt::AscendingOrder: qSort(items_.begin(), items_.end(), columnIDLessThan); break;
-        case Qt::DescendingOrder: qSort(items_.begin(), items_.end(), columnIDMoreThan); break;
-        }
+        items.append(results_.rowID(order_.sourceRow(row)));
     }
-    else
+
+    return items;
+}
+
+AnalysisResults AnalysisTableModel::Results() const
+{
+    return results_.toResults();
+}
+
+void AnalysisTableModel::setResults(const AnalysisResults &results)
+{
+    results_.setResults(results);
+    emitResultsChanged();
+}
+
+void AnalysisTableModel::addAnalysis(AbstractAnalysis *analysis)
+{
+    const IDAnalysisList outputIDs = analysis->outputIDs();
+
+    bool isNewAnalysis = analysis->isValid()
+            && (collection_.indexOfAnalysis(analysis->id()) < 0);
+
+    foreach(const IDAnalysis& idOutput, outputIDs)
+    {
+        isNewAnalysis = isNewAnalysis && !collection_.containsOutput(idOutput);
+    }
+
+    if(!isNewAnalysis)
+    {
+        collection_.addAnalysis(analysis);
+        return;
+    }
+
+    const int column = columnCount();
+
+    beginInsertColumns(QModelIndex(), column, column + outputIDs.count() - 1);
+    collection_.addAnalysis(analysis);
+    foreach(const IDAnalysis& idOutput, outputIDs)
+    {
+        results_.appendColumn(idOutput);
+    }
+    endInsertColumns();
+
+    if(lazyWorker_ != 0)
+    {
+        results_.clearResults();
+        restartLazyAnalysis();
+    }
+}
+
+void AnalysisTableModel::appendPointList(const ID &id)
+{
+    if(!isNewPointList(id))
+    {
+        return;
+    }
+
+    const int row = rowCount();
+
+    beginInsertRows(QModelIndex(), row, row);
+    results_.appendRow(id);
+    order_.appendRows(1);
+    endInsertRows();
+
+    if((lazyWorker_ != 0) && backgroundFill_)
     {
-        const QString  sortingAnalysis = collection_.getIDAt(column - 1);
+        lazyWorker_->enqueue(IDList() << id);
+    }
+}
 
-        QList< QPair<ID, double> > resultPairs;
+void AnalysisTableModel::appendPointList(const IDList &items)
+{
+    IDList newItems;
+    QSet<ID> newItemsSet;
+    newItemsSet.reserve(items.count());
 
-        foreach(const ID& item, items_)
+    foreach(const ID& id, items)
+    {
+        if(newItemsSet.contains(id))
         {
-            double result = 0.0;
-            if(results_.contains(item))
-            {
-                if(results_.value(item).contains(sortingAnalysis))
-                {
-                    result = results_.value(item).value(sortingAnalysis);
-                }
-            }
-            resultPairs.append(QPair<ID, double>(item, result));
+            qWarning() << QString("AnalysisTableModel contains ID: %1").arg(id);
+            continue;
         }
 
-        switch(order)
+        if(isNewPointList(id))
         {
-        case Qt::AscendingOrder: qSort(resultPairs.begin(), resultPairs.end(), sortByAnalysisLessThan); break;
-        case Qt::DescendingOrder: qSort(resultPairs.begin(), resultPairs.end(), sortByAnalysisMoreThan); break;
+            newItems.append(id);
+            newItemsSet.insert(id);
         }
+    }
+
+    if(newItems.isEmpty())
+    {
+        return;
+    }
+
+    const int firstRow = rowCount();
+
+    beginInsertRows(QModelIndex(), firstRow, firstRow + newItems.count() - 1);
+    results_.reserveRows(firstRow + newItems.count());
+    foreach(const ID& id, newItems)
+    {
+        results_.appendRow(id);
+    }
+    order_.appendRows(newItems.count());
+    endInsertRows();
+
+    if((lazyWorker_ != 0) && backgroundFill_)
+    {
+        lazyWorker_->enqueue(newItems);
+    }
+}
+
+bool AnalysisTableModel::containsPointList(const ID &id) const
+{
+    return results_.containsRow(id);
+}
+
+void AnalysisTableModel::analyzeAll()
+{
+    results_.clearResults();
+
+    AnalysisEvaluator evaluator(collection_, reader_);
+    evaluator.plan(results_.rowIDs());
+
+    AnalysisBatch batch(0, collection_.outputCount());
+    evaluator.evaluate(results_.rowIDs(), batch);
+    evaluator.flush(batch);
+
+    setBatchResults(batch);
+    emitResultsChanged();
+}
+
+const AnalysisCollection &AnalysisTableModel::collection() const
+{
+    return collection_;
+}
+
+void AnalysisTableModel::clearResults()
+{
+    results_.clearResults();
+
+    if(lazyWorker_ != 0)
+    {
+        restartLazyAnalysis();
+        return;
+    }
 
-        IDList sortedItems;
+    emitResultsChanged();
+}
+
+void AnalysisTableModel::appendResults(const AnalysisBatch &batch)
+{
+    if(batch.width != results_.columnCount())
+    {
+        qWarning() << "analysis results do not match analysis columns";
+        return;
+    }
 
-        for(int i = 0; i < resultPairs.size(); ++i)
+    int firstRow = rowCount();
+    int lastRow = -1;
+
+    for(int i = 0; i < batch.count(); i++)
+    {
+        const int row = results_.indexOfRow(batch.items.at(i));
+        if(row < 0)
         {
-            const QPair<ID, double> &pair = resultPairs.at(i);
-            sortedItems << pair.first;
+            continue;
         }
 
-        items_ = sortedItems;
+        results_.setRow(row, batch.values.constData() + i * batch.width, batch.width);
+
+        firstRow = qMin(firstRow, order_.viewRow(row));
+        lastRow = qMax(lastRow, order_.viewRow(row));
     }
 
-    reset();
+    if(lastRow >= firstRow)
+    {
+        emit dataChanged(index(firstRow, 1), index(lastRow, columnCount() - 1));
+    }
 }
 
-IDAnalysisList AnalysisTableModel::getHeaders() const
+bool AnalysisTableModel::isLazyMode() const
+{
+    return lazyWorker_ != 0;
+}
+
+void AnalysisTableModel::setLazyMode(const bool lazy, const bool backgroundFill)
 {
-    return collection_.getIDList();
+    if(!lazy)
+    {
+        delete lazyWorker_;
+        lazyWorker_ = 0;
+
+        requested_.clear();
+        pendingRequests_.clear();
+
+        emitResultsChanged();
+        return;
+    }
+
+    if(lazyWorker_ == 0)
+    {
+        lazyWorker_ = new AnalysisWorker(reader_, this);
+        connect(lazyWorker_, SIGNAL(resultsReady(AnalysisBatch)),
+                this, SLOT(onLazyResults(AnalysisBatch)));
+    }
+
+    backgroundFill_ = backgroundFill;
+    restartLazyAnalysis();
 }
 
-const IDList &AnalysisTableModel::getPointsIDs() const
+int AnalysisTableModel::prefetchRows() const
 {
-    return items_;
+    return prefetchRows_;
 }
 
-const AnalysisResults &AnalysisTableModel::Results() const
+void AnalysisTableModel::setPrefetchRows(const int rows)
 {
-    return results_;
+    prefetchRows_ = qMax(0, rows);
 }
 
-void AnalysisTableModel::setResults(const AnalysisResults &results)
+bool AnalysisTableModel::isSorted() const
 {
-    results_ = AnalysisResults(results);
+    return order_.isSorted();
 }
 
-void AnalysisTableModel::addAnalysis(AbstractAnalysis *analysis)
+int AnalysisTableModel::sortViewportRows() const
 {
-    collection_.addAnalysis(analysis);
-    reset();
+    return sortViewportRows_;
 }
 
-void AnalysisTableModel::appendPointList(const ID &id)
+void AnalysisTableModel::setSortViewportRows(const int rows)
 {
-    appendPointList_(id);
-    reset();
+    sortViewportRows_ = qMax(0, rows);
 }
 
-void AnalysisTableModel::appendPointList(const IDList &items)
+void AnalysisTableModel::onLazyResults(const AnalysisBatch &batch)
 {
-    foreach(ID id, items)
+    if((lazyWorker_ == 0) || (batch.run != lazyWorker_->currentRun()))
     {
-        appendPointList_(id);
+        return;
     }
-    reset();
+
+    appendResults(batch);
 }
 
-bool AnalysisTableModel::containsPointList(const ID &id) const
+void AnalysisTableModel::flushRequests()
+{
+    requestsScheduled_ = false;
+
+    if((lazyWorker_ == 0) || pendingRequests_.isEmpty())
+    {
+        pendingRequests_.clear();
+        return;
+    }
+
+    int firstRow = rowCount();
+    int lastRow = -1;
+
+    foreach(const ID& id, pendingRequests_)
+    {
+        const int row = order_.viewRow(results_.indexOfRow(id));
+        firstRow = qMin(firstRow, row);
+        lastRow = qMax(lastRow, row);
+    }
+
+    IDList items;
+
+    for(int distance = prefetchRows_; distance > 0; distance--)
+    {
+        const int rows[] = { firstRow - distance, lastRow + distance };
+
+        for(int i = 0; i < 2; i++)
+        {
+            if((rows[i] < 0) || (rows[i] >= rowCount()))
+            {
+                continue;
+            }
+
+            const int row = order_.sourceRow(rows[i]);
+            if(results_.isAnalyzed(row))
+            {
+                continue;
+            }
+
+            const ID &id = results_.rowID(row);
+            if(!requested_.contains(id))
+            {
+                requested_.insert(id);
+                items.append(id);
+            }
+        }
+    }
+
+    for(int i = pendingRequests_.count() - 1; i >= 0; i--)
+    {
+        items.append(pendingRequests_.at(i));
+    }
+    pendingRequests_.clear();
+
+    lazyWorker_->request(items);
+}
+
+void AnalysisTableModel::requestRow(const int row) const
 {
-    return items_.contains(id);
+    const ID &id = results_.rowID(row);
+
+    if(requested_.contains(id))
+    {
+        return;
+    }
+
+    requested_.insert(id);
+    pendingRequests_.append(id);
+
+    if(!requestsScheduled_)
+    {
+        requestsScheduled_ = true;
+        QTimer::singleShot(0, const_cast<AnalysisTableModel*>(this), SLOT(flushRequests()));
+    }
 }
 
-void AnalysisTableModel::analyzeAll()
+void AnalysisTableModel::restartLazyAnalysis()
 {
-    results_.clear();
+    requested_.clear();
+    pendingRequests_.clear();
 
-    foreach(const ID& item, items_)
+    IDList backgroundItems;
+    if(backgroundFill_)
     {
-        analyze(item);
+        for(int viewRow = 0; viewRow < order_.rowCount(); viewRow++)
+        {
+            const int row = order_.sourceRow(viewRow);
+            if(!results_.isAnalyzed(row))
+            {
+                backgroundItems.append(results_.rowID(row));
+            }
+        }
     }
-    reset();
+
+    lazyWorker_->analyzeOnDemand(collection_, backgroundItems);
+
+    emitResultsChanged();
 }
 
 void AnalysisTableModel::analyze(const ID &item)
 {
-    PointList pointList = reader_->read(item);
-    AnalysisResult result = collection_.analyze(pointList);
-    results_.insertInc(item, result);
+    const int row = results_.indexOfRow(item);
+    if(row < 0)
+    {
+        qWarning() << QString("AnalysisTableModel not contains ID: %1").arg(item);
+        return;
+    }
+
+    analyzeRow(row);
+
+    const int viewRow = order_.viewRow(row);
+    emit dataChanged(index(viewRow, 1), index(viewRow, columnCount() - 1));
 }
 
-bool AnalysisTableModel::sortByAnalysisLessThan(const QPair<ID, double> &pair1,
-                                                const QPair<ID, double> &pair2)
+void AnalysisTableModel::setBatchResults(const AnalysisBatch &batch)
 {
-    return pair1.second <= pair2.second;
+    for(int i = 0; i < batch.count(); i++)
+    {
+        results_.setRow(results_.indexOfRow(batch.items.at(i)), batch.values.constData() + i * batch.width, batch.width);
+    }
 }
 
-bool AnalysisTableModel::sortByAnalysisMoreThan(const QPair<ID, double> &pair1,
-                                                const QPair<ID, double> &pair2)
+void AnalysisTableModel::analyzeRow(const int row)
 {
-
-   return sortByAnalysisLessThan(pair2, pair1);
+    AnalysisEvaluator evaluator(collection_, reader_);
+    results_.setRow(row, evaluator.evaluateRow(results_.rowID(row)));
 }
 
-void AnalysisTableModel::appendPointList_(const ID &id)
+bool AnalysisTableModel::isNewPointList(const ID &id) const
 {
     if(id.isEmpty())
     {
         qWarning() << "ID not set";
-        return;
+        return false;
     }
 
-    if(!results_.contains(id))
+    if(results_.containsRow(id))
     {
-        items_.append(id);
-        results_.insert(id, AnalysisResult());
+        qWarning() << QString("AnalysisTableModel contains ID: %1").arg(id);
+        return false;
     }
-    else
+
+    return true;
+}
+
+void AnalysisTableModel::emitResultsChanged()
+{
+    if((rowCount() > 0) && (columnCount() > 1))
     {
-        qWarning() << QString("AnalysisTableModel contains ID: %1").arg(id);
+        emit dataChanged(index(0, 1), index(rowCount() - 1, columnCount() - 1));
     }
 }
 
+void AnalysisTableModel::scheduleSorting()
+{
+    if(!order_.isSorted() && !sortingScheduled_)
+    {
+        sortingScheduled_ = true;
+        QTimer::singleShot(0, this, SLOT(continueSorting()));
+    }
+}
+
+void AnalysisTableModel::continueSorting()
+{
+    sortingScheduled_ = false;
+
+    if(order_.isSorted())
+    {
+        return;
+    }
+
+    emit layoutAboutToBeChanged();
+
+    const QVector<int> oldOrder = order_.order();
+    order_.sortMore(results_, qMax(sortStepRows_, order_.sortedRows()));
+    changePersistentRows(oldOrder);
+
+    emit layoutChanged();
+
+    scheduleSorting();
+}
+
+void AnalysisTableModel::changePersistentRows(const QVector<int> &oldOrder)
+{
+    const QModelIndexList oldIndexes = persistentIndexList();
+    if(oldIndexes.isEmpty())
+    {
+        return;
+    }
+
+    QModelIndexList newIndexes;
+    foreach(const QModelIndex& oldIndex, oldIndexes)
+    {
+        const int row = order_.viewRow(oldOrder.at(oldIndex.row()));
+        newIndexes.append(index(row, oldIndex.column()));
+    }
+
+    changePersistentIndexList(oldIndexes, newIndexes);
+}
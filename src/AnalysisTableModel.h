@@ -3,10 +3,13 @@
 #define ANALYSISTABLEMODEL_H
 
 #include <QAbstractItemModel>
-
-#include "../mocs/MocPointListReader.h"
+#include <QTimer>
 
 #include "AnalysisCollection.h"
+#include "AnalysisEvaluator.h"
+#include "AnalysisResultMatrix.h"
+#include "AnalysisRowOrder.h"
+#include "AnalysisWorker.h"
 
 
 class AnalysisTableModel : public QAbstractItemModel
@@ -33,9 +36,9 @@ public:
     void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
 
     IDAnalysisList getHeaders() const;
-    const IDList& getPointsIDs() const;
+    IDList getPointsIDs() const;
 
-    const AnalysisResults& Results() const;
+    AnalysisResults Results() const;
     void  setResults(const AnalysisResults& results);
 
     void addAnalysis(AbstractAnalysis *analysis);
@@ -46,25 +49,61 @@ public:
 
     void analyzeAll();
 
+    const AnalysisCollection& collection() const;
+    void clearResults();
+    void appendResults(const AnalysisBatch &batch);
+
+    bool isLazyMode() const;
+    void setLazyMode(const bool lazy, const bool backgroundFill = false);
+
+    int prefetchRows() const;
+    void setPrefetchRows(const int rows);
+
+    bool isSorted() const;
+    int sortViewportRows() const;
+    void setSortViewportRows(const int rows);
+
 
 protected slots:
     void analyze(const ID& item);
 
-    static bool sortByAnalysisLessThan(const QPair<ID, double> &pair1,
-                                const QPair<ID, double> &pair2);
-    static bool sortByAnalysisMoreThan(const QPair<ID, double> &pair1,
-                                       const QPair<ID, double> &pair2);
-    static bool columnIDLessThan(const ID &s1, const ID &s2);
-    static bool columnIDMoreThan(const ID &s1, const ID &s2);
+private slots:
+    void onLazyResults(const AnalysisBatch &batch);
+    void flushRequests();
+    void continueSorting();
 
 private:
-    AnalysisResults results_;
+    AnalysisResultMatrix results_;
+    AnalysisRowOrder order_;
     AnalysisCollection collection_;
-    IDList items_;
     AbstractPointListReader *reader_;
 
+    AnalysisWorker *lazyWorker_;
+    bool backgroundFill_;
+    int prefetchRows_;
+
+    mutable QSet<ID> requested_;
+    mutable IDList pendingRequests_;
+    mutable bool requestsScheduled_;
+
+    int sortViewportRows_;
+    bool sortingScheduled_;
+
+    static const int defaultPrefetchRows_;
+    static const int defaultSortViewportRows_;
+    static const int sortStepRows_;
+    static const int maxSortKeys_;
+
+    void requestRow(const int row) const;
+    void restartLazyAnalysis();
+
+    void setBatchResults(const AnalysisBatch &batch);
+    void analyzeRow(const int row);
+    bool isNewPointList(const ID& id) const;
 
-    void appendPointList_(const ID& id);
+    void emitResultsChanged();
+    void scheduleSorting();
+    void changePersistentRows(const QVector<int> &oldOrder);
 };
 
 #endif // ANALYSISTABLEMODEL_H
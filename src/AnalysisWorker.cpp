@@ -0,0 +1,197 @@
+#include "AnalysisWorker.h"
+#include "Metatypes.h"
+
+const int AnalysisWorker::defaultBatchInterval_ = 200;
+
+AnalysisWorker::AnalysisWorker(AbstractPointListReader *reader, QObject *parent) :
+    QThread(parent),
+    reader_(reader),
+    collection_(0),
+    onDemand_(false),
+    run_(0),
+    batchInterval_(defaultBatchInterval_),
+    cancelled_(0)
+{
+    qRegisterMetaType<AnalysisBatch>("AnalysisBatch");
+}
+
+AnalysisWorker::~AnalysisWorker()
+{
+    cancel();
+    wait();
+
+    delete collection_;
+}
+
+void AnalysisWorker::analyze(const AnalysisCollection &collection, const IDList &items)
+{
+    start_(collection, items, false);
+}
+
+void AnalysisWorker::analyzeOnDemand(const AnalysisCollection &collection, const IDList &backgroundItems)
+{
+    start_(collection, backgroundItems, true);
+}
+
+void AnalysisWorker::request(const IDList &items)
+{
+    QMutexLocker locker(&mutex_);
+
+    requested_.append(items);
+    queueChanged_.wakeAll();
+}
+
+void AnalysisWorker::enqueue(const IDList &items)
+{
+    QMutexLocker locker(&mutex_);
+
+    queued_.append(items);
+    queueChanged_.wakeAll();
+}
+
+void AnalysisWorker::cancel()
+{
+    QMutexLocker locker(&mutex_);
+
+    cancelled_ = 1;
+    queueChanged_.wakeAll();
+}
+
+int AnalysisWorker::currentRun() const
+{
+    return run_;
+}
+
+bool AnalysisWorker::isCancelled() const
+{
+    return cancelled_ != 0;
+}
+
+int AnalysisWorker::batchInterval() const
+{
+    return batchInterval_;
+}
+
+void AnalysisWorker::setBatchInterval(const int msecs)
+{
+    batchInterval_ = qMax(0, msecs);
+}
+
+void AnalysisWorker::start_(const AnalysisCollection &collection, const IDList &items, const bool onDemand)
+{
+    cancel();
+    wait();
+
+    delete collection_;
+    collection_ = collection.clone();
+
+    requested_.clear();
+    queued_ = items;
+    processed_.clear();
+    onDemand_ = onDemand;
+
+    run_++;
+    cancelled_ = 0;
+
+    start(QThread::LowPriority);
+}
+
+void AnalysisWorker::run()
+{
+    AbstractPointListReader *reader = reader_->clone();
+    AnalysisEvaluator evaluator(*collection_, reader);
+
+    AnalysisBatch batch(run_, collection_->outputCount());
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 lastFlush = 0;
+
+    int processed = 0;
+
+    {
+        QMutexLocker locker(&mutex_);
+        evaluator.plan(queued_);
+    }
+
+    // pushdown takes up to one aggregate query of items at once
+    const int itemsPerStep = evaluator.itemsPerStep();
+
+    forever
+    {
+        IDList items;
+        bool isLastRequested = false;
+
+        {
+            QMutexLocker locker(&mutex_);
+
+            while(!isCancelled() && onDemand_ && requested_.isEmpty() && queued_.isEmpty())
+            {
+                if(!batch.isEmpty() || evaluator.hasPending())
+                {
+                    locker.unlock();
+                    flush(evaluator, batch, processed, timer);
+                    lastFlush = timer.elapsed();
+                    locker.relock();
+                    continue;
+                }
+
+                queueChanged_.wait(&mutex_);
+            }
+
+            if(isCancelled() || (requested_.isEmpty() && queued_.isEmpty()))
+            {
+                break;
+            }
+
+            while((items.count() < itemsPerStep) && !(requested_.isEmpty() && queued_.isEmpty()))
+            {
+                const bool isRequested = !requested_.isEmpty();
+                const ID item = isRequested ? requested_.takeLast() : queued_.takeFirst();
+                isLastRequested = isLastRequested || (isRequested && requested_.isEmpty());
+
+                if(processed_.contains(item))
+                {
+                    continue;
+                }
+                processed_.insert(item);
+                items.append(item);
+            }
+        }
+
+        evaluator.evaluate(items, batch);
+        processed += items.count();
+
+        if(isLastRequested || ((timer.elapsed() - lastFlush) >= batchInterval_))
+        {
+            flush(evaluator, batch, processed, timer);
+            lastFlush = timer.elapsed();
+        }
+    }
+
+    flush(evaluator, batch, processed, timer);
+
+    delete reader;
+}
+
+int AnalysisWorker::pendingCount()
+{
+    QMutexLocker locker(&mutex_);
+    return requested_.count() + queued_.count();
+}
+
+void AnalysisWorker::flush(AnalysisEvaluator &evaluator, AnalysisBatch &batch, const int processed, const QElapsedTimer &timer)
+{
+    evaluator.flush(batch);
+
+    if(!batch.isEmpty())
+    {
+        emit resultsReady(batch);
+        batch.clear();
+    }
+
+    const qint64 elapsed = qMax(Q_INT64_C(1), timer.elapsed());
+    const double itemsPerSecond = processed * 1000.0 / static_cast<double>(elapsed);
+
+    emit progressChanged(batch.run, processed, processed + pendingCount(), itemsPerSecond);
+}
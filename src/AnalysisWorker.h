@@ -0,0 +1,64 @@
+#ifndef ANALYSISWORKER_H
+
+#define ANALYSISWORKER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+
+#include "AbstractPointListReader.h"
+#include "AnalysisCollection.h"
+#include "AnalysisEvaluator.h"
+
+class AnalysisWorker : public QThread
+{
+    Q_OBJECT
+public:
+    AnalysisWorker(AbstractPointListReader *reader, QObject *parent = 0);
+    ~AnalysisWorker();
+
+    void analyze(const AnalysisCollection &collection, const IDList &items);
+    void analyzeOnDemand(const AnalysisCollection &collection, const IDList &backgroundItems = IDList());
+
+    void request(const IDList &items);
+    void enqueue(const IDList &items);
+    void cancel();
+
+    int currentRun() const;
+    bool isCancelled() const;
+
+    int batchInterval() const;
+    void setBatchInterval(const int msecs);
+
+signals:
+    void resultsReady(const AnalysisBatch &batch);
+    // run is the currentRun() of the worker when it was emitted, like AnalysisBatch::run
+    void progressChanged(const int run, const int processed, const int total, const double itemsPerSecond);
+
+protected:
+    void run();
+
+private:
+    AbstractPointListReader *reader_;
+    AnalysisCollection *collection_;
+
+    QMutex mutex_;
+    QWaitCondition queueChanged_;
+    IDList requested_;
+    IDList queued_;
+    QSet<ID> processed_;
+    bool onDemand_;
+
+    int run_;
+    int batchInterval_;
+    QAtomicInt cancelled_;
+
+    static const int defaultBatchInterval_;
+
+    void start_(const AnalysisCollection &collection, const IDList &items, const bool onDemand);
+    int pendingCount();
+    void flush(AnalysisEvaluator &evaluator, AnalysisBatch &batch, const int processed, const QElapsedTimer &timer);
+};
+
+#endif // ANALYSISWORKER_H
@@ -18,12 +18,49 @@ double AverageAnalysis::analyze(const PointList &values) const
         return 0;
     }
 
-    const double sum = AbstractAnalysis::listSum(values);
+    const QVector<Point> points = values.toVector();
+
+    if(ParallelPoints::isParallel(points.count()))
+    {
+        return ParallelPoints::accumulate(points).average();
+    }
+
+    const double sum = PointKernels::sum(points);
     const double result = sum / static_cast<double>(values.count());
 
     return result;
 }
 
+SequenceBatch::Statistic AverageAnalysis::batchStatistic() const
+{
+    return SequenceBatch::Average;
+}
+
+bool AverageAnalysis::isIncremental() const
+{
+    return true;
+}
+
+void AverageAnalysis::analyzeState(const SequenceState &state, double *outputs) const
+{
+    outputs[0] = state.accumulator().average();
+}
+
+StorageAggregateList AverageAnalysis::storageAggregates() const
+{
+    return StorageAggregateList() << StorageAggregate::Average;
+}
+
+int AverageAnalysis::intermediates() const
+{
+    return AnalysisIntermediates::Mean;
+}
+
+void AverageAnalysis::analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const
+{
+    outputs[0] = intermediates.mean();
+}
+
 AverageAnalysis *AverageAnalysis::clone()
 {
     return new AverageAnalysis(*this);
@@ -17,17 +17,16 @@ double AverageIgnoreNullAnalysis::analyze(const PointList &values) const
         return 0;
     }
 
-    const double sum = AbstractAnalysis::listSum(values);
-    int length = 0;
+    const QVector<Point> points = values.toVector();
 
-    foreach(const Point value, values.points())
+    if(ParallelPoints::isParallel(points.count()))
     {
-        if(value != 0)
-        {
-            length++;
-        }
+        return ParallelPoints::accumulate(points).averageIgnoreNull();
     }
 
+    const double sum = PointKernels::sum(points);
+    const int length = PointKernels::countNonZero(points);
+
     if(length == 0)
     {
         return 0.0;
@@ -38,6 +37,37 @@ double AverageIgnoreNullAnalysis::analyze(const PointList &values) const
     return result;
 }
 
+SequenceBatch::Statistic AverageIgnoreNullAnalysis::batchStatistic() const
+{
+    return SequenceBatch::AverageIgnoreNull;
+}
+
+bool AverageIgnoreNullAnalysis::isIncremental() const
+{
+    return true;
+}
+
+void AverageIgnoreNullAnalysis::analyzeState(const SequenceState &state, double *outputs) const
+{
+    outputs[0] = state.accumulator().averageIgnoreNull();
+}
+
+StorageAggregateList AverageIgnoreNullAnalysis::storageAggregates() const
+{
+    return StorageAggregateList() << StorageAggregate::AverageIgnoreNull;
+}
+
+int AverageIgnoreNullAnalysis::intermediates() const
+{
+    return AnalysisIntermediates::Sum | AnalysisIntermediates::NonZeroCount;
+}
+
+void AverageIgnoreNullAnalysis::analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const
+{
+    const int length = intermediates.nonZeroCount();
+    outputs[0] = (length == 0) ? 0.0 : intermediates.sum() / static_cast<double>(length);
+}
+
 AverageIgnoreNullAnalysis *AverageIgnoreNullAnalysis::clone()
 {
     return new AverageIgnoreNullAnalysis(*this);
@@ -0,0 +1,80 @@
+#include "CSVAnalysisSink.h"
+
+CSVAnalysisSink::CSVAnalysisSink(const QString &fileName) :
+    file_(fileName),
+    width_(0)
+{
+}
+
+CSVAnalysisSink::~CSVAnalysisSink()
+{
+    if(file_.isOpen())
+    {
+        finish();
+    }
+}
+
+bool CSVAnalysisSink::begin(const IDAnalysisList &outputIDs)
+{
+    const bool isOpened = (file_.fileName() == "-")
+            ? file_.open(stdout, QFile::WriteOnly | QIODevice::Text)
+            : file_.open(QFile::WriteOnly | QIODevice::Text);
+
+    if(!isOpened)
+    {
+        qWarning() << file_.fileName() << "can't open for writing";
+        return false;
+    }
+
+    stream_.setDevice(&file_);
+    stream_.setRealNumberPrecision(17);
+
+    stream_ << "id";
+    foreach(const IDAnalysis &id, outputIDs)
+    {
+        stream_ << ";" << id;
+    }
+    stream_ << '\n';
+
+    width_ = outputIDs.count();
+
+    return true;
+}
+
+bool CSVAnalysisSink::write(const IDList &items, const QVector<double> &values)
+{
+    if(!file_.isOpen())
+    {
+        qWarning() << file_.fileName() << "not open";
+        return false;
+    }
+
+    for(int row = 0; row < items.count(); row++)
+    {
+        stream_ << items.at(row);
+        for(int column = 0; column < width_; column++)
+        {
+            stream_ << ";" << values.at(row * width_ + column);
+        }
+        stream_ << '\n';
+    }
+
+    return stream_.status() == QTextStream::Ok;
+}
+
+bool CSVAnalysisSink::finish()
+{
+    stream_.flush();
+    const bool isFlushed = (stream_.status() == QTextStream::Ok);
+    stream_.setDevice(0);
+
+    // close flushes the buffer of the file and sets its error
+    file_.close();
+
+    return isFlushed && (file_.error() == QFile::NoError);
+}
+
+QString CSVAnalysisSink::fileName() const
+{
+    return file_.fileName();
+}
@@ -0,0 +1,28 @@
+#ifndef CSVANALYSISSINK_H
+
+#define CSVANALYSISSINK_H
+
+#include "AbstractAnalysisSink.h"
+
+// Results written to a text file, a header line "id;<output ids>" and one
+// line "id;value;value..." per item, separated like the CSV point files.
+// The file name - writes to the standard output.
+class CSVAnalysisSink : public AbstractAnalysisSink
+{
+public:
+    CSVAnalysisSink(const QString &fileName);
+    ~CSVAnalysisSink();
+
+    bool begin(const IDAnalysisList &outputIDs);
+    bool write(const IDList &items, const QVector<double> &values);
+    bool finish();
+
+    QString fileName() const;
+
+private:
+    QFile file_;
+    QTextStream stream_;
+    int width_;
+};
+
+#endif // CSVANALYSISSINK_H
@@ -1,4 +1,5 @@
 #include "CSVPointListExporter.h"
+#include "Metrics.h"
 
 CSVPointListExporter::CSVPointListExporter(const QString &sourseDataBaseFile,
                                            const QString &sourseTableName,
@@ -9,12 +10,14 @@ CSVPointListExporter::CSVPointListExporter(const QString &sourseDataBaseFile,
 {
 }
 
-void CSVPointListExporter::exportFromDataBase()
+bool CSVPointListExporter::exportFromDataBase()
 {
+    METRICS_TIMER("csv/export");
+
     if(!QFile::exists(sourseDataBaseFile_))
     {
         qWarning() << sourseDataBaseFile_ << "not exists";
-        return;
+        return false;
     }
 
     SqlPointListReader reader(sourseDataBaseFile_, sourseTableName_);
@@ -22,13 +25,14 @@ void CSVPointListExporter::exportFromDataBase()
     if(!reader.open())
     {
         qWarning() << sourseDataBaseFile_ << "not open";
-        return;
+        return false;
     }
 
     QFile targetFile(targetFileName_);
     if(!targetFile.open(QFile::WriteOnly | QIODevice::Text))
     {
         qWarning() << targetFileName_ << "can't open for writing";
+        return false;
     }
 
     QTextStream targetFileStream(&targetFile);
@@ -53,6 +57,17 @@ void CSVPointListExporter::exportFromDataBase()
         }
     }
 
-    targetFile.flush();
+    targetFileStream.flush();
+    const bool isWritten = (targetFileStream.status() == QTextStream::Ok) && targetFile.flush();
     targetFile.close();
+
+    if(!isWritten)
+    {
+        qWarning() << targetFileName_ << "not written";
+        return false;
+    }
+
+    METRICS_COUNT("csv/exported sequences", idList.count());
+
+    return true;
 }
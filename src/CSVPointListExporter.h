@@ -11,7 +11,8 @@ public:
                          const QString &sourseTableName,
                          const QString &targetFileName);
 
-    void exportFromDataBase();
+    // false when the database can't be read or the file can't be written
+    bool exportFromDataBase();
 
 private:
     const QString sourseDataBaseFile_;
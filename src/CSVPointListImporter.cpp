@@ -1,4 +1,5 @@
 #include "CSVPointListImporter.h"
+#include "Metrics.h"
 
 
 CSVPointListImporter::CSVPointListImporter(const QString &sourceFileName,
@@ -13,6 +14,8 @@ CSVPointListImporter::CSVPointListImporter(const QString &sourceFileName,
 
 bool CSVPointListImporter::import()
 {
+    METRICS_TIMER("csv/import");
+
     CSVPointListValidator csvValidator;
 
     if(!csvValidator.validation(sourceFileName_))
@@ -77,6 +80,8 @@ bool CSVPointListImporter::import()
     file.flush();
     file.close();
 
+    METRICS_COUNT("csv/imported sequences", sequencePoint.count());
+
     SqlPointListWriter writer(targetFileName_, targetTableName_);
     if(!writer.open())
     {
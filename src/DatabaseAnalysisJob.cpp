@@ -0,0 +1,317 @@
+#include "DatabaseAnalysisJob.h"
+
+#include <QThread>
+
+#include "AnalysisEvaluator.h"
+
+const int DatabaseAnalysisJob::defaultRangeSize_ = 1024;
+const int DatabaseAnalysisJob::pendingPerWorker_ = 2;
+const int DatabaseAnalysisJob::busyTimeout_ = 30000;
+
+class DatabaseAnalysisWorker : public QThread
+{
+public:
+    DatabaseAnalysisWorker(DatabaseAnalysisJob *job, const int index) :
+        job_(job),
+        index_(index),
+        isSucceeded_(true)
+    {
+    }
+
+    bool isSucceeded() const
+    {
+        return isSucceeded_;
+    }
+
+protected:
+    void run()
+    {
+        analyze();
+        job_->finishWorker();
+    }
+
+private:
+    DatabaseAnalysisJob *job_;
+    const int index_;
+    bool isSucceeded_;
+
+    void analyze()
+    {
+        SqlPointListReader reader(job_->dataBaseName_, job_->tableName_);
+        reader.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+        reader.setBusyTimeout(DatabaseAnalysisJob::busyTimeout_);
+
+        if(!reader.open())
+        {
+            qWarning() << "can't open worker reader for" << job_->dataBaseName_;
+            isSucceeded_ = false;
+            return;
+        }
+
+        AnalysisEvaluator evaluator(*job_->collection_, &reader);
+
+        IDRange range;
+        IDList items;
+        QList< QVector<Point> > points;
+
+        while(!job_->isCancelled() && job_->takeRange(index_, &range))
+        {
+            if(!reader.readRange(range.first, range.last, &items, &points))
+            {
+                isSucceeded_ = false;
+                break;
+            }
+
+            AnalysisBatch batch(0, job_->collection_->outputCount());
+            for(int i = 0; i < items.count(); i++)
+            {
+                evaluator.evaluateValues(items.at(i), points.at(i), batch);
+            }
+            evaluator.flush(batch);
+
+            job_->queueResults(batch.items, batch.values);
+        }
+    }
+};
+
+DatabaseAnalysisJob::DatabaseAnalysisJob(const QString &dataBaseName, const QString &tableName, QObject *parent) :
+    QObject(parent),
+    dataBaseName_(dataBaseName),
+    tableName_(tableName),
+    workersCount_(qMax(1, QThread::idealThreadCount())),
+    rangeSize_(defaultRangeSize_),
+    collection_(0),
+    sink_(0),
+    rangesCount_(0),
+    processedRanges_(0),
+    stolen_(0),
+    runningWorkers_(0),
+    isWritten_(true)
+{
+}
+
+int DatabaseAnalysisJob::workersCount() const
+{
+    return workersCount_;
+}
+
+void DatabaseAnalysisJob::setWorkersCount(const int count)
+{
+    workersCount_ = qMax(1, count);
+}
+
+int DatabaseAnalysisJob::rangeSize() const
+{
+    return rangeSize_;
+}
+
+void DatabaseAnalysisJob::setRangeSize(const int items)
+{
+    rangeSize_ = qMax(1, items);
+}
+
+bool DatabaseAnalysisJob::run(const AnalysisCollection &collection, AbstractAnalysisSink *sink)
+{
+    IDRangeList ranges;
+    {
+        SqlPointListReader reader(dataBaseName_, tableName_);
+        reader.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+        reader.setBusyTimeout(busyTimeout_);
+
+        if(!reader.open())
+        {
+            qWarning() << "can't open database" << dataBaseName_;
+            return false;
+        }
+
+        ranges = partition(&reader, rangeSize_);
+    }
+
+    if(!sink->begin(collection.getOutputIDList()))
+    {
+        return false;
+    }
+
+    collection_ = &collection;
+    sink_ = sink;
+    processed_ = 0;
+    cancelled_ = 0;
+    isWritten_ = true;
+
+    // contiguous shares keep the scans of a worker close to each other
+    ranges_.clear();
+    for(int worker = 0; worker < workersCount_; worker++)
+    {
+        const int first = worker * ranges.count() / workersCount_;
+        const int last = (worker + 1) * ranges.count() / workersCount_;
+        ranges_.append(ranges.mid(first, last - first));
+    }
+    rangesCount_ = ranges.count();
+    processedRanges_ = 0;
+    stolen_ = 0;
+
+    pendingItems_.clear();
+    pendingValues_.clear();
+    runningWorkers_ = workersCount_;
+
+    QList<DatabaseAnalysisWorker*> workers;
+    for(int worker = 0; worker < workersCount_; worker++)
+    {
+        workers.append(new DatabaseAnalysisWorker(this, worker));
+        workers.last()->start();
+    }
+
+    writeQueuedResults();
+
+    bool isSucceeded = true;
+    foreach(DatabaseAnalysisWorker *worker, workers)
+    {
+        worker->wait();
+        isSucceeded = isSucceeded && worker->isSucceeded();
+        delete worker;
+    }
+
+    const bool isFinished = sink->finish();
+
+    collection_ = 0;
+    sink_ = 0;
+
+    return isSucceeded && isWritten_ && isFinished && !isCancelled();
+}
+
+void DatabaseAnalysisJob::cancel()
+{
+    cancelled_ = 1;
+}
+
+bool DatabaseAnalysisJob::isCancelled() const
+{
+    return cancelled_ != 0;
+}
+
+int DatabaseAnalysisJob::processedCount() const
+{
+    return processed_;
+}
+
+int DatabaseAnalysisJob::stolenCount() const
+{
+    return stolen_;
+}
+
+IDRangeList DatabaseAnalysisJob::partition(AbstractPointListReader *reader, const int rangeSize)
+{
+    IDRangeList ranges;
+    ID after;
+
+    forever
+    {
+        const IDList items = reader->readItems(after, rangeSize);
+        if(items.isEmpty())
+        {
+            break;
+        }
+
+        ranges.append(IDRange(items.first(), items.last()));
+        after = items.last();
+
+        if(items.count() < rangeSize)
+        {
+            break;
+        }
+    }
+
+    return ranges;
+}
+
+bool DatabaseAnalysisJob::takeRange(const int worker, IDRange *range)
+{
+    QMutexLocker locker(&rangesMutex_);
+
+    if(!ranges_[worker].isEmpty())
+    {
+        *range = ranges_[worker].takeFirst();
+        return true;
+    }
+
+    int victim = -1;
+    for(int i = 0; i < ranges_.count(); i++)
+    {
+        if(!ranges_.at(i).isEmpty() && ((victim < 0) || (ranges_.at(i).count() > ranges_.at(victim).count())))
+        {
+            victim = i;
+        }
+    }
+
+    if(victim < 0)
+    {
+        return false;
+    }
+
+    *range = ranges_[victim].takeLast();
+    stolen_++;
+
+    return true;
+}
+
+void DatabaseAnalysisJob::queueResults(const IDList &items, const QVector<double> &values)
+{
+    QMutexLocker locker(&resultsMutex_);
+
+    // the writing thread always drains the queue, also after a cancel
+    while(pendingItems_.count() >= pendingPerWorker_ * workersCount_)
+    {
+        resultsTaken_.wait(&resultsMutex_);
+    }
+
+    pendingItems_.append(items);
+    pendingValues_.append(values);
+
+    resultsQueued_.wakeOne();
+}
+
+void DatabaseAnalysisJob::finishWorker()
+{
+    QMutexLocker locker(&resultsMutex_);
+
+    runningWorkers_--;
+    resultsQueued_.wakeOne();
+}
+
+void DatabaseAnalysisJob::writeQueuedResults()
+{
+    QMutexLocker locker(&resultsMutex_);
+
+    forever
+    {
+        while(pendingItems_.isEmpty() && (runningWorkers_ > 0))
+        {
+            resultsQueued_.wait(&resultsMutex_);
+        }
+
+        if(pendingItems_.isEmpty())
+        {
+            break;
+        }
+
+        const IDList items = pendingItems_.takeFirst();
+        const QVector<double> values = pendingValues_.takeFirst();
+        resultsTaken_.wakeAll();
+
+        locker.unlock();
+
+        // after a failed write the remaining rows are dropped
+        if(isWritten_ && !sink_->write(items, values))
+        {
+            isWritten_ = false;
+            cancel();
+        }
+
+        processedRanges_++;
+        processed_.fetchAndAddOrdered(items.count());
+
+        emit progressChanged(processedRanges_, rangesCount_);
+
+        locker.relock();
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef DATABASEANALYSISJOB_H
+
+#define DATABASEANALYSISJOB_H
+
+#include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+
+#include "SqlPointListReader.h"
+#include "AnalysisCollection.h"
+#include "AbstractAnalysisSink.h"
+
+// Consecutive items from first to last in id order.
+class IDRange
+{
+public:
+    IDRange() {}
+    IDRange(const ID &first, const ID &last) : first(first), last(last) {}
+
+    ID first;
+    ID last;
+};
+
+typedef QList<IDRange> IDRangeList;
+
+// Analysis of every sequence of a database without keeping the results in
+// memory. The ids are split into ranges of rangeSize() items; every worker
+// owns a connection and a contiguous share of the ranges, reads a range
+// with one ordered scan and queues its rows; the thread that called run()
+// writes them to the sink, so the sink and its connection stay on one
+// thread. A worker that runs out of ranges steals the last range of the
+// worker with most left.
+class DatabaseAnalysisJob : public QObject
+{
+    Q_OBJECT
+
+    friend class DatabaseAnalysisWorker;
+
+public:
+    DatabaseAnalysisJob(const QString &dataBaseName, const QString &tableName, QObject *parent = 0);
+
+    int workersCount() const;
+    void setWorkersCount(const int count);
+
+    int rangeSize() const;
+    void setRangeSize(const int items);
+
+    // blocks until every range is analyzed or the job is cancelled
+    bool run(const AnalysisCollection &collection, AbstractAnalysisSink *sink);
+    void cancel();
+    bool isCancelled() const;
+
+    int processedCount() const;
+    int stolenCount() const;
+
+    static IDRangeList partition(AbstractPointListReader *reader, const int rangeSize);
+
+signals:
+    void progressChanged(const int processedRanges, const int totalRanges);
+
+private:
+    QString dataBaseName_;
+    QString tableName_;
+    int workersCount_;
+    int rangeSize_;
+
+    const AnalysisCollection *collection_;
+    AbstractAnalysisSink *sink_;
+
+    QMutex rangesMutex_;
+    QList<IDRangeList> ranges_;
+    int rangesCount_;
+    int processedRanges_;
+    int stolen_;
+
+    // analyzed ranges waiting for the sink, at most pendingPerWorker_ per worker
+    QMutex resultsMutex_;
+    QWaitCondition resultsQueued_;
+    QWaitCondition resultsTaken_;
+    QList<IDList> pendingItems_;
+    QList< QVector<double> > pendingValues_;
+    int runningWorkers_;
+
+    bool isWritten_;
+    QAtomicInt processed_;
+    QAtomicInt cancelled_;
+
+    static const int defaultRangeSize_;
+    static const int pendingPerWorker_;
+
+    // msecs the readers wait while the sink commits to the same database
+    static const int busyTimeout_;
+
+    bool takeRange(const int worker, IDRange *range);
+    void queueResults(const IDList &items, const QVector<double> &values);
+    void finishWorker();
+    void writeQueuedResults();
+};
+
+#endif // DATABASEANALYSISJOB_H
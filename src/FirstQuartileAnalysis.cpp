@@ -12,43 +12,27 @@ FirstQuartileAnalysis::FirstQuartileAnalysis(const FirstQuartileAnalysis &a):
 
 double FirstQuartileAnalysis::analyze(const PointList &values) const
 {
-    QList<Point> sortedList = values.points();
-    qSort(sortedList);
-    const int listCount = sortedList.count();
-
-    if(sortedList.isEmpty())
-    {
-        return 0.0;
-    }
-
-    if(listCount == 1)
+    if(ParallelPoints::isParallel(values.count()))
     {
-        return sortedList.first();
+        // the lower half includes the middle point of an odd sequence
+        const QVector<Point> points = values.toVector();
+        return ParallelPoints::rangeMedian(points, 0, (points.count() + 1) / 2);
     }
 
-    const bool even = (listCount % 2 == 0);
-    const int index = listCount / 2;
+    QVector<Point> sortedPoints = values.toVector();
+    qSort(sortedPoints);
 
-    PointList firstPart;
-
-    if(even)
-    {
-        for(int i = 0; i < index; i++)
-        {
-            firstPart.append(sortedList.at(i));
-        }
-    }
-    else
-    {
-        for(int i = 0; i < (index + 1); i++)
-        {
-            firstPart.append(sortedList.at(i));
-        }
-    }
+    return AnalysisIntermediates::sortedMedian(sortedPoints, 0, (sortedPoints.count() + 1) / 2);
+}
 
-    MedianAnalysis median;
+int FirstQuartileAnalysis::intermediates() const
+{
+    return AnalysisIntermediates::Sorted;
+}
 
-    return median.analyze(firstPart);
+void FirstQuartileAnalysis::analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const
+{
+    outputs[0] = intermediates.sortedMedian(0, (intermediates.count() + 1) / 2);
 }
 
 FirstQuartileAnalysis *FirstQuartileAnalysis::clone()
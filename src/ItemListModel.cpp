@@ -3,22 +3,40 @@
 ItemListModel::ItemListModel(AbstractPointListReader *reader,
                              QObject *parent):
     QAbstractListModel(parent),
-    reader_(reader)
+    reader_(reader),
+    pages_(reader)
 {
    update();
 }
 
+ItemListModel::ItemListModel(AbstractPointListReader *reader, const IDList &firstPage, QObject *parent):
+    QAbstractListModel(parent),
+    reader_(reader),
+    pages_(reader)
+{
+    pages_.reset(firstPage);
+}
+
 ItemListModel::ItemListModel(const IDList &items, QObject *parent):
-    QAbstractListModel(parent)
+    QAbstractListModel(parent),
+    reader_(0),
+    pages_(0)
 {
     appendPointList(items);
 }
 
 void ItemListModel::update()
 {
-    items_.clear();
-    items_ = reader_->readAllItems();
-    //appendPointList(reader_->readAllItems());
+    if(reader_ == 0)
+    {
+        return;
+    }
+
+    beginResetModel();
+
+    pages_.reset();
+
+    endResetModel();
 }
 
 QModelIndex ItemListModel::index(int row, int column, const QModelIndex &parent) const
@@ -33,7 +51,12 @@ QModelIndex ItemListModel::parent(const QModelIndex &child) const
 
 int ItemListModel::rowCount(const QModelIndex &parent) const
 {
-    return items_.count();
+    if(reader_ == 0)
+    {
+        return items_.count();
+    }
+
+    return pages_.rowCount();
 }
 
 int ItemListModel::columnCount(const QModelIndex &parent) const
@@ -54,7 +77,7 @@ QVariant ItemListModel::data(const QModelIndex &index, int role) const
         if(index.column() == 0)
         {
 
-            return items_[index.row()];
+            return itemAt(index.row());
 
         }
     }
@@ -66,6 +89,69 @@ QVariant ItemListModel::data(const QModelIndex &index, int role) const
     return QVariant();
 }
 
+bool ItemListModel::canFetchMore(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+    {
+        return false;
+    }
+
+    return (reader_ != 0) && !pages_.isFetched();
+}
+
+void ItemListModel::fetchMore(const QModelIndex &parent)
+{
+    if(!canFetchMore(parent))
+    {
+        return;
+    }
+
+    const int pageCount = pages_.nextPageCount();
+
+    if(pageCount == 0)
+    {
+        pages_.fetchPage();
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), pages_.rowCount(), pages_.rowCount() + pageCount - 1);
+    pages_.fetchPage();
+    endInsertRows();
+}
+
+int ItemListModel::pageSize() const
+{
+    return pages_.pageSize();
+}
+
+void ItemListModel::setPageSize(const int pageSize)
+{
+    if(pages_.setPageSize(pageSize))
+    {
+        update();
+    }
+}
+
+int ItemListModel::cachedPages() const
+{
+    return pages_.cachedPages();
+}
+
+void ItemListModel::setCachedPages(const int cachedPages)
+{
+    pages_.setCachedPages(cachedPages);
+}
+
+const ID &ItemListModel::itemAt(const int row) const
+{
+    if(reader_ == 0)
+    {
+        return items_.at(row);
+    }
+
+    return pages_.itemAt(row);
+}
+
 void ItemListModel::appendPointList_(const ID &id)
 {
     if(id.isNull())
@@ -73,9 +159,15 @@ void ItemListModel::appendPointList_(const ID &id)
         qWarning() << "ID not set";
     }
 
-    if(!items_.contains(id))
+    IDList::iterator position = qLowerBound(items_.begin(), items_.end(), id);
+
+    if((position == items_.end()) || (*position != id))
     {
-        items_.append(id);
+        const int row = position - items_.begin();
+
+        beginInsertRows(QModelIndex(), row, row);
+        items_.insert(row, id);
+        endInsertRows();
     }
     else
     {
@@ -85,15 +177,50 @@ void ItemListModel::appendPointList_(const ID &id)
 
 void ItemListModel::appendPointList(const ID &id)
 {
+    if(reader_ != 0)
+    {
+        qWarning() << "ItemListModel items are read from storage";
+        return;
+    }
+
     appendPointList_(id);
-    qSort(items_);
 }
 
 void ItemListModel::appendPointList(const IDList &items)
 {
-    foreach(const ID& id, items)
+    if(reader_ != 0)
+    {
+        qWarning() << "ItemListModel items are read from storage";
+        return;
+    }
+
+    IDList sortedItems = items;
+    qSort(sortedItems);
+
+    beginResetModel();
+
+    IDList mergedItems;
+    mergedItems.reserve(items_.count() + sortedItems.count());
+
+    int i = 0;
+    int j = 0;
+    while((i < items_.count()) || (j < sortedItems.count()))
     {
-        appendPointList_(id);
+        const bool takeExisting = (j == sortedItems.count())
+                || ((i < items_.count()) && !(sortedItems.at(j) < items_.at(i)));
+
+        const ID& id = takeExisting ? items_.at(i++) : sortedItems.at(j++);
+
+        if(!mergedItems.isEmpty() && (mergedItems.last() == id))
+        {
+            qWarning() << QString("ItemListModel contains ID: %1").arg(id);
+            continue;
+        }
+
+        mergedItems.append(id);
     }
-    qSort(items_);
+
+    items_ = mergedItems;
+
+    endResetModel();
 }
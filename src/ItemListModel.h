@@ -4,9 +4,10 @@
 
 #include <QAbstractListModel>
 
-#include "../mocs/MocPointListReader.h"
+#include "AbstractPointListReader.h"
 
 #include "AbstractAnalysis.h"
+#include "ItemPages.h"
 
 typedef QString ID;
 
@@ -19,6 +20,10 @@ public:
     ItemListModel(AbstractPointListReader *reader,
                   QObject *parent = 0);
 
+    // firstPage already read from the reader, e.g. by StorageLoader
+    ItemListModel(AbstractPointListReader *reader, const IDList &firstPage,
+                  QObject *parent = 0);
+
     QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
     QModelIndex parent(const QModelIndex &child) const;
 
@@ -26,6 +31,15 @@ public:
     int columnCount(const QModelIndex &parent  = QModelIndex()) const;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
 
+    bool canFetchMore(const QModelIndex &parent) const;
+    void fetchMore(const QModelIndex &parent);
+
+    int pageSize() const;
+    void setPageSize(const int pageSize);
+
+    int cachedPages() const;
+    void setCachedPages(const int cachedPages);
+
     void appendPointList(const ID& id);
     void appendPointList(const IDList &items);
 
@@ -36,6 +50,10 @@ private:
     IDList items_;
     AbstractPointListReader *reader_;
 
+    ItemPages pages_;
+
+    const ID& itemAt(const int row) const;
+
     void appendPointList_(const ID& id);
 
 public slots:
@@ -0,0 +1,132 @@
+#include "ItemPages.h"
+
+const int ItemPages::defaultPageSize_ = 1000;
+const int ItemPages::defaultCachedPages_ = 64;
+
+ItemPages::ItemPages(AbstractPointListReader *reader) :
+    reader_(reader),
+    pageSize_(defaultPageSize_),
+    rowCount_(0),
+    allFetched_(true),
+    pages_(defaultCachedPages_)
+{
+}
+
+void ItemPages::reset()
+{
+    clear();
+    fetchPage();
+}
+
+void ItemPages::reset(const IDList &firstPage)
+{
+    clear();
+
+    if(firstPage.count() <= pageSize_)
+    {
+        pages_.insert(0, new IDList(firstPage));
+    }
+
+    fetchPage();
+}
+
+int ItemPages::nextPageCount() const
+{
+    if(allFetched_)
+    {
+        return 0;
+    }
+
+    const IDList* nextPage = page(pagesAfter_.count() - 1);
+    return (nextPage != 0) ? nextPage->count() : 0;
+}
+
+void ItemPages::fetchPage()
+{
+    const IDList* items = page(pagesAfter_.count() - 1);
+
+    if((items == 0) || items->isEmpty())
+    {
+        allFetched_ = true;
+        return;
+    }
+
+    rowCount_ += items->count();
+
+    if(items->count() < pageSize_)
+    {
+        allFetched_ = true;
+    }
+    else
+    {
+        pagesAfter_.append(items->last());
+    }
+}
+
+const ID &ItemPages::itemAt(const int row) const
+{
+    const IDList* items = page(row / pageSize_);
+    const int indexInPage = row % pageSize_;
+
+    if((items == 0) || (indexInPage >= items->count()))
+    {
+        qWarning() << "Item at" << row << "not contains";
+        static const ID nullID;
+        return nullID;
+    }
+
+    return items->at(indexInPage);
+}
+
+int ItemPages::pageSize() const
+{
+    return pageSize_;
+}
+
+bool ItemPages::setPageSize(const int pageSize)
+{
+    if(pageSize < 1)
+    {
+        qWarning() << "Page size must be more than zero";
+        return false;
+    }
+
+    pageSize_ = pageSize;
+    return true;
+}
+
+int ItemPages::cachedPages() const
+{
+    return pages_.maxCost();
+}
+
+void ItemPages::setCachedPages(const int cachedPages)
+{
+    pages_.setMaxCost(qMax(1, cachedPages));
+}
+
+const IDList *ItemPages::page(const int pageIndex) const
+{
+    if((pageIndex < 0) || (pageIndex >= pagesAfter_.count()))
+    {
+        return 0;
+    }
+
+    IDList* items = pages_.object(pageIndex);
+    if(items == 0)
+    {
+        items = new IDList(reader_->readItems(pagesAfter_.at(pageIndex), pageSize_));
+        pages_.insert(pageIndex, items);
+    }
+
+    return items;
+}
+
+void ItemPages::clear()
+{
+    pages_.clear();
+    pagesAfter_.clear();
+    pagesAfter_.append(ID());
+    rowCount_ = 0;
+    allFetched_ = false;
+}
@@ -0,0 +1,52 @@
+#ifndef ITEMPAGES_H
+
+#define ITEMPAGES_H
+
+#include <QCache>
+
+#include "AbstractPointListReader.h"
+
+// Items of a reader read by pages of pageSize() items. Only the first item
+// key of every fetched page is kept, the pages are held in a cache of
+// cachedPages() pages and are read again after eviction.
+class ItemPages
+{
+public:
+    ItemPages(AbstractPointListReader *reader);
+
+    void reset();
+    // firstPage is taken as the first page when it was read with pageSize()
+    void reset(const IDList &firstPage);
+
+    inline int rowCount() const { return rowCount_;}
+    inline bool isFetched() const { return allFetched_;}
+
+    // items of the page fetchPage() appends, 0 when all items are fetched
+    int nextPageCount() const;
+    void fetchPage();
+
+    const ID& itemAt(const int row) const;
+
+    int pageSize() const;
+    bool setPageSize(const int pageSize);
+
+    int cachedPages() const;
+    void setCachedPages(const int cachedPages);
+
+private:
+    AbstractPointListReader *reader_;
+
+    int pageSize_;
+    int rowCount_;
+    bool allFetched_;
+    QVector<ID> pagesAfter_;
+    mutable QCache<int, IDList> pages_;
+
+    static const int defaultPageSize_;
+    static const int defaultCachedPages_;
+
+    const IDList* page(const int pageIndex) const;
+    void clear();
+};
+
+#endif // ITEMPAGES_H
@@ -13,31 +13,31 @@ MedianAnalysis::MedianAnalysis(const MedianAnalysis &a):
 
 double MedianAnalysis::analyze(const PointList &values) const
 {
-    QList<Point> sortedList = values.points();
-    qSort(sortedList);
-    const int listCount = sortedList.count();
-
-    if(sortedList.isEmpty())
+    if(ParallelPoints::isParallel(values.count()))
     {
-        return 0.0;
+        const QVector<Point> points = values.toVector();
+        return ParallelPoints::rangeMedian(points, 0, points.count());
     }
 
-    if(listCount == 1)
-    {
-        return sortedList.first();
-    }
+    QVector<Point> sortedPoints = values.toVector();
+    qSort(sortedPoints);
 
-    const bool even = (listCount % 2 == 0);
-    const int index = listCount / 2;
+    return AnalysisIntermediates::sortedMedian(sortedPoints, 0, sortedPoints.count());
+}
 
-    if(even)
-    {
-        return (sortedList.at(index) + sortedList.at(index-1)) / 2.0;
-    }
-    else
-    {
-        return sortedList.at(index);
-    }
+StorageAggregateList MedianAnalysis::storageAggregates() const
+{
+    return StorageAggregateList() << StorageAggregate::Median;
+}
+
+int MedianAnalysis::intermediates() const
+{
+    return AnalysisIntermediates::Sorted;
+}
+
+void MedianAnalysis::analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const
+{
+    outputs[0] = intermediates.sortedMedian(0, intermediates.count());
 }
 
 MedianAnalysis *MedianAnalysis::clone()
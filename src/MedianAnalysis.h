@@ -11,6 +11,9 @@ public:
     MedianAnalysis(const MedianAnalysis &a);
 
     double analyze(const PointList &values) const;
+    StorageAggregateList storageAggregates() const;
+    int intermediates() const;
+    void analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const;
     MedianAnalysis* clone();
 
 };
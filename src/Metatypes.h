@@ -4,7 +4,7 @@
 
 #include <QtCore>
 
-#include "AnalysisTableModel.h"
+#include "AnalysisResultMatrix.h"
 #include "PointListStorageStatistics.h"
 #include "StatisticsCollection.h"
 #include "CSVPointListImporter.h"
@@ -14,6 +14,7 @@ Q_DECLARE_METATYPE(PointList)
 Q_DECLARE_METATYPE(SequencePointList)
 Q_DECLARE_METATYPE(AnalysisResult)
 Q_DECLARE_METATYPE(AnalysisResults)
+Q_DECLARE_METATYPE(AnalysisBatch)
 Q_DECLARE_METATYPE(AnalysisList)
 Q_DECLARE_METATYPE(PointListStorageStatistics)
 Q_DECLARE_METATYPE(PointListStatistics)
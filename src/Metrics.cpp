@@ -0,0 +1,366 @@
+#include "Metrics.h"
+
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadStorage>
+#include <QAtomicInt>
+#include <QThread>
+#include <QVector>
+#include <QDebug>
+
+// Metric values of one thread, written only by the owner thread. The
+// sequence is odd while the owner writes, a reader copies the values until
+// it sees the same even sequence before and after the copy. Slots of an
+// older generation are cleared by a reset and count as zero.
+class MetricsThreadSlots
+{
+public:
+    MetricsThreadSlots(const int generation);
+    ~MetricsThreadSlots();
+
+    QAtomicInt sequence;
+    int generation;
+    // slots of a thread in the registry, not a copy or a sum
+    bool isRegistered;
+    qint64 counts[Metrics::capacity];
+    qint64 totals[Metrics::capacity];
+    qint64 maximums[Metrics::capacity];
+
+    void clear();
+    void beginWrite(const int currentGeneration);
+    void endWrite();
+    void copyTo(MetricsThreadSlots *copy) const;
+    void addTo(MetricsThreadSlots *sum, const QVector<MetricValue::Kind> &kinds) const;
+};
+
+class MetricsRegistry
+{
+public:
+    MetricsRegistry() :
+        generation(0),
+        gaugeStamp(0),
+        retired(0)
+    {
+    }
+
+    QMutex mutex;
+    QList<QByteArray> names;
+    QVector<MetricValue::Kind> kinds;
+    QList<MetricsThreadSlots*> threads;
+
+    QAtomicInt generation;
+    // order of the gauge updates, the slot with the latest one holds the value
+    QAtomicInt gaugeStamp;
+
+    // sum of the finished threads
+    MetricsThreadSlots retired;
+
+    QThreadStorage<MetricsThreadSlots*> local;
+};
+
+Q_GLOBAL_STATIC(MetricsRegistry, metricsRegistry)
+
+MetricsThreadSlots::MetricsThreadSlots(const int generation) :
+    sequence(0),
+    generation(generation),
+    isRegistered(false)
+{
+    clear();
+}
+
+MetricsThreadSlots::~MetricsThreadSlots()
+{
+    if(!isRegistered)
+    {
+        return;
+    }
+
+    MetricsRegistry *registry = metricsRegistry();
+    if(registry == 0)
+    {
+        return;
+    }
+
+    QMutexLocker locker(&registry->mutex);
+
+    registry->threads.removeAll(this);
+    if(generation == int(registry->generation))
+    {
+        addTo(&registry->retired, registry->kinds);
+    }
+}
+
+void MetricsThreadSlots::clear()
+{
+    for(int i = 0; i < Metrics::capacity; i++)
+    {
+        counts[i] = 0;
+        totals[i] = 0;
+        maximums[i] = 0;
+    }
+}
+
+void MetricsThreadSlots::beginWrite(const int currentGeneration)
+{
+    sequence.ref();
+
+    if(generation != currentGeneration)
+    {
+        clear();
+        generation = currentGeneration;
+    }
+}
+
+void MetricsThreadSlots::endWrite()
+{
+    sequence.ref();
+}
+
+void MetricsThreadSlots::copyTo(MetricsThreadSlots *copy) const
+{
+    MetricsThreadSlots &slots = const_cast<MetricsThreadSlots&>(*this);
+
+    forever
+    {
+        const int before = slots.sequence.fetchAndAddOrdered(0);
+        if(before % 2 == 0)
+        {
+            copy->generation = generation;
+            for(int i = 0; i < Metrics::capacity; i++)
+            {
+                copy->counts[i] = counts[i];
+                copy->totals[i] = totals[i];
+                copy->maximums[i] = maximums[i];
+            }
+
+            if(slots.sequence.fetchAndAddOrdered(0) == before)
+            {
+                return;
+            }
+        }
+
+        QThread::yieldCurrentThread();
+    }
+}
+
+void MetricsThreadSlots::addTo(MetricsThreadSlots *sum, const QVector<MetricValue::Kind> &kinds) const
+{
+    for(int i = 0; i < kinds.count(); i++)
+    {
+        if(kinds.at(i) == MetricValue::Gauge)
+        {
+            // the maximum holds the stamp of the last update
+            if(maximums[i] > sum->maximums[i])
+            {
+                sum->totals[i] = totals[i];
+                sum->maximums[i] = maximums[i];
+            }
+            continue;
+        }
+
+        sum->counts[i] += counts[i];
+        sum->totals[i] += totals[i];
+        sum->maximums[i] = qMax(sum->maximums[i], maximums[i]);
+    }
+}
+
+// slots of the calling thread, registered on first use; 0 after the registry is destroyed
+static MetricsThreadSlots* localSlots(MetricsRegistry *registry)
+{
+    if(registry == 0)
+    {
+        return 0;
+    }
+
+    if(!registry->local.hasLocalData())
+    {
+        MetricsThreadSlots *slots = new MetricsThreadSlots(registry->generation);
+        slots->isRegistered = true;
+
+        QMutexLocker locker(&registry->mutex);
+        registry->threads.append(slots);
+        locker.unlock();
+
+        registry->local.setLocalData(slots);
+    }
+
+    return registry->local.localData();
+}
+
+MetricValue::MetricValue() :
+    kind(Counter),
+    count(0),
+    total(0),
+    maximum(0)
+{
+}
+
+bool Metrics::isEnabled()
+{
+#ifdef METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+int Metrics::index(const char *name, const MetricValue::Kind kind)
+{
+    MetricsRegistry *registry = metricsRegistry();
+    if(registry == 0)
+    {
+        return -1;
+    }
+
+    QMutexLocker locker(&registry->mutex);
+
+    const int existing = registry->names.indexOf(QByteArray(name));
+    if(existing >= 0)
+    {
+        return existing;
+    }
+
+    if(registry->names.count() >= capacity)
+    {
+        qWarning() << "metrics registry is full, not recorded:" << name;
+        return -1;
+    }
+
+    registry->names.append(QByteArray(name));
+    registry->kinds.append(kind);
+
+    return registry->names.count() - 1;
+}
+
+void Metrics::add(const int index, const qint64 value)
+{
+    MetricsRegistry *registry = metricsRegistry();
+    MetricsThreadSlots *slots = localSlots(registry);
+    if((slots == 0) || (index < 0))
+    {
+        return;
+    }
+
+    slots->beginWrite(registry->generation);
+    slots->counts[index] += value;
+    slots->endWrite();
+}
+
+void Metrics::set(const int index, const qint64 value)
+{
+    MetricsRegistry *registry = metricsRegistry();
+    MetricsThreadSlots *slots = localSlots(registry);
+    if((slots == 0) || (index < 0))
+    {
+        return;
+    }
+
+    const int stamp = registry->gaugeStamp.fetchAndAddOrdered(1) + 1;
+
+    slots->beginWrite(registry->generation);
+    slots->counts[index] += 1;
+    slots->totals[index] = value;
+    slots->maximums[index] = stamp;
+    slots->endWrite();
+}
+
+void Metrics::record(const int index, const qint64 nanoseconds)
+{
+    MetricsRegistry *registry = metricsRegistry();
+    MetricsThreadSlots *slots = localSlots(registry);
+    if((slots == 0) || (index < 0))
+    {
+        return;
+    }
+
+    slots->beginWrite(registry->generation);
+    slots->counts[index] += 1;
+    slots->totals[index] += nanoseconds;
+    slots->maximums[index] = qMax(slots->maximums[index], nanoseconds);
+    slots->endWrite();
+}
+
+MetricValueList Metrics::snapshot()
+{
+    MetricsRegistry *registry = metricsRegistry();
+    if(registry == 0)
+    {
+        return MetricValueList();
+    }
+
+    QMutexLocker locker(&registry->mutex);
+
+    const int generation = registry->generation;
+
+    MetricsThreadSlots sum(generation);
+    registry->retired.addTo(&sum, registry->kinds);
+
+    MetricsThreadSlots copy(generation);
+    foreach(const MetricsThreadSlots *slots, registry->threads)
+    {
+        slots->copyTo(&copy);
+        if(copy.generation == generation)
+        {
+            copy.addTo(&sum, registry->kinds);
+        }
+    }
+
+    QMap<QString, MetricValue> values;
+    for(int i = 0; i < registry->names.count(); i++)
+    {
+        MetricValue value;
+        value.name = QString::fromLatin1(registry->names.at(i));
+        value.kind = registry->kinds.at(i);
+        value.count = sum.counts[i];
+        value.total = sum.totals[i];
+        value.maximum = (value.kind == MetricValue::Gauge) ? sum.totals[i] : sum.maximums[i];
+
+        values.insert(value.name, value);
+    }
+
+    return values.values();
+}
+
+void Metrics::reset()
+{
+    MetricsRegistry *registry = metricsRegistry();
+    if(registry == 0)
+    {
+        return;
+    }
+
+    QMutexLocker locker(&registry->mutex);
+
+    // every thread clears its own slots on its next write
+    registry->generation.ref();
+    registry->retired.clear();
+}
+
+QStringList Metrics::toString(const MetricValueList &values)
+{
+    QStringList lines;
+
+    foreach(const MetricValue &value, values)
+    {
+        switch(value.kind)
+        {
+        case MetricValue::Counter:
+            lines << QString("%1: %2").arg(value.name).arg(value.count);
+            break;
+        case MetricValue::Gauge:
+            lines << QString("%1: %2").arg(value.name).arg(value.total);
+            break;
+        case MetricValue::Timer:
+            lines << QString("%1: %2 calls, total %3 ms, mean %4 us, max %5 us")
+                     .arg(value.name)
+                     .arg(value.count)
+                     .arg(value.total / 1e6, 0, 'f', 3)
+                     .arg((value.count > 0) ? value.total / 1e3 / value.count : 0.0, 0, 'f', 1)
+                     .arg(value.maximum / 1e3, 0, 'f', 1);
+            break;
+        }
+    }
+
+    return lines;
+}
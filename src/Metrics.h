@@ -0,0 +1,111 @@
+#ifndef METRICS_H
+
+#define METRICS_H
+
+#include <QElapsedTimer>
+#include <QStringList>
+
+// Value of one metric over all threads. Counters sum the added values in
+// count; a gauge holds the last set value in total; timers count the
+// timed scopes with the sum of their nanoseconds in total and the longest
+// in maximum.
+class MetricValue
+{
+public:
+    enum Kind
+    {
+        Counter,
+        Gauge,
+        Timer
+    };
+
+    MetricValue();
+
+    QString name;
+    Kind kind;
+    qint64 count;
+    qint64 total;
+    qint64 maximum;
+};
+
+typedef QList<MetricValue> MetricValueList;
+
+// Process wide registry of hot path metrics. Every thread records into its
+// own slots without locks, guarded by a per-thread sequence counter so a
+// snapshot from another thread sums consistent values; slots of finished
+// threads are folded into the registry. Use the METRICS_* macros, they
+// expand to nothing unless built with CONFIG+=metrics.
+class Metrics
+{
+public:
+    // metrics a registry holds, further names aren't recorded
+    enum { capacity = 64 };
+
+    static bool isEnabled();
+
+    // index of the metric, registered on first use; -1 when the registry is full
+    static int index(const char *name, const MetricValue::Kind kind);
+
+    static void add(const int index, const qint64 value);
+    static void set(const int index, const qint64 value);
+    static void record(const int index, const qint64 nanoseconds);
+
+    // metrics sorted by name
+    static MetricValueList snapshot();
+    static void reset();
+
+    static QStringList toString(const MetricValueList &values);
+};
+
+// records the lifetime of the scope in a timer metric
+class MetricsTimer
+{
+public:
+    MetricsTimer(const int index) :
+        index_(index)
+    {
+        timer_.start();
+    }
+
+    ~MetricsTimer()
+    {
+        Metrics::record(index_, timer_.nsecsElapsed());
+    }
+
+private:
+    int index_;
+    QElapsedTimer timer_;
+};
+
+#define METRICS_CONCAT_(a, b) a##b
+#define METRICS_CONCAT(a, b) METRICS_CONCAT_(a, b)
+
+#ifdef METRICS
+
+// the index is looked up once per call site; a racing first call registers
+// the same name twice and gets the same index
+#define METRICS_COUNT(name, value) \
+    do { \
+        static const int metricsIndex = Metrics::index(name, MetricValue::Counter); \
+        Metrics::add(metricsIndex, (value)); \
+    } while(0)
+
+#define METRICS_GAUGE(name, value) \
+    do { \
+        static const int metricsIndex = Metrics::index(name, MetricValue::Gauge); \
+        Metrics::set(metricsIndex, (value)); \
+    } while(0)
+
+#define METRICS_TIMER(name) \
+    static const int METRICS_CONCAT(metricsTimerIndex, __LINE__) = Metrics::index(name, MetricValue::Timer); \
+    MetricsTimer METRICS_CONCAT(metricsTimer, __LINE__)(METRICS_CONCAT(metricsTimerIndex, __LINE__))
+
+#else
+
+#define METRICS_COUNT(name, value) do {} while(0)
+#define METRICS_GAUGE(name, value) do {} while(0)
+#define METRICS_TIMER(name)
+
+#endif
+
+#endif // METRICS_H
@@ -0,0 +1,53 @@
+#include "MetricsDialog.h"
+
+MetricsDialog::MetricsDialog(QWidget *parent) :
+    QDialog(parent)
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout;
+    QHBoxLayout* subLayout = new QHBoxLayout;
+
+    text_ = new QTextEdit;
+    text_->setReadOnly(true);
+    refreshButton_ = new QPushButton("Обновить");
+    resetButton_ = new QPushButton("Сбросить");
+    okButton_ = new QPushButton("OK");
+
+    refreshButton_->setEnabled(Metrics::isEnabled());
+    resetButton_->setEnabled(Metrics::isEnabled());
+
+    subLayout->addStretch();
+    subLayout->addWidget(refreshButton_);
+    subLayout->addWidget(resetButton_);
+    subLayout->addWidget(okButton_);
+    subLayout->addStretch();
+
+    mainLayout->addWidget(text_);
+    mainLayout->addLayout(subLayout);
+
+    this->setLayout(mainLayout);
+    this->setWindowTitle("Метрики");
+
+    connect(refreshButton_, SIGNAL(clicked()), this, SLOT(refresh()));
+    connect(resetButton_, SIGNAL(clicked()), this, SLOT(reset()));
+    connect(okButton_, SIGNAL(clicked()), this, SLOT(close()));
+
+    refresh();
+}
+
+void MetricsDialog::refresh()
+{
+    if(!Metrics::isEnabled())
+    {
+        text_->setPlainText("Метрики не собраны, соберите с CONFIG+=metrics");
+        return;
+    }
+
+    const QStringList lines = Metrics::toString(Metrics::snapshot());
+    text_->setPlainText(lines.isEmpty() ? QString("Нет данных") : lines.join("\n"));
+}
+
+void MetricsDialog::reset()
+{
+    Metrics::reset();
+    refresh();
+}
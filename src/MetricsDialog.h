@@ -0,0 +1,30 @@
+#ifndef METRICSDIALOG_H
+
+#define METRICSDIALOG_H
+
+#include <QDialog>
+#include <QPushButton>
+#include <QTextEdit>
+#include <QLayout>
+
+#include "Metrics.h"
+
+// Snapshot of the hot path metrics, refreshed on demand
+class MetricsDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    MetricsDialog(QWidget *parent = 0);
+
+private slots:
+    void refresh();
+    void reset();
+
+private:
+    QTextEdit* text_;
+    QPushButton* refreshButton_;
+    QPushButton* resetButton_;
+    QPushButton* okButton_;
+};
+
+#endif // METRICSDIALOG_H
@@ -0,0 +1,243 @@
+#include "ParallelPoints.h"
+
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <limits>
+
+int ParallelPoints::threshold_ = 1 << 20;
+int ParallelPoints::chunkSize_ = 1 << 18;
+
+class PointChunk
+{
+public:
+    PointChunk() :
+        values(0),
+        count(0),
+        low(0.0),
+        high(0.0),
+        compression(0.0)
+    {
+    }
+
+    const double *values;
+    int count;
+
+    double low;
+    double high;
+
+    double compression;
+};
+
+class PointRangeCount
+{
+public:
+    PointRangeCount() :
+        less(0),
+        greater(0)
+    {
+    }
+
+    qint64 less;
+    qint64 greater;
+    QVector<Point> inside;
+};
+
+static QList<PointChunk> pointChunks(const QVector<Point> &values, const int chunkSize)
+{
+    QList<PointChunk> chunks;
+
+    for(int first = 0; first < values.count(); first += chunkSize)
+    {
+        PointChunk chunk;
+        chunk.values = values.constData() + first;
+        chunk.count = qMin(chunkSize, values.count() - first);
+        chunks.append(chunk);
+    }
+
+    return chunks;
+}
+
+static PointAccumulator accumulateChunk(const PointChunk &chunk)
+{
+    return PointAccumulator::fromPoints(chunk.values, chunk.count);
+}
+
+static void mergeAccumulators(PointAccumulator &result, const PointAccumulator &chunk)
+{
+    result.merge(chunk);
+}
+
+static TDigest digestChunk(const PointChunk &chunk)
+{
+    return TDigest::fromPoints(chunk.values, chunk.count, chunk.compression);
+}
+
+static void mergeDigests(TDigest &result, const TDigest &chunk)
+{
+    // the reduce starts from a default digest, take the chunk compression
+    if(result.isEmpty())
+    {
+        result = chunk;
+        return;
+    }
+
+    result.merge(chunk);
+}
+
+static PointRangeCount countChunk(const PointChunk &chunk)
+{
+    PointRangeCount result;
+
+    for(int i = 0; i < chunk.count; i++)
+    {
+        const double value = chunk.values[i];
+
+        if(value < chunk.low)
+        {
+            result.less++;
+        }
+        else if(chunk.high < value)
+        {
+            result.greater++;
+        }
+        else
+        {
+            result.inside.append(value);
+        }
+    }
+
+    return result;
+}
+
+static void mergeRangeCounts(PointRangeCount &result, const PointRangeCount &chunk)
+{
+    result.less += chunk.less;
+    result.greater += chunk.greater;
+    result.inside << chunk.inside;
+}
+
+bool ParallelPoints::isParallel(const int pointsCount)
+{
+    return (threshold_ > 0) && (pointsCount >= threshold_) && (QThreadPool::globalInstance()->maxThreadCount() > 1);
+}
+
+int ParallelPoints::threshold()
+{
+    return threshold_;
+}
+
+void ParallelPoints::setThreshold(const int pointsCount)
+{
+    threshold_ = pointsCount;
+}
+
+int ParallelPoints::chunkSize()
+{
+    return chunkSize_;
+}
+
+void ParallelPoints::setChunkSize(const int pointsCount)
+{
+    chunkSize_ = qMax(1, pointsCount);
+}
+
+PointAccumulator ParallelPoints::accumulate(const QVector<Point> &values)
+{
+    // ordered reduce keeps the rounding of the result reproducible
+    return QtConcurrent::blockingMappedReduced(pointChunks(values, chunkSize_),
+                                               accumulateChunk,
+                                               mergeAccumulators,
+                                               QtConcurrent::OrderedReduce);
+}
+
+TDigest ParallelPoints::digest(const QVector<Point> &values, const double compression)
+{
+    QList<PointChunk> chunks = pointChunks(values, chunkSize_);
+    for(int i = 0; i < chunks.count(); i++)
+    {
+        chunks[i].compression = compression;
+    }
+
+    return QtConcurrent::blockingMappedReduced(chunks, digestChunk, mergeDigests);
+}
+
+QVector<Point> ParallelPoints::orderStatistics(const QVector<Point> &values, const QVector<int> &ranks)
+{
+    QVector<Point> result(ranks.count());
+    if(ranks.isEmpty())
+    {
+        return result;
+    }
+
+    const int firstRank = *std::min_element(ranks.constBegin(), ranks.constEnd());
+    const int lastRank = *std::max_element(ranks.constBegin(), ranks.constEnd());
+
+    // pivots around the ranks are taken from a sorted sample, so that
+    // the points between them are few and are selected serially
+    const int count = values.count();
+    const int sampleSize = qMin(count, 16384);
+
+    QVector<Point> sample(sampleSize);
+    for(int i = 0; i < sampleSize; i++)
+    {
+        sample[i] = values.at(int(qint64(i) * count / sampleSize));
+    }
+    qSort(sample);
+
+    const int margin = 2 * int(qSqrt(sampleSize)) + 1;
+    const int lowIndex = int(qint64(firstRank) * sampleSize / count) - margin;
+    const int highIndex = int(qint64(lastRank) * sampleSize / count) + margin;
+
+    QList<PointChunk> chunks = pointChunks(values, chunkSize_);
+    for(int i = 0; i < chunks.count(); i++)
+    {
+        chunks[i].low = (lowIndex <= 0) ? -std::numeric_limits<double>::infinity() : sample.at(lowIndex);
+        chunks[i].high = (highIndex >= sampleSize - 1) ? std::numeric_limits<double>::infinity() : sample.at(highIndex);
+    }
+
+    PointRangeCount range = QtConcurrent::blockingMappedReduced(chunks, countChunk, mergeRangeCounts);
+
+    const bool isInside = (range.less <= firstRank) && (lastRank < count - range.greater);
+
+    QVector<Point> selected;
+    qint64 offset = 0;
+
+    if(isInside)
+    {
+        selected = range.inside;
+        offset = range.less;
+    }
+    else
+    {
+        // the sample missed the ranks, select from every point
+        selected = values;
+    }
+
+    for(int i = 0; i < ranks.count(); i++)
+    {
+        Point *nth = selected.data() + int(ranks.at(i) - offset);
+        std::nth_element(selected.data(), nth, selected.data() + selected.count());
+        result[i] = *nth;
+    }
+
+    return result;
+}
+
+double ParallelPoints::rangeMedian(const QVector<Point> &values, const int first, const int count)
+{
+    if(count <= 0)
+    {
+        return 0.0;
+    }
+
+    const int middle = first + count / 2;
+
+    if(count % 2 != 0)
+    {
+        return orderStatistics(values, QVector<int>() << middle).first();
+    }
+
+    const QVector<Point> middles = orderStatistics(values, QVector<int>() << (middle - 1) << middle);
+    return (middles.at(0) + middles.at(1)) / 2.0;
+}
@@ -0,0 +1,35 @@
+#ifndef PARALLELPOINTS_H
+
+#define PARALLELPOINTS_H
+
+#include "PointAccumulator.h"
+#include "TDigest.h"
+
+// Chunked evaluation of one long sequence on QThreadPool::globalInstance().
+// Analyses switch to it for sequences of at least threshold() points.
+class ParallelPoints
+{
+public:
+    static bool isParallel(const int pointsCount);
+
+    static int threshold();
+    static void setThreshold(const int pointsCount);
+
+    static int chunkSize();
+    static void setChunkSize(const int pointsCount);
+
+    static PointAccumulator accumulate(const QVector<Point> &values);
+    static TDigest digest(const QVector<Point> &values, const double compression);
+
+    // points of the given ranks in the sorted sequence, ranks must be valid
+    static QVector<Point> orderStatistics(const QVector<Point> &values, const QVector<int> &ranks);
+
+    // median of the sorted points with ranks first .. first + count - 1
+    static double rangeMedian(const QVector<Point> &values, const int first, const int count);
+
+private:
+    static int threshold_;
+    static int chunkSize_;
+};
+
+#endif // PARALLELPOINTS_H
@@ -0,0 +1,211 @@
+#include "PercentileAnalysis.h"
+
+#include <algorithm>
+
+PercentileAnalysis::PercentileAnalysis() :
+    AbstractAnalysis(idForPercentiles(defaultPercentiles())),
+    percentiles_(defaultPercentiles())
+{
+}
+
+PercentileAnalysis::PercentileAnalysis(const QList<double> &percentiles) :
+    AbstractAnalysis(idForPercentiles(percentiles)),
+    percentiles_(percentiles)
+{
+}
+
+PercentileAnalysis::PercentileAnalysis(const PercentileAnalysis &a) :
+    AbstractAnalysis(idForPercentiles(a.percentiles_)),
+    percentiles_(a.percentiles_)
+{
+}
+
+double PercentileAnalysis::analyze(const PointList &values) const
+{
+    QVector<double> outputs(outputCount());
+    analyzeOutputs(values, outputs.data());
+
+    return outputs.first();
+}
+
+PercentileAnalysis *PercentileAnalysis::clone()
+{
+    return new PercentileAnalysis(*this);
+}
+
+int PercentileAnalysis::outputCount() const
+{
+    return percentiles_.count();
+}
+
+IDAnalysisList PercentileAnalysis::outputIDs() const
+{
+    IDAnalysisList ids;
+
+    foreach(const double percentile, percentiles_)
+    {
+        ids.append(idForPercentile(percentile));
+    }
+
+    return ids;
+}
+
+void PercentileAnalysis::analyzeOutputs(const PointList &values, double *outputs) const
+{
+    const QVector<Point> points = values.toVector();
+    const int count = points.count();
+
+    if(count == 0)
+    {
+        for(int i = 0; i < percentiles_.count(); i++)
+        {
+            outputs[i] = 0.0;
+        }
+        return;
+    }
+
+    // both neighbours of every percentile position are selected at once
+    QVector<int> ranks;
+    ranks.reserve(2 * percentiles_.count());
+
+    foreach(const double percentile, percentiles_)
+    {
+        const double position = (count - 1) * percentile / 100.0;
+        ranks << int(qFloor(position)) << int(qCeil(position));
+    }
+
+    qSort(ranks);
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+    const QVector<Point> selected = ParallelPoints::isParallel(count)
+            ? ParallelPoints::orderStatistics(points, ranks)
+            : orderStatistics(points, ranks);
+
+    for(int i = 0; i < percentiles_.count(); i++)
+    {
+        const double position = (count - 1) * percentiles_.at(i) / 100.0;
+        const int lowRank = int(qFloor(position));
+        const int highRank = int(qCeil(position));
+
+        const Point low = selected.at(int(qLowerBound(ranks, lowRank) - ranks.constBegin()));
+        const Point high = selected.at(int(qLowerBound(ranks, highRank) - ranks.constBegin()));
+
+        outputs[i] = low + (position - lowRank) * (high - low);
+    }
+}
+
+StorageAggregateList PercentileAnalysis::storageAggregates() const
+{
+    StorageAggregateList aggregates;
+
+    foreach(const double percentile, percentiles_)
+    {
+        aggregates << StorageAggregate(StorageAggregate::Quantile, percentile / 100.0);
+    }
+
+    return aggregates;
+}
+
+int PercentileAnalysis::intermediates() const
+{
+    return AnalysisIntermediates::Sorted;
+}
+
+void PercentileAnalysis::analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const
+{
+    const QVector<Point> &sorted = intermediates.sorted();
+    const int count = sorted.count();
+
+    for(int i = 0; i < percentiles_.count(); i++)
+    {
+        if(count == 0)
+        {
+            outputs[i] = 0.0;
+            continue;
+        }
+
+        const double position = (count - 1) * percentiles_.at(i) / 100.0;
+        const int lowRank = int(qFloor(position));
+        const int highRank = int(qCeil(position));
+
+        outputs[i] = sorted.at(lowRank) + (position - lowRank) * (sorted.at(highRank) - sorted.at(lowRank));
+    }
+}
+
+QList<double> PercentileAnalysis::defaultPercentiles()
+{
+    return QList<double>() << 1.0 << 5.0 << 25.0 << 50.0 << 75.0 << 95.0 << 99.0;
+}
+
+QVector<Point> PercentileAnalysis::orderStatistics(QVector<Point> values, const QVector<int> &ranks)
+{
+    QVector<Point> result(ranks.count());
+    if(ranks.isEmpty())
+    {
+        return result;
+    }
+
+    selectRanks(values.data(), values.data() + values.count(),
+                ranks.constData(), ranks.constData() + ranks.count() - 1, 0);
+
+    for(int i = 0; i < ranks.count(); i++)
+    {
+        result[i] = values.at(ranks.at(i));
+    }
+
+    return result;
+}
+
+void PercentileAnalysis::selectRanks(Point *begin, Point *end, const int *firstRank, const int *lastRank, const int offset)
+{
+    // the middle rank splits the points, the other ranks are selected
+    // only among the points on their side
+    if(firstRank > lastRank)
+    {
+        return;
+    }
+
+    const int *middleRank = firstRank + (lastRank - firstRank) / 2;
+    Point *nth = begin + (*middleRank - offset);
+
+    std::nth_element(begin, nth, end);
+
+    selectRanks(begin, nth, firstRank, middleRank - 1, offset);
+    selectRanks(nth + 1, end, middleRank + 1, lastRank, *middleRank + 1);
+}
+
+IDAnalysis PercentileAnalysis::idForPercentiles(const QList<double> &percentiles)
+{
+    if(percentiles.isEmpty())
+    {
+        qWarning() << "percentile list is empty";
+        return IDAnalysis();
+    }
+
+    QStringList ids;
+
+    foreach(const double percentile, percentiles)
+    {
+        if((percentile < 0.0) || (percentile > 100.0))
+        {
+            qWarning() << "percentile must be in [0, 100]:" << percentile;
+            return IDAnalysis();
+        }
+
+        const IDAnalysis id = idForPercentile(percentile);
+        if(ids.contains(id))
+        {
+            qWarning() << "percentile repeats:" << percentile;
+            return IDAnalysis();
+        }
+
+        ids << id;
+    }
+
+    return "percentiles-" + ids.join("-");
+}
+
+IDAnalysis PercentileAnalysis::idForPercentile(const double percentile)
+{
+    return QString("p%1").arg(percentile);
+}
@@ -0,0 +1,46 @@
+#ifndef PERCENTILEANALYSIS_H
+
+#define PERCENTILEANALYSIS_H
+
+#include "AbstractAnalysis.h"
+
+// Several percentiles of one sequence from a single selection pass, one
+// output per percentile with ids like p1, p50, p99. Percentiles between two
+// points are interpolated linearly, so p50 is the median.
+class PercentileAnalysis : public AbstractAnalysis
+{
+public:
+    PercentileAnalysis();
+    PercentileAnalysis(const QList<double> &percentiles);
+    PercentileAnalysis(const PercentileAnalysis &a);
+
+    // first percentile of the list
+    double analyze(const PointList &values) const;
+    PercentileAnalysis* clone();
+
+    int outputCount() const;
+    IDAnalysisList outputIDs() const;
+    void analyzeOutputs(const PointList &values, double *outputs) const;
+
+    StorageAggregateList storageAggregates() const;
+
+    int intermediates() const;
+    void analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const;
+
+    inline const QList<double>& percentiles() const { return percentiles_;}
+
+    static QList<double> defaultPercentiles();
+
+    // points of the given ranks in the sorted sequence, ranks must be sorted and unique
+    static QVector<Point> orderStatistics(QVector<Point> values, const QVector<int> &ranks);
+
+private:
+    QList<double> percentiles_;
+
+    static IDAnalysis idForPercentiles(const QList<double> &percentiles);
+    static IDAnalysis idForPercentile(const double percentile);
+
+    static void selectRanks(Point *begin, Point *end, const int *firstRank, const int *lastRank, const int offset);
+};
+
+#endif // PERCENTILEANALYSIS_H
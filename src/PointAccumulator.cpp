@@ -0,0 +1,136 @@
+#include "PointAccumulator.h"
+
+PointAccumulator::PointAccumulator() :
+    count_(0),
+    nonZero_(0),
+    sum_(0.0),
+    mean_(0.0),
+    m2_(0.0),
+    minimum_(0.0),
+    maximum_(0.0)
+{
+}
+
+PointAccumulator PointAccumulator::fromPoints(const double *values, const int count)
+{
+    PointAccumulator accumulator;
+
+    if(count <= 0)
+    {
+        return accumulator;
+    }
+
+    accumulator.count_ = count;
+    accumulator.nonZero_ = PointKernels::countNonZero(values, count);
+    accumulator.sum_ = PointKernels::sum(values, count);
+    accumulator.mean_ = accumulator.sum_ / static_cast<double>(count);
+    accumulator.m2_ = PointKernels::sumOfSquares(values, count, accumulator.mean_);
+    PointKernels::minMax(values, count, &accumulator.minimum_, &accumulator.maximum_);
+
+    return accumulator;
+}
+
+void PointAccumulator::add(const double value)
+{
+    if(count_ == 0)
+    {
+        minimum_ = value;
+        maximum_ = value;
+    }
+    else
+    {
+        minimum_ = qMin(minimum_, value);
+        maximum_ = qMax(maximum_, value);
+    }
+
+    // Welford update
+    count_++;
+    sum_ += value;
+
+    const double delta = value - mean_;
+    mean_ += delta / static_cast<double>(count_);
+    m2_ += delta * (value - mean_);
+
+    if(value != 0.0)
+    {
+        nonZero_++;
+    }
+}
+
+void PointAccumulator::merge(const PointAccumulator &other)
+{
+    if(other.isEmpty())
+    {
+        return;
+    }
+
+    if(isEmpty())
+    {
+        *this = other;
+        return;
+    }
+
+    const double count = static_cast<double>(count_ + other.count_);
+    const double delta = other.mean_ - mean_;
+
+    mean_ += delta * (static_cast<double>(other.count_) / count);
+    m2_ += other.m2_ + delta * delta * (static_cast<double>(count_) * static_cast<double>(other.count_) / count);
+
+    count_ += other.count_;
+    nonZero_ += other.nonZero_;
+    sum_ += other.sum_;
+    minimum_ = qMin(minimum_, other.minimum_);
+    maximum_ = qMax(maximum_, other.maximum_);
+}
+
+double PointAccumulator::average() const
+{
+    return mean_;
+}
+
+double PointAccumulator::averageIgnoreNull() const
+{
+    if(nonZero_ == 0)
+    {
+        return 0.0;
+    }
+
+    return sum_ / static_cast<double>(nonZero_);
+}
+
+double PointAccumulator::variance() const
+{
+    if(count_ < 2)
+    {
+        return 0.0;
+    }
+
+    return m2_ / (static_cast<double>(count_) - 1.0);
+}
+
+double PointAccumulator::standardDeviation() const
+{
+    return qSqrt(variance());
+}
+
+QDataStream &operator<<(QDataStream &stream, const PointAccumulator &accumulator)
+{
+    return stream << accumulator.count_
+                  << accumulator.nonZero_
+                  << accumulator.sum_
+                  << accumulator.mean_
+                  << accumulator.m2_
+                  << accumulator.minimum_
+                  << accumulator.maximum_;
+}
+
+QDataStream &operator>>(QDataStream &stream, PointAccumulator &accumulator)
+{
+    return stream >> accumulator.count_
+                  >> accumulator.nonZero_
+                  >> accumulator.sum_
+                  >> accumulator.mean_
+                  >> accumulator.m2_
+                  >> accumulator.minimum_
+                  >> accumulator.maximum_;
+}
@@ -0,0 +1,51 @@
+#ifndef POINTACCUMULATOR_H
+
+#define POINTACCUMULATOR_H
+
+#include "PointKernels.h"
+
+// Count, mean, squared deviations, min/max and non-zero count of a part of
+// a sequence. Accumulators of different parts are merged with the pairwise
+// formula of Chan et al., so parts can be accumulated in any order and on
+// different threads.
+class PointAccumulator
+{
+public:
+    PointAccumulator();
+
+    static PointAccumulator fromPoints(const double *values, const int count);
+
+    void add(const double value);
+    void merge(const PointAccumulator &other);
+
+    inline qint64 count() const { return count_;}
+    inline bool isEmpty() const { return count_ == 0;}
+
+    inline double sum() const { return sum_;}
+    inline double mean() const { return mean_;}
+    inline double minimum() const { return minimum_;}
+    inline double maximum() const { return maximum_;}
+    inline qint64 nonZeroCount() const { return nonZero_;}
+
+    double average() const;
+    double averageIgnoreNull() const;
+    double variance() const;
+    double standardDeviation() const;
+
+private:
+    qint64 count_;
+    qint64 nonZero_;
+    double sum_;
+    double mean_;
+    double m2_;
+    double minimum_;
+    double maximum_;
+
+    friend QDataStream &operator<<(QDataStream &stream, const PointAccumulator &accumulator);
+    friend QDataStream &operator>>(QDataStream &stream, PointAccumulator &accumulator);
+};
+
+QDataStream &operator<<(QDataStream &stream, const PointAccumulator &accumulator);
+QDataStream &operator>>(QDataStream &stream, PointAccumulator &accumulator);
+
+#endif // POINTACCUMULATOR_H
@@ -0,0 +1,670 @@
+#include "PointKernels.h"
+
+#if POINTKERNELS_COMPILER && (defined(__x86_64__) || defined(__i386__))
+#define POINTKERNELS_X86
+#include <immintrin.h>
+#define POINTKERNELS_TARGET(instructions) __attribute__((target(instructions)))
+#endif
+
+class PointKernelTable
+{
+public:
+    double (*sum)(const double *values, const int count);
+    double (*sumOfSquares)(const double *values, const int count, const double center);
+    void (*minMax)(const double *values, const int count, double *min, double *max);
+    int (*countNonZero)(const double *values, const int count);
+    int (*countEqual)(const double *values, const int count, const double value);
+};
+
+static double sumScalar(const double *values, const int count)
+{
+    double sums[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+    int i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        sums[0] += values[i];
+        sums[1] += values[i + 1];
+        sums[2] += values[i + 2];
+        sums[3] += values[i + 3];
+    }
+
+    for(; i < count; i++)
+    {
+        sums[0] += values[i];
+    }
+
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+static double sumOfSquaresScalar(const double *values, const int count, const double center)
+{
+    double sums[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+    int i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        for(int j = 0; j < 4; j++)
+        {
+            const double delta = values[i + j] - center;
+            sums[j] += delta * delta;
+        }
+    }
+
+    for(; i < count; i++)
+    {
+        const double delta = values[i] - center;
+        sums[0] += delta * delta;
+    }
+
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+static void minMaxScalar(const double *values, const int count, double *min, double *max)
+{
+    double minValue = values[0];
+    double maxValue = values[0];
+
+    for(int i = 1; i < count; i++)
+    {
+        minValue = (values[i] < minValue) ? values[i] : minValue;
+        maxValue = (maxValue < values[i]) ? values[i] : maxValue;
+    }
+
+    *min = minValue;
+    *max = maxValue;
+}
+
+static int countNonZeroScalar(const double *values, const int count)
+{
+    int result = 0;
+    for(int i = 0; i < count; i++)
+    {
+        result += (values[i] != 0.0) ? 1 : 0;
+    }
+    return result;
+}
+
+static int countEqualScalar(const double *values, const int count, const double value)
+{
+    int result = 0;
+    for(int i = 0; i < count; i++)
+    {
+        result += (values[i] == value) ? 1 : 0;
+    }
+    return result;
+}
+
+#ifdef POINTKERNELS_X86
+
+POINTKERNELS_TARGET("sse2")
+static double horizontalSumSSE2(const __m128d sum)
+{
+    double sums[2];
+    _mm_storeu_pd(sums, sum);
+    return sums[0] + sums[1];
+}
+
+POINTKERNELS_TARGET("sse2")
+static double sumSSE2(const double *values, const int count)
+{
+    __m128d sum0 = _mm_setzero_pd();
+    __m128d sum1 = _mm_setzero_pd();
+
+    int i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        sum0 = _mm_add_pd(sum0, _mm_loadu_pd(values + i));
+        sum1 = _mm_add_pd(sum1, _mm_loadu_pd(values + i + 2));
+    }
+
+    double result = horizontalSumSSE2(_mm_add_pd(sum0, sum1));
+    for(; i < count; i++)
+    {
+        result += values[i];
+    }
+    return result;
+}
+
+POINTKERNELS_TARGET("sse2")
+static double sumOfSquaresSSE2(const double *values, const int count, const double center)
+{
+    const __m128d centers = _mm_set1_pd(center);
+    __m128d sum0 = _mm_setzero_pd();
+    __m128d sum1 = _mm_setzero_pd();
+
+    int i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        const __m128d delta0 = _mm_sub_pd(_mm_loadu_pd(values + i), centers);
+        const __m128d delta1 = _mm_sub_pd(_mm_loadu_pd(values + i + 2), centers);
+        sum0 = _mm_add_pd(sum0, _mm_mul_pd(delta0, delta0));
+        sum1 = _mm_add_pd(sum1, _mm_mul_pd(delta1, delta1));
+    }
+
+    double result = horizontalSumSSE2(_mm_add_pd(sum0, sum1));
+    for(; i < count; i++)
+    {
+        const double delta = values[i] - center;
+        result += delta * delta;
+    }
+    return result;
+}
+
+POINTKERNELS_TARGET("sse2")
+static void minMaxSSE2(const double *values, const int count, double *min, double *max)
+{
+    if(count < 2)
+    {
+        minMaxScalar(values, count, min, max);
+        return;
+    }
+
+    __m128d minValues = _mm_loadu_pd(values);
+    __m128d maxValues = minValues;
+
+    int i = 2;
+    for(; i + 2 <= count; i += 2)
+    {
+        const __m128d block = _mm_loadu_pd(values + i);
+        minValues = _mm_min_pd(minValues, block);
+        maxValues = _mm_max_pd(maxValues, block);
+    }
+
+    double mins[2];
+    double maxs[2];
+    _mm_storeu_pd(mins, minValues);
+    _mm_storeu_pd(maxs, maxValues);
+
+    double minValue = qMin(mins[0], mins[1]);
+    double maxValue = qMax(maxs[0], maxs[1]);
+    for(; i < count; i++)
+    {
+        minValue = qMin(minValue, values[i]);
+        maxValue = qMax(maxValue, values[i]);
+    }
+
+    *min = minValue;
+    *max = maxValue;
+}
+
+POINTKERNELS_TARGET("sse2")
+static int countNonZeroSSE2(const double *values, const int count)
+{
+    const __m128d zeros = _mm_setzero_pd();
+    __m128i counts = _mm_setzero_si128();
+
+    int i = 0;
+    for(; i + 2 <= count; i += 2)
+    {
+        // the mask is -1 for every matching lane
+        const __m128d mask = _mm_cmpneq_pd(_mm_loadu_pd(values + i), zeros);
+        counts = _mm_sub_epi64(counts, _mm_castpd_si128(mask));
+    }
+
+    qint64 lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), counts);
+
+    int result = int(lanes[0] + lanes[1]);
+    for(; i < count; i++)
+    {
+        result += (values[i] != 0.0) ? 1 : 0;
+    }
+    return result;
+}
+
+POINTKERNELS_TARGET("sse2")
+static int countEqualSSE2(const double *values, const int count, const double value)
+{
+    const __m128d expected = _mm_set1_pd(value);
+    __m128i counts = _mm_setzero_si128();
+
+    int i = 0;
+    for(; i + 2 <= count; i += 2)
+    {
+        const __m128d mask = _mm_cmpeq_pd(_mm_loadu_pd(values + i), expected);
+        counts = _mm_sub_epi64(counts, _mm_castpd_si128(mask));
+    }
+
+    qint64 lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), counts);
+
+    int result = int(lanes[0] + lanes[1]);
+    for(; i < count; i++)
+    {
+        result += (values[i] == value) ? 1 : 0;
+    }
+    return result;
+}
+
+POINTKERNELS_TARGET("avx2")
+static double horizontalSumAVX2(const __m256d sum)
+{
+    const __m128d halves = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+    double sums[2];
+    _mm_storeu_pd(sums, halves);
+    return sums[0] + sums[1];
+}
+
+POINTKERNELS_TARGET("avx2")
+static double sumAVX2(const double *values, const int count)
+{
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d sum1 = _mm256_setzero_pd();
+
+    int i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        sum0 = _mm256_add_pd(sum0, _mm256_loadu_pd(values + i));
+        sum1 = _mm256_add_pd(sum1, _mm256_loadu_pd(values + i + 4));
+    }
+
+    double result = horizontalSumAVX2(_mm256_add_pd(sum0, sum1));
+    for(; i < count; i++)
+    {
+        result += values[i];
+    }
+    return result;
+}
+
+POINTKERNELS_TARGET("avx2")
+static double sumOfSquaresAVX2(const double *values, const int count, const double center)
+{
+    const __m256d centers = _mm256_set1_pd(center);
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d sum1 = _mm256_setzero_pd();
+
+    int i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        const __m256d delta0 = _mm256_sub_pd(_mm256_loadu_pd(values + i), centers);
+        const __m256d delta1 = _mm256_sub_pd(_mm256_loadu_pd(values + i + 4), centers);
+        sum0 = _mm256_add_pd(sum0, _mm256_mul_pd(delta0, delta0));
+        sum1 = _mm256_add_pd(sum1, _mm256_mul_pd(delta1, delta1));
+    }
+
+    double result = horizontalSumAVX2(_mm256_add_pd(sum0, sum1));
+    for(; i < count; i++)
+    {
+        const double delta = values[i] - center;
+        result += delta * delta;
+    }
+    return result;
+}
+
+POINTKERNELS_TARGET("avx2")
+static void minMaxAVX2(const double *values, const int count, double *min, double *max)
+{
+    if(count < 4)
+    {
+        minMaxScalar(values, count, min, max);
+        return;
+    }
+
+    __m256d minValues = _mm256_loadu_pd(values);
+    __m256d maxValues = minValues;
+
+    int i = 4;
+    for(; i + 4 <= count; i += 4)
+    {
+        const __m256d block = _mm256_loadu_pd(values + i);
+        minValues = _mm256_min_pd(minValues, block);
+        maxValues = _mm256_max_pd(maxValues, block);
+    }
+
+    double mins[4];
+    double maxs[4];
+    _mm256_storeu_pd(mins, minValues);
+    _mm256_storeu_pd(maxs, maxValues);
+
+    double minValue = qMin(qMin(mins[0], mins[1]), qMin(mins[2], mins[3]));
+    double maxValue = qMax(qMax(maxs[0], maxs[1]), qMax(maxs[2], maxs[3]));
+    for(; i < count; i++)
+    {
+        minValue = qMin(minValue, values[i]);
+        maxValue = qMax(maxValue, values[i]);
+    }
+
+    *min = minValue;
+    *max = maxValue;
+}
+
+POINTKERNELS_TARGET("avx2,popcnt")
+static int countNonZeroAVX2(const double *values, const int count)
+{
+    const __m256d zeros = _mm256_setzero_pd();
+    int result = 0;
+
+    int i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        const __m256d mask = _mm256_cmp_pd(_mm256_loadu_pd(values + i), zeros, _CMP_NEQ_UQ);
+        result += _mm_popcnt_u32(unsigned(_mm256_movemask_pd(mask)));
+    }
+
+    for(; i < count; i++)
+    {
+        result += (values[i] != 0.0) ? 1 : 0;
+    }
+    return result;
+}
+
+POINTKERNELS_TARGET("avx2,popcnt")
+static int countEqualAVX2(const double *values, const int count, const double value)
+{
+    const __m256d expected = _mm256_set1_pd(value);
+    int result = 0;
+
+    int i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        const __m256d mask = _mm256_cmp_pd(_mm256_loadu_pd(values + i), expected, _CMP_EQ_OQ);
+        result += _mm_popcnt_u32(unsigned(_mm256_movemask_pd(mask)));
+    }
+
+    for(; i < count; i++)
+    {
+        result += (values[i] == value) ? 1 : 0;
+    }
+    return result;
+}
+
+POINTKERNELS_TARGET("avx512f")
+static double horizontalSumAVX512(const __m512d sum)
+{
+    double sums[8];
+    _mm512_storeu_pd(sums, sum);
+    return ((sums[0] + sums[1]) + (sums[2] + sums[3])) + ((sums[4] + sums[5]) + (sums[6] + sums[7]));
+}
+
+POINTKERNELS_TARGET("avx512f")
+static double sumAVX512(const double *values, const int count)
+{
+    __m512d sum0 = _mm512_setzero_pd();
+    __m512d sum1 = _mm512_setzero_pd();
+
+    int i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        sum0 = _mm512_add_pd(sum0, _mm512_loadu_pd(values + i));
+        sum1 = _mm512_add_pd(sum1, _mm512_loadu_pd(values + i + 8));
+    }
+
+    if(i < count)
+    {
+        // the tail is loaded through a mask, masked lanes are zero
+        const __mmask8 mask = __mmask8((1u << qMin(8, count - i)) - 1u);
+        sum0 = _mm512_add_pd(sum0, _mm512_maskz_loadu_pd(mask, values + i));
+        i += qMin(8, count - i);
+    }
+
+    if(i < count)
+    {
+        const __mmask8 mask = __mmask8((1u << (count - i)) - 1u);
+        sum1 = _mm512_add_pd(sum1, _mm512_maskz_loadu_pd(mask, values + i));
+    }
+
+    return horizontalSumAVX512(_mm512_add_pd(sum0, sum1));
+}
+
+POINTKERNELS_TARGET("avx512f")
+static double sumOfSquaresAVX512(const double *values, const int count, const double center)
+{
+    const __m512d centers = _mm512_set1_pd(center);
+    __m512d sum = _mm512_setzero_pd();
+
+    int i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        const __m512d delta = _mm512_sub_pd(_mm512_loadu_pd(values + i), centers);
+        sum = _mm512_fmadd_pd(delta, delta, sum);
+    }
+
+    if(i < count)
+    {
+        const __mmask8 mask = __mmask8((1u << (count - i)) - 1u);
+        const __m512d delta = _mm512_maskz_sub_pd(mask, _mm512_maskz_loadu_pd(mask, values + i), centers);
+        sum = _mm512_fmadd_pd(delta, delta, sum);
+    }
+
+    return horizontalSumAVX512(sum);
+}
+
+POINTKERNELS_TARGET("avx512f")
+static void minMaxAVX512(const double *values, const int count, double *min, double *max)
+{
+    if(count < 8)
+    {
+        minMaxScalar(values, count, min, max);
+        return;
+    }
+
+    __m512d minValues = _mm512_loadu_pd(values);
+    __m512d maxValues = minValues;
+
+    int i = 8;
+    for(; i + 8 <= count; i += 8)
+    {
+        const __m512d block = _mm512_loadu_pd(values + i);
+        minValues = _mm512_min_pd(minValues, block);
+        maxValues = _mm512_max_pd(maxValues, block);
+    }
+
+    if(i < count)
+    {
+        // the last full block overlaps already seen points, which does not change min or max
+        const __m512d block = _mm512_loadu_pd(values + count - 8);
+        minValues = _mm512_min_pd(minValues, block);
+        maxValues = _mm512_max_pd(maxValues, block);
+    }
+
+    double mins[8];
+    double maxs[8];
+    _mm512_storeu_pd(mins, minValues);
+    _mm512_storeu_pd(maxs, maxValues);
+
+    double minValue = mins[0];
+    double maxValue = maxs[0];
+    for(int lane = 1; lane < 8; lane++)
+    {
+        minValue = qMin(minValue, mins[lane]);
+        maxValue = qMax(maxValue, maxs[lane]);
+    }
+
+    *min = minValue;
+    *max = maxValue;
+}
+
+POINTKERNELS_TARGET("avx512f,popcnt")
+static int countNonZeroAVX512(const double *values, const int count)
+{
+    const __m512d zeros = _mm512_setzero_pd();
+    int result = 0;
+
+    int i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        const __mmask8 mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(values + i), zeros, _CMP_NEQ_UQ);
+        result += _mm_popcnt_u32(unsigned(mask));
+    }
+
+    for(; i < count; i++)
+    {
+        result += (values[i] != 0.0) ? 1 : 0;
+    }
+    return result;
+}
+
+POINTKERNELS_TARGET("avx512f,popcnt")
+static int countEqualAVX512(const double *values, const int count, const double value)
+{
+    const __m512d expected = _mm512_set1_pd(value);
+    int result = 0;
+
+    int i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        const __mmask8 mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(values + i), expected, _CMP_EQ_OQ);
+        result += _mm_popcnt_u32(unsigned(mask));
+    }
+
+    for(; i < count; i++)
+    {
+        result += (values[i] == value) ? 1 : 0;
+    }
+    return result;
+}
+
+#endif // POINTKERNELS_X86
+
+static PointKernelTable pointKernelTable(const PointKernels::Instructions instructions)
+{
+    PointKernelTable table;
+
+    table.sum = sumScalar;
+    table.sumOfSquares = sumOfSquaresScalar;
+    table.minMax = minMaxScalar;
+    table.countNonZero = countNonZeroScalar;
+    table.countEqual = countEqualScalar;
+
+#ifdef POINTKERNELS_X86
+    switch(instructions)
+    {
+    case PointKernels::SSE2:
+        table.sum = sumSSE2;
+        table.sumOfSquares = sumOfSquaresSSE2;
+        table.minMax = minMaxSSE2;
+        table.countNonZero = countNonZeroSSE2;
+        table.countEqual = countEqualSSE2;
+        break;
+
+    case PointKernels::AVX2:
+        table.sum = sumAVX2;
+        table.sumOfSquares = sumOfSquaresAVX2;
+        table.minMax = minMaxAVX2;
+        table.countNonZero = countNonZeroAVX2;
+        table.countEqual = countEqualAVX2;
+        break;
+
+    case PointKernels::AVX512:
+        table.sum = sumAVX512;
+        table.sumOfSquares = sumOfSquaresAVX512;
+        table.minMax = minMaxAVX512;
+        table.countNonZero = countNonZeroAVX512;
+        table.countEqual = countEqualAVX512;
+        break;
+
+    case PointKernels::Scalar:
+        break;
+    }
+#endif
+
+    return table;
+}
+
+static PointKernels::Instructions detectInstructions()
+{
+#ifdef POINTKERNELS_X86
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("popcnt"))
+    {
+        return PointKernels::AVX512;
+    }
+
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+    {
+        return PointKernels::AVX2;
+    }
+
+    if(__builtin_cpu_supports("sse2"))
+    {
+        return PointKernels::SSE2;
+    }
+#endif
+
+    return PointKernels::Scalar;
+}
+
+static const PointKernels::Instructions supportedInstructions_ = detectInstructions();
+
+// one table per instruction set, indexed by PointKernels::Instructions
+static const PointKernelTable kernelTables_[] =
+{
+    pointKernelTable(PointKernels::Scalar),
+    pointKernelTable(PointKernels::SSE2),
+    pointKernelTable(PointKernels::AVX2),
+    pointKernelTable(PointKernels::AVX512)
+};
+
+static QAtomicInt instructions_(supportedInstructions_);
+static QAtomicPointer<const PointKernelTable> kernels_(&kernelTables_[supportedInstructions_]);
+
+double PointKernels::sum(const double *values, const int count)
+{
+    return kernels_->sum(values, count);
+}
+
+double PointKernels::sumOfSquares(const double *values, const int count, const double center)
+{
+    return kernels_->sumOfSquares(values, count, center);
+}
+
+void PointKernels::minMax(const double *values, const int count, double *min, double *max)
+{
+    if(count <= 0)
+    {
+        *min = 0.0;
+        *max = 0.0;
+        return;
+    }
+
+    kernels_->minMax(values, count, min, max);
+}
+
+int PointKernels::countNonZero(const double *values, const int count)
+{
+    return kernels_->countNonZero(values, count);
+}
+
+int PointKernels::countEqual(const double *values, const int count, const double value)
+{
+    return kernels_->countEqual(values, count, value);
+}
+
+PointKernels::Instructions PointKernels::instructions()
+{
+    return static_cast<Instructions>(int(instructions_));
+}
+
+PointKernels::Instructions PointKernels::supportedInstructions()
+{
+    return supportedInstructions_;
+}
+
+bool PointKernels::setInstructions(const Instructions instructions)
+{
+    if(instructions > supportedInstructions_)
+    {
+        qWarning() << "instructions are not supported:" << instructionsName(instructions);
+        return false;
+    }
+
+    // a kernel already running finishes with the previous table
+    kernels_.fetchAndStoreOrdered(&kernelTables_[instructions]);
+    instructions_.fetchAndStoreOrdered(instructions);
+    return true;
+}
+
+QString PointKernels::instructionsName(const Instructions instructions)
+{
+    switch(instructions)
+    {
+    case Scalar: return "scalar";
+    case SSE2: return "sse2";
+    case AVX2: return "avx2";
+    case AVX512: return "avx512";
+    }
+
+    return QString();
+}
@@ -0,0 +1,58 @@
+#ifndef POINTKERNELS_H
+
+#define POINTKERNELS_H
+
+#include <QtCore>
+
+// the target attribute on functions using intrinsics and __builtin_cpu_supports
+// need GCC 4.9 or clang 3.8; older compilers get the scalar kernels only,
+// here and in SequenceBatch
+#if defined(__clang__)
+#define POINTKERNELS_COMPILER ((__clang_major__ > 3) || ((__clang_major__ == 3) && (__clang_minor__ >= 8)))
+#elif defined(__GNUC__)
+#define POINTKERNELS_COMPILER ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+#else
+#define POINTKERNELS_COMPILER 0
+#endif
+
+// Reductions over contiguous arrays of points. Every kernel has a scalar,
+// SSE2, AVX2 and AVX-512 variant, the best one supported by the CPU is
+// selected on startup. Results of the variants differ only by the order of
+// floating point additions. NaN points give an unspecified min and max.
+class PointKernels
+{
+public:
+    enum Instructions
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+
+    static double sum(const double *values, const int count);
+    static double sumOfSquares(const double *values, const int count, const double center = 0.0);
+    static void minMax(const double *values, const int count, double *min, double *max);
+    static int countNonZero(const double *values, const int count);
+    static int countEqual(const double *values, const int count, const double value);
+
+    inline static double sum(const QVector<double> &values)
+    { return sum(values.constData(), values.count()); }
+
+    inline static double sumOfSquares(const QVector<double> &values, const double center = 0.0)
+    { return sumOfSquares(values.constData(), values.count(), center); }
+
+    inline static int countNonZero(const QVector<double> &values)
+    { return countNonZero(values.constData(), values.count()); }
+
+    static Instructions instructions();
+    static Instructions supportedInstructions();
+
+    // switches the kernels of every thread atomically; meant for tests and
+    // benchmarks, a call running meanwhile may still use the previous set
+    static bool setInstructions(const Instructions instructions);
+
+    static QString instructionsName(const Instructions instructions);
+};
+
+#endif // POINTKERNELS_H
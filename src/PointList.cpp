@@ -34,6 +34,40 @@ QList<Point> PointList::points() const
     return result;
 }
 
+QVector<Point> PointList::toVector() const
+{
+    QVector<Point> result(points_.count());
+
+    QHashIterator<int, Point>  iterator(points_);
+    while (iterator.hasNext())
+    {
+        iterator.next();
+
+        // points with gaps in indexes are laid out by points()
+        if(iterator.key() >= result.count())
+        {
+            return points().toVector();
+        }
+
+        result[iterator.key()] = iterator.value();
+    }
+
+    return result;
+}
+
+PointList PointList::fromVector(const ID &id, const QVector<Point> &points)
+{
+    PointList list(id);
+    list.points_.reserve(points.count());
+
+    for(int i = 0; i < points.count(); i++)
+    {
+        list.points_.insert(i, points.at(i));
+    }
+
+    return list;
+}
+
 const Point &PointList::at(const int i) const
 {
     if(points_.contains(i))
@@ -23,6 +23,8 @@ public:
     inline bool isValid() const { return !id_.isNull();}
 
     QList<Point> points() const;
+    QVector<Point> toVector() const;
+    static PointList fromVector(const ID& id, const QVector<Point>& points);
     const Point& at(const int i) const;
 
     void append(const Point& point);
@@ -0,0 +1,70 @@
+#include "QuantileSketchAnalysis.h"
+
+QuantileSketchAnalysis::QuantileSketchAnalysis() :
+    AbstractAnalysis(idForQuantile(0.5)),
+    quantile_(0.5),
+    compression_(TDigest::defaultCompression)
+{
+}
+
+QuantileSketchAnalysis::QuantileSketchAnalysis(const double quantile, const double compression) :
+    AbstractAnalysis(idForQuantile(quantile)),
+    quantile_(quantile),
+    compression_(compression)
+{
+}
+
+QuantileSketchAnalysis::QuantileSketchAnalysis(const QuantileSketchAnalysis &a) :
+    AbstractAnalysis(idForQuantile(a.quantile_)),
+    quantile_(a.quantile_),
+    compression_(a.compression_)
+{
+}
+
+double QuantileSketchAnalysis::analyze(const PointList &values) const
+{
+    if(values.isEmpty())
+    {
+        return 0.0;
+    }
+
+    return digest(values, compression_).quantile(quantile_);
+}
+
+QuantileSketchAnalysis *QuantileSketchAnalysis::clone()
+{
+    return new QuantileSketchAnalysis(*this);
+}
+
+bool QuantileSketchAnalysis::isIncremental() const
+{
+    return compression_ == TDigest::defaultCompression;
+}
+
+void QuantileSketchAnalysis::analyzeState(const SequenceState &state, double *outputs) const
+{
+    outputs[0] = state.digest().quantile(quantile_);
+}
+
+TDigest QuantileSketchAnalysis::digest(const PointList &values, const double compression)
+{
+    const QVector<Point> points = values.toVector();
+
+    if(ParallelPoints::isParallel(points.count()))
+    {
+        return ParallelPoints::digest(points, compression);
+    }
+
+    return TDigest::fromPoints(points.constData(), points.count(), compression);
+}
+
+IDAnalysis QuantileSketchAnalysis::idForQuantile(const double quantile)
+{
+    if((quantile < 0.0) || (quantile > 1.0))
+    {
+        qWarning() << "quantile must be in [0, 1]:" << quantile;
+        return IDAnalysis();
+    }
+
+    return QString("sketch-p%1").arg(quantile * 100.0);
+}
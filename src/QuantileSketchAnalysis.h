@@ -0,0 +1,35 @@
+#ifndef QUANTILESKETCHANALYSIS_H
+
+#define QUANTILESKETCHANALYSIS_H
+
+#include "AbstractAnalysis.h"
+
+// Approximate quantile from a t-digest, memory does not depend on the
+// sequence length. The id is "sketch-p" and the percentile, e.g. sketch-p99.
+class QuantileSketchAnalysis : public AbstractAnalysis
+{
+public:
+    QuantileSketchAnalysis();
+    QuantileSketchAnalysis(const double quantile, const double compression = TDigest::defaultCompression);
+    QuantileSketchAnalysis(const QuantileSketchAnalysis &a);
+
+    double analyze(const PointList &values) const;
+    QuantileSketchAnalysis* clone();
+
+    // the stored sequence state has a digest of the default compression
+    bool isIncremental() const;
+    void analyzeState(const SequenceState &state, double *outputs) const;
+
+    inline double quantile() const { return quantile_;}
+    inline double compression() const { return compression_;}
+
+    static TDigest digest(const PointList &values, const double compression = TDigest::defaultCompression);
+
+private:
+    double quantile_;
+    double compression_;
+
+    static IDAnalysis idForQuantile(const double quantile);
+};
+
+#endif // QUANTILESKETCHANALYSIS_H
@@ -0,0 +1,431 @@
+#include "SequenceBatch.h"
+
+#include <limits>
+
+#if POINTKERNELS_COMPILER && (defined(__x86_64__) || defined(__i386__))
+#define SEQUENCEBATCH_X86
+#include <immintrin.h>
+#define SEQUENCEBATCH_TARGET(instructions) __attribute__((target(instructions)))
+#endif
+
+const int SequenceBatch::lanes;
+const int SequenceBatch::maxPoints;
+
+class SequenceGroupResults
+{
+public:
+    double sums[SequenceBatch::lanes];
+    double squares[SequenceBatch::lanes];
+    double minimums[SequenceBatch::lanes];
+    double maximums[SequenceBatch::lanes];
+    double nonZero[SequenceBatch::lanes];
+};
+
+typedef void (*SequenceGroupKernel)(const double *points, const int length, const double *counts,
+                                    SequenceGroupResults *results);
+
+// Every kernel does two passes over the group: sums, non-zero counts and
+// min/max first, then squared deviations around the lane averages.
+
+static void analyzeGroupScalar(const double *points, const int length, const double *counts,
+                               SequenceGroupResults *results)
+{
+    const int lanes = SequenceBatch::lanes;
+
+    for(int lane = 0; lane < lanes; lane++)
+    {
+        results->sums[lane] = 0.0;
+        results->nonZero[lane] = 0.0;
+        results->minimums[lane] = std::numeric_limits<double>::infinity();
+        results->maximums[lane] = -std::numeric_limits<double>::infinity();
+    }
+
+    for(int j = 0; j < length; j++)
+    {
+        const double *row = points + j * lanes;
+
+        for(int lane = 0; lane < lanes; lane++)
+        {
+            const bool isValid = j < counts[lane];
+
+            results->sums[lane] += row[lane];
+            results->nonZero[lane] += (row[lane] != 0.0) ? 1.0 : 0.0;
+
+            if(isValid)
+            {
+                results->minimums[lane] = qMin(results->minimums[lane], row[lane]);
+                results->maximums[lane] = qMax(results->maximums[lane], row[lane]);
+            }
+        }
+    }
+
+    double averages[SequenceBatch::lanes];
+    for(int lane = 0; lane < lanes; lane++)
+    {
+        averages[lane] = (counts[lane] > 0.0) ? results->sums[lane] / counts[lane] : 0.0;
+        results->squares[lane] = 0.0;
+    }
+
+    for(int j = 0; j < length; j++)
+    {
+        const double *row = points + j * lanes;
+
+        for(int lane = 0; lane < lanes; lane++)
+        {
+            const double delta = (j < counts[lane]) ? row[lane] - averages[lane] : 0.0;
+            results->squares[lane] += delta * delta;
+        }
+    }
+}
+
+#ifdef SEQUENCEBATCH_X86
+
+SEQUENCEBATCH_TARGET("sse2")
+static void analyzeGroupSSE2(const double *points, const int length, const double *counts,
+                             SequenceGroupResults *results)
+{
+    const int lanes = SequenceBatch::lanes;
+    const int vectors = lanes / 2;
+
+    const __m128d zeros = _mm_setzero_pd();
+    const __m128d ones = _mm_set1_pd(1.0);
+
+    __m128d countVectors[vectors];
+    __m128d sums[vectors];
+    __m128d nonZero[vectors];
+    __m128d minimums[vectors];
+    __m128d maximums[vectors];
+
+    for(int v = 0; v < vectors; v++)
+    {
+        countVectors[v] = _mm_loadu_pd(counts + 2 * v);
+        sums[v] = zeros;
+        nonZero[v] = zeros;
+        minimums[v] = _mm_set1_pd(std::numeric_limits<double>::infinity());
+        maximums[v] = _mm_set1_pd(-std::numeric_limits<double>::infinity());
+    }
+
+    for(int j = 0; j < length; j++)
+    {
+        const double *row = points + j * lanes;
+        const __m128d index = _mm_set1_pd(j);
+
+        for(int v = 0; v < vectors; v++)
+        {
+            const __m128d values = _mm_loadu_pd(row + 2 * v);
+            const __m128d isValid = _mm_cmplt_pd(index, countVectors[v]);
+
+            sums[v] = _mm_add_pd(sums[v], values);
+            nonZero[v] = _mm_add_pd(nonZero[v], _mm_and_pd(_mm_cmpneq_pd(values, zeros), ones));
+
+            // invalid lanes keep the current minimum and maximum
+            minimums[v] = _mm_or_pd(_mm_and_pd(isValid, _mm_min_pd(minimums[v], values)),
+                                    _mm_andnot_pd(isValid, minimums[v]));
+            maximums[v] = _mm_or_pd(_mm_and_pd(isValid, _mm_max_pd(maximums[v], values)),
+                                    _mm_andnot_pd(isValid, maximums[v]));
+        }
+    }
+
+    __m128d averages[vectors];
+    __m128d squares[vectors];
+
+    for(int v = 0; v < vectors; v++)
+    {
+        const __m128d hasPoints = _mm_cmpgt_pd(countVectors[v], zeros);
+        averages[v] = _mm_and_pd(hasPoints, _mm_div_pd(sums[v], _mm_max_pd(countVectors[v], ones)));
+        squares[v] = zeros;
+    }
+
+    for(int j = 0; j < length; j++)
+    {
+        const double *row = points + j * lanes;
+        const __m128d index = _mm_set1_pd(j);
+
+        for(int v = 0; v < vectors; v++)
+        {
+            const __m128d isValid = _mm_cmplt_pd(index, countVectors[v]);
+            const __m128d delta = _mm_and_pd(isValid, _mm_sub_pd(_mm_loadu_pd(row + 2 * v), averages[v]));
+            squares[v] = _mm_add_pd(squares[v], _mm_mul_pd(delta, delta));
+        }
+    }
+
+    for(int v = 0; v < vectors; v++)
+    {
+        _mm_storeu_pd(results->sums + 2 * v, sums[v]);
+        _mm_storeu_pd(results->squares + 2 * v, squares[v]);
+        _mm_storeu_pd(results->minimums + 2 * v, minimums[v]);
+        _mm_storeu_pd(results->maximums + 2 * v, maximums[v]);
+        _mm_storeu_pd(results->nonZero + 2 * v, nonZero[v]);
+    }
+}
+
+SEQUENCEBATCH_TARGET("avx2")
+static void analyzeGroupAVX2(const double *points, const int length, const double *counts,
+                             SequenceGroupResults *results)
+{
+    const int lanes = SequenceBatch::lanes;
+
+    const __m256d zeros = _mm256_setzero_pd();
+    const __m256d ones = _mm256_set1_pd(1.0);
+
+    const __m256d counts0 = _mm256_loadu_pd(counts);
+    const __m256d counts1 = _mm256_loadu_pd(counts + 4);
+
+    __m256d sums0 = zeros;
+    __m256d sums1 = zeros;
+    __m256d nonZero0 = zeros;
+    __m256d nonZero1 = zeros;
+    __m256d minimums0 = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m256d minimums1 = minimums0;
+    __m256d maximums0 = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    __m256d maximums1 = maximums0;
+
+    for(int j = 0; j < length; j++)
+    {
+        const double *row = points + j * lanes;
+        const __m256d index = _mm256_set1_pd(j);
+
+        const __m256d values0 = _mm256_loadu_pd(row);
+        const __m256d values1 = _mm256_loadu_pd(row + 4);
+        const __m256d isValid0 = _mm256_cmp_pd(index, counts0, _CMP_LT_OQ);
+        const __m256d isValid1 = _mm256_cmp_pd(index, counts1, _CMP_LT_OQ);
+
+        sums0 = _mm256_add_pd(sums0, values0);
+        sums1 = _mm256_add_pd(sums1, values1);
+
+        nonZero0 = _mm256_add_pd(nonZero0, _mm256_and_pd(_mm256_cmp_pd(values0, zeros, _CMP_NEQ_UQ), ones));
+        nonZero1 = _mm256_add_pd(nonZero1, _mm256_and_pd(_mm256_cmp_pd(values1, zeros, _CMP_NEQ_UQ), ones));
+
+        minimums0 = _mm256_blendv_pd(minimums0, _mm256_min_pd(minimums0, values0), isValid0);
+        minimums1 = _mm256_blendv_pd(minimums1, _mm256_min_pd(minimums1, values1), isValid1);
+        maximums0 = _mm256_blendv_pd(maximums0, _mm256_max_pd(maximums0, values0), isValid0);
+        maximums1 = _mm256_blendv_pd(maximums1, _mm256_max_pd(maximums1, values1), isValid1);
+    }
+
+    const __m256d averages0 = _mm256_and_pd(_mm256_cmp_pd(counts0, zeros, _CMP_GT_OQ),
+                                            _mm256_div_pd(sums0, _mm256_max_pd(counts0, ones)));
+    const __m256d averages1 = _mm256_and_pd(_mm256_cmp_pd(counts1, zeros, _CMP_GT_OQ),
+                                            _mm256_div_pd(sums1, _mm256_max_pd(counts1, ones)));
+
+    __m256d squares0 = zeros;
+    __m256d squares1 = zeros;
+
+    for(int j = 0; j < length; j++)
+    {
+        const double *row = points + j * lanes;
+        const __m256d index = _mm256_set1_pd(j);
+
+        const __m256d delta0 = _mm256_and_pd(_mm256_cmp_pd(index, counts0, _CMP_LT_OQ),
+                                             _mm256_sub_pd(_mm256_loadu_pd(row), averages0));
+        const __m256d delta1 = _mm256_and_pd(_mm256_cmp_pd(index, counts1, _CMP_LT_OQ),
+                                             _mm256_sub_pd(_mm256_loadu_pd(row + 4), averages1));
+
+        squares0 = _mm256_add_pd(squares0, _mm256_mul_pd(delta0, delta0));
+        squares1 = _mm256_add_pd(squares1, _mm256_mul_pd(delta1, delta1));
+    }
+
+    _mm256_storeu_pd(results->sums, sums0);
+    _mm256_storeu_pd(results->sums + 4, sums1);
+    _mm256_storeu_pd(results->squares, squares0);
+    _mm256_storeu_pd(results->squares + 4, squares1);
+    _mm256_storeu_pd(results->minimums, minimums0);
+    _mm256_storeu_pd(results->minimums + 4, minimums1);
+    _mm256_storeu_pd(results->maximums, maximums0);
+    _mm256_storeu_pd(results->maximums + 4, maximums1);
+    _mm256_storeu_pd(results->nonZero, nonZero0);
+    _mm256_storeu_pd(results->nonZero + 4, nonZero1);
+}
+
+SEQUENCEBATCH_TARGET("avx512f")
+static void analyzeGroupAVX512(const double *points, const int length, const double *counts,
+                               SequenceGroupResults *results)
+{
+    const int lanes = SequenceBatch::lanes;
+
+    const __m512d zeros = _mm512_setzero_pd();
+    const __m512d ones = _mm512_set1_pd(1.0);
+    const __m512d countVector = _mm512_loadu_pd(counts);
+
+    __m512d sums = zeros;
+    __m512d nonZero = zeros;
+    __m512d minimums = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+    __m512d maximums = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+
+    for(int j = 0; j < length; j++)
+    {
+        const __m512d values = _mm512_loadu_pd(points + j * lanes);
+        const __mmask8 isValid = _mm512_cmp_pd_mask(_mm512_set1_pd(j), countVector, _CMP_LT_OQ);
+
+        sums = _mm512_add_pd(sums, values);
+        nonZero = _mm512_mask_add_pd(nonZero, _mm512_cmp_pd_mask(values, zeros, _CMP_NEQ_UQ), nonZero, ones);
+        minimums = _mm512_mask_min_pd(minimums, isValid, minimums, values);
+        maximums = _mm512_mask_max_pd(maximums, isValid, maximums, values);
+    }
+
+    const __mmask8 hasPoints = _mm512_cmp_pd_mask(countVector, zeros, _CMP_GT_OQ);
+    const __m512d averages = _mm512_maskz_div_pd(hasPoints, sums, countVector);
+
+    __m512d squares = zeros;
+
+    for(int j = 0; j < length; j++)
+    {
+        const __mmask8 isValid = _mm512_cmp_pd_mask(_mm512_set1_pd(j), countVector, _CMP_LT_OQ);
+        const __m512d delta = _mm512_maskz_sub_pd(isValid, _mm512_loadu_pd(points + j * lanes), averages);
+        squares = _mm512_fmadd_pd(delta, delta, squares);
+    }
+
+    _mm512_storeu_pd(results->sums, sums);
+    _mm512_storeu_pd(results->squares, squares);
+    _mm512_storeu_pd(results->minimums, minimums);
+    _mm512_storeu_pd(results->maximums, maximums);
+    _mm512_storeu_pd(results->nonZero, nonZero);
+}
+
+#endif // SEQUENCEBATCH_X86
+
+static SequenceGroupKernel sequenceGroupKernel(const PointKernels::Instructions instructions)
+{
+#ifdef SEQUENCEBATCH_X86
+    switch(instructions)
+    {
+    case PointKernels::AVX512: return analyzeGroupAVX512;
+    case PointKernels::AVX2: return analyzeGroupAVX2;
+    case PointKernels::SSE2: return analyzeGroupSSE2;
+    case PointKernels::Scalar: break;
+    }
+#else
+    Q_UNUSED(instructions);
+#endif
+
+    return analyzeGroupScalar;
+}
+
+SequenceBatch::SequenceBatch()
+{
+}
+
+bool SequenceBatch::append(const ID &id, const QVector<Point> &points)
+{
+    if(!isShort(points.count()))
+    {
+        qWarning() << QString("sequence %1 is too long for a batch").arg(id);
+        return false;
+    }
+
+    const int sequence = ids_.count();
+    const int lane = sequence % lanes;
+
+    if(lane == 0)
+    {
+        groupOffsets_.append(points_.count());
+        groupLengths_.append(0);
+    }
+
+    // the group is the last one, so new rows are appended to the end
+    int &length = groupLengths_.last();
+    if(points.count() > length)
+    {
+        points_.resize(points_.count() + (points.count() - length) * lanes);
+        length = points.count();
+    }
+
+    double *group = points_.data() + groupOffsets_.last();
+    for(int j = 0; j < points.count(); j++)
+    {
+        group[j * lanes + lane] = points.at(j);
+    }
+
+    ids_.append(id);
+    counts_.append(points.count());
+
+    return true;
+}
+
+bool SequenceBatch::append(const PointList &list)
+{
+    return append(list.id(), list.toVector());
+}
+
+PointList SequenceBatch::pointList(const int sequence) const
+{
+    return PointList::fromVector(ids_.at(sequence), values(sequence));
+}
+
+QVector<Point> SequenceBatch::values(const int sequence) const
+{
+    QVector<Point> points(counts_.at(sequence));
+
+    const double *group = points_.constData() + groupOffsets_.at(sequence / lanes);
+    const int lane = sequence % lanes;
+
+    for(int j = 0; j < points.count(); j++)
+    {
+        points[j] = group[j * lanes + lane];
+    }
+
+    return points;
+}
+
+void SequenceBatch::clear()
+{
+    ids_.clear();
+    counts_.clear();
+    groupOffsets_.clear();
+    groupLengths_.clear();
+    points_.clear();
+}
+
+SequenceBatchResults SequenceBatch::analyze() const
+{
+    SequenceBatchResults results;
+    results.averages.resize(count());
+    results.averagesIgnoreNull.resize(count());
+    results.deviations.resize(count());
+    results.minimums.resize(count());
+    results.maximums.resize(count());
+
+    const SequenceGroupKernel kernel = sequenceGroupKernel(PointKernels::instructions());
+
+    for(int groupIndex = 0; groupIndex < groupOffsets_.count(); groupIndex++)
+    {
+        const int first = groupIndex * lanes;
+        const int sequences = qMin(lanes, count() - first);
+
+        double counts[lanes];
+        for(int lane = 0; lane < lanes; lane++)
+        {
+            counts[lane] = (lane < sequences) ? counts_.at(first + lane) : 0.0;
+        }
+
+        SequenceGroupResults group;
+        kernel(points_.constData() + groupOffsets_.at(groupIndex), groupLengths_.at(groupIndex), counts, &group);
+
+        for(int lane = 0; lane < sequences; lane++)
+        {
+            const int sequence = first + lane;
+            const double pointsCount = counts[lane];
+
+            if(pointsCount == 0.0)
+            {
+                results.averages[sequence] = 0.0;
+                results.averagesIgnoreNull[sequence] = 0.0;
+                results.deviations[sequence] = 0.0;
+                results.minimums[sequence] = 0.0;
+                results.maximums[sequence] = 0.0;
+                continue;
+            }
+
+            results.averages[sequence] = group.sums[lane] / pointsCount;
+            results.averagesIgnoreNull[sequence] = (group.nonZero[lane] > 0.0)
+                    ? group.sums[lane] / group.nonZero[lane]
+                    : 0.0;
+            results.deviations[sequence] = (pointsCount > 1.0)
+                    ? qSqrt(group.squares[lane] / (pointsCount - 1.0))
+                    : 0.0;
+            results.minimums[sequence] = group.minimums[lane];
+            results.maximums[sequence] = group.maximums[lane];
+        }
+    }
+
+    return results;
+}
@@ -0,0 +1,68 @@
+#ifndef SEQUENCEBATCH_H
+
+#define SEQUENCEBATCH_H
+
+#include "PointList.h"
+#include "PointKernels.h"
+
+class SequenceBatchResults
+{
+public:
+    QVector<double> averages;
+    QVector<double> averagesIgnoreNull;
+    QVector<double> deviations;
+    QVector<double> minimums;
+    QVector<double> maximums;
+};
+
+// Short sequences stored transposed: a group holds lanes sequences and
+// point j of every sequence of the group is stored next to each other, so
+// one SIMD instruction processes the same point of 2-8 sequences. Missing
+// points of shorter sequences are zero and are masked out by the kernels.
+class SequenceBatch
+{
+public:
+    enum Statistic
+    {
+        NoStatistic,
+        Average,
+        AverageIgnoreNull,
+        StandardDeviation,
+        Minimum,
+        Maximum
+    };
+
+    static const int lanes = 8;
+    static const int maxPoints = 64;
+
+    SequenceBatch();
+
+    inline int count() const { return ids_.count();}
+    inline bool isEmpty() const { return ids_.isEmpty();}
+
+    inline const IDList& ids() const { return ids_;}
+    inline const ID& id(const int sequence) const { return ids_.at(sequence);}
+    inline int pointsCount(const int sequence) const { return counts_.at(sequence);}
+
+    inline static bool isShort(const int pointsCount) { return pointsCount <= maxPoints;}
+
+    bool append(const ID &id, const QVector<Point> &points);
+    bool append(const PointList &list);
+
+    PointList pointList(const int sequence) const;
+    QVector<Point> values(const int sequence) const;
+
+    void clear();
+
+    SequenceBatchResults analyze() const;
+
+private:
+    IDList ids_;
+    QVector<int> counts_;
+
+    QVector<int> groupOffsets_;
+    QVector<int> groupLengths_;
+    QVector<double> points_;
+};
+
+#endif // SEQUENCEBATCH_H
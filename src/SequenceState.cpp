@@ -0,0 +1,68 @@
+#include "SequenceState.h"
+
+SequenceState::SequenceState()
+{
+}
+
+SequenceState SequenceState::fromPoints(const double *values, const int count)
+{
+    SequenceState state;
+
+    state.accumulator_ = PointAccumulator::fromPoints(values, count);
+    state.digest_.add(values, count);
+
+    return state;
+}
+
+SequenceState SequenceState::fromPoints(const QVector<Point> &values)
+{
+    return fromPoints(values.constData(), values.count());
+}
+
+void SequenceState::append(const Point point)
+{
+    accumulator_.add(point);
+    digest_.add(point);
+}
+
+void SequenceState::append(const double *values, const int count)
+{
+    accumulator_.merge(PointAccumulator::fromPoints(values, count));
+    digest_.add(values, count);
+}
+
+QByteArray SequenceState::toByteArray() const
+{
+    QByteArray data;
+
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << *this;
+
+    return data;
+}
+
+SequenceState SequenceState::fromByteArray(const QByteArray &data, bool *ok)
+{
+    SequenceState state;
+
+    QDataStream stream(data);
+    stream >> state;
+
+    const bool isRead = (stream.status() == QDataStream::Ok);
+    if(ok != 0)
+    {
+        *ok = isRead;
+    }
+
+    return isRead ? state : SequenceState();
+}
+
+QDataStream &operator<<(QDataStream &stream, const SequenceState &state)
+{
+    return stream << state.accumulator_ << state.digest_;
+}
+
+QDataStream &operator>>(QDataStream &stream, SequenceState &state)
+{
+    return stream >> state.accumulator_ >> state.digest_;
+}
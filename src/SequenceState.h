@@ -0,0 +1,43 @@
+#ifndef SEQUENCESTATE_H
+
+#define SEQUENCESTATE_H
+
+#include "PointAccumulator.h"
+#include "TDigest.h"
+
+// Analysis state of a whole sequence that is updated point by point:
+// moments, min/max and a t-digest for quantiles. Appending points costs
+// O(1) each, the state is stored next to the sequence with QDataStream so
+// analyses of long-lived sequences do not read their points again.
+class SequenceState
+{
+public:
+    SequenceState();
+
+    static SequenceState fromPoints(const double *values, const int count);
+    static SequenceState fromPoints(const QVector<Point> &values);
+
+    inline qint64 count() const { return accumulator_.count();}
+    inline bool isEmpty() const { return accumulator_.isEmpty();}
+
+    inline const PointAccumulator& accumulator() const { return accumulator_;}
+    inline const TDigest& digest() const { return digest_;}
+
+    void append(const Point point);
+    void append(const double *values, const int count);
+
+    QByteArray toByteArray() const;
+    static SequenceState fromByteArray(const QByteArray &data, bool *ok = 0);
+
+private:
+    PointAccumulator accumulator_;
+    TDigest digest_;
+
+    friend QDataStream &operator<<(QDataStream &stream, const SequenceState &state);
+    friend QDataStream &operator>>(QDataStream &stream, SequenceState &state);
+};
+
+QDataStream &operator<<(QDataStream &stream, const SequenceState &state);
+QDataStream &operator>>(QDataStream &stream, SequenceState &state);
+
+#endif // SEQUENCESTATE_H
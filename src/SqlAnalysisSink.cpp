@@ -0,0 +1,136 @@
+#include "SqlAnalysisSink.h"
+
+// msecs a write waits for the readers of the same database file
+const int SqlAnalysisSink::busyTimeout_ = 30000;
+
+SqlAnalysisSink::SqlAnalysisSink(const QString &dataBaseName, const QString &tableName) :
+    dataBaseName_(dataBaseName),
+    tableName_(tableName),
+    connectionName_(SqlPointListInterface::uniqueConnectionName()),
+    width_(0)
+{
+}
+
+SqlAnalysisSink::~SqlAnalysisSink()
+{
+    if(dataBase_.isOpen())
+    {
+        finish();
+    }
+
+    insertResult_ = QSqlQuery();
+    dataBase_ = QSqlDatabase();
+
+    if(QSqlDatabase::contains(connectionName_))
+    {
+        QSqlDatabase::removeDatabase(connectionName_);
+    }
+}
+
+bool SqlAnalysisSink::begin(const IDAnalysisList &outputIDs)
+{
+    dataBase_ = QSqlDatabase::addDatabase("QSQLITE", connectionName_);
+    dataBase_.setDatabaseName(dataBaseName_);
+    dataBase_.setConnectOptions(QString("QSQLITE_BUSY_TIMEOUT=%1").arg(busyTimeout_));
+
+    if(!dataBase_.open())
+    {
+        qWarning() << "can't open results database" << dataBaseName_;
+        return false;
+    }
+
+    // output ids contain dashes, so the columns are quoted
+    QStringList columns;
+    QStringList placeholders;
+    foreach(const IDAnalysis &id, outputIDs)
+    {
+        columns << "\"" + id + "\"";
+        placeholders << "?";
+    }
+
+    // the name comes from the command line, so it is quoted like the columns
+    const QString table = "\"" + QString(tableName_).replace("\"", "\"\"") + "\"";
+
+    QSqlQuery query(dataBase_);
+    if(!query.exec("DROP TABLE IF EXISTS " + table))
+    {
+        qWarning() << "drop results table" << query.lastError().text();
+        return false;
+    }
+
+    if(!query.exec("CREATE TABLE " + table + " (" + SqlPointListInterface::columnID() + " VARCHAR PRIMARY KEY, "
+                   + columns.join(" REAL, ") + (columns.isEmpty() ? "" : " REAL") + ")"))
+    {
+        qWarning() << "create results table" << query.lastError().text();
+        return false;
+    }
+
+    insertResult_ = QSqlQuery(dataBase_);
+    insertResult_.prepare("INSERT OR REPLACE INTO " + table + " VALUES (?"
+                          + (placeholders.isEmpty() ? QString() : ", " + placeholders.join(", ")) + ")");
+    if(insertResult_.lastError().text() != " ")
+    {
+        qWarning() << "prepare insert result" << insertResult_.lastError().text();
+        return false;
+    }
+
+    width_ = outputIDs.count();
+
+    return true;
+}
+
+bool SqlAnalysisSink::write(const IDList &items, const QVector<double> &values)
+{
+    if(!dataBase_.isOpen())
+    {
+        qWarning() << "results database not open";
+        return false;
+    }
+
+    dataBase_.transaction();
+
+    for(int row = 0; row < items.count(); row++)
+    {
+        insertResult_.addBindValue(items.at(row));
+        for(int column = 0; column < width_; column++)
+        {
+            insertResult_.addBindValue(values.at(row * width_ + column));
+        }
+
+        if(!insertResult_.exec())
+        {
+            qWarning() << "exec insert result" << insertResult_.lastError().text();
+            dataBase_.rollback();
+            return false;
+        }
+    }
+
+    if(!dataBase_.commit())
+    {
+        qWarning() << "commit results" << dataBase_.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+bool SqlAnalysisSink::finish()
+{
+    // a failed commit stays the last error of the connection
+    const bool isCommitted = dataBase_.isOpen() && !dataBase_.lastError().isValid();
+
+    insertResult_ = QSqlQuery();
+    dataBase_.close();
+
+    return isCommitted;
+}
+
+QString SqlAnalysisSink::dataBaseName() const
+{
+    return dataBaseName_;
+}
+
+QString SqlAnalysisSink::tableName() const
+{
+    return tableName_;
+}
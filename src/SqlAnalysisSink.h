@@ -0,0 +1,39 @@
+#ifndef SQLANALYSISSINK_H
+
+#define SQLANALYSISSINK_H
+
+#include <QSqlDatabase>
+
+#include "AbstractAnalysisSink.h"
+#include "SqlPointListInterface.h"
+
+// Results written to a table (id, one REAL column per output) on its own
+// connection, replacing an existing table of the same name. Every batch is
+// one transaction. The points database may be used as well, the readers
+// then wait while a batch commits, so a separate file is faster.
+class SqlAnalysisSink : public AbstractAnalysisSink
+{
+public:
+    SqlAnalysisSink(const QString &dataBaseName, const QString &tableName);
+    ~SqlAnalysisSink();
+
+    bool begin(const IDAnalysisList &outputIDs);
+    bool write(const IDList &items, const QVector<double> &values);
+    bool finish();
+
+    QString dataBaseName() const;
+    QString tableName() const;
+
+private:
+    QString dataBaseName_;
+    QString tableName_;
+    QString connectionName_;
+
+    QSqlDatabase dataBase_;
+    QSqlQuery insertResult_;
+    int width_;
+
+    static const int busyTimeout_;
+};
+
+#endif // SQLANALYSISSINK_H
@@ -1,14 +1,20 @@
 #include "SqlPointListInterface.h"
+#include "SqliteAggregateFunctions.h"
 
-const QString SqlPointListInterface::connectionName_("connection");
+const QString SqlPointListInterface::defaultConnectionName_("connection");
 const ColumnsName SqlPointListInterface::columnID_("id");
 const ColumnsName SqlPointListInterface::columnNUM_("num");
 const ColumnsName SqlPointListInterface::columnVALUE_("value");
+const ColumnsName SqlPointListInterface::columnSTATE_("state");
 
 SqlPointListInterface::SqlPointListInterface(const QString &dataBaseName, const QString& tableName) :
     dataBaseName_(dataBaseName),
     tableName_(tableName),
-    open_(false)
+    connectionName_(defaultConnectionName_),
+    open_(false),
+    aggregateFunctions_(false),
+    readOnly_(false),
+    busyTimeout_(0)
 {
 
 }
@@ -33,6 +39,38 @@ QString SqlPointListInterface::tableName() const
     return tableName_;
 }
 
+QString SqlPointListInterface::stateTableName() const
+{
+    return tableName_ + "_state";
+}
+
+QString SqlPointListInterface::connectionName() const
+{
+    return connectionName_;
+}
+
+void SqlPointListInterface::setConnectionName(const QString &connectionName)
+{
+    if(isOpen())
+    {
+        qWarning() << "can't change connection name of opened database";
+        return;
+    }
+
+    connectionName_ = connectionName;
+}
+
+const QString &SqlPointListInterface::defaultConnectionName()
+{
+    return defaultConnectionName_;
+}
+
+QString SqlPointListInterface::uniqueConnectionName()
+{
+    static QAtomicInt connectionsCount;
+    return QString("%1-%2").arg(defaultConnectionName_).arg(connectionsCount.fetchAndAddOrdered(1));
+}
+
 bool SqlPointListInterface::execQuery(QSqlQuery &query, const QString& queryStr)
 {
     QString errorStr;
@@ -83,12 +121,36 @@ bool SqlPointListInterface::createIndexes(QSqlQuery &query)
     return result;
 }
 
+bool SqlPointListInterface::createStateTable(QSqlQuery &query)
+{
+    QString queryStr = "CREATE TABLE IF NOT EXISTS "
+            + stateTableName() +
+            " (" + columnID() + " VARCHAR PRIMARY KEY, " + columnSTATE() + " BLOB)";
+
+    bool result = execQuery(query, queryStr);
+
+    return result;
+}
+
+void SqlPointListInterface::close()
+{
+    dataBase_.close();
+    dataBase_ = QSqlDatabase();
+    open_ = false;
+    aggregateFunctions_ = false;
+}
+
 void SqlPointListInterface::removeConnection()
 {
-    if(QSqlDatabase::contains(connectionName_))
+    removeConnection(defaultConnectionName_);
+}
+
+void SqlPointListInterface::removeConnection(const QString &connectionName)
+{
+    if(QSqlDatabase::contains(connectionName))
     {
 
-        QSqlDatabase::removeDatabase(connectionName_);
+        QSqlDatabase::removeDatabase(connectionName);
     }
 }
 
@@ -101,10 +163,21 @@ bool SqlPointListInterface::open()
     }
     else
     {
-        dataBase_ = QSqlDatabase::addDatabase("QSQLITE", "connection");
+        dataBase_ = QSqlDatabase::addDatabase("QSQLITE", connectionName_);
     }
 
     dataBase_.setDatabaseName(dataBaseName_);
+    QStringList connectOptions;
+    if(readOnly_)
+    {
+        connectOptions << "QSQLITE_OPEN_READONLY";
+    }
+    if(busyTimeout_ > 0)
+    {
+        connectOptions << QString("QSQLITE_BUSY_TIMEOUT=%1").arg(busyTimeout_);
+    }
+
+    dataBase_.setConnectOptions(connectOptions.join(";"));
     if (!dataBase_.open())
     {
         qWarning() << "can't open database " << dataBaseName_;
@@ -114,23 +187,35 @@ bool SqlPointListInterface::open()
 
     QSqlQuery query(dataBase_);
 
-    const bool createTableSuccess = createTable(query);
-    if(!createTableSuccess)
+    if(!readOnly_)
     {
-        open_ = false;
-        return false;
-    }
+        const bool createTableSuccess = createTable(query);
+        if(!createTableSuccess)
+        {
+            open_ = false;
+            return false;
+        }
 
-    const bool createIndexesSuccess = createIndexes(query);
-    if(!createIndexesSuccess)
-    {
-        open_ = false;
-        return false;
+        const bool createIndexesSuccess = createIndexes(query);
+        if(!createIndexesSuccess)
+        {
+            open_ = false;
+            return false;
+        }
+
+        const bool createStateTableSuccess = createStateTable(query);
+        if(!createStateTableSuccess)
+        {
+            open_ = false;
+            return false;
+        }
     }
 
     query.exec("PRAGMA synchronous = OFF;");
     query.exec("PRAGMA cache_size = 20000;");
 
+    aggregateFunctions_ = SqliteAggregateFunctions::isAvailable() && SqliteAggregateFunctions::install(dataBase_);
+
 
 
     if(prepareQueries())
@@ -170,6 +255,43 @@ bool SqlPointListInterface::isOpen() const
     return open_;
 }
 
+bool SqlPointListInterface::isReadOnly() const
+{
+    return readOnly_;
+}
+
+void SqlPointListInterface::setReadOnly(const bool readOnly)
+{
+    if(isOpen())
+    {
+        qWarning() << "can't change access mode of opened database";
+        return;
+    }
+
+    readOnly_ = readOnly;
+}
+
+int SqlPointListInterface::busyTimeout() const
+{
+    return busyTimeout_;
+}
+
+void SqlPointListInterface::setBusyTimeout(const int msecs)
+{
+    if(isOpen())
+    {
+        qWarning() << "can't change busy timeout of opened database";
+        return;
+    }
+
+    busyTimeout_ = qMax(0, msecs);
+}
+
+bool SqlPointListInterface::hasAggregateFunctions() const
+{
+    return aggregateFunctions_;
+}
+
 const ColumnsName &SqlPointListInterface::columnID()
 {
     return columnID_;
@@ -184,3 +306,8 @@ const ColumnsName &SqlPointListInterface::columnVALUE()
 {
     return columnVALUE_;
 }
+
+const ColumnsName &SqlPointListInterface::columnSTATE()
+{
+    return columnSTATE_;
+}
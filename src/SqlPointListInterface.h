@@ -6,6 +6,7 @@
 #include <QSqlError>
 #include <QStringList>
 #include <QDebug>
+#include <QAtomicInt>
 
 typedef QString ColumnsName;
 
@@ -17,6 +18,8 @@ class SqlPointListInterface
     friend class TAnalysisTableModel;
     friend class TItemListModel;
     friend class BAnalyzing;
+    friend class BStatisticsCollection;
+    friend class BScaling;
 
 public:
     SqlPointListInterface(const QString &dataBaseName = QString(), const QString &tableName = QString());
@@ -26,9 +29,28 @@ public:
     QString dataBaseName() const;
     QSqlDatabase dataBase() const;
     QString tableName() const;
+    QString stateTableName() const;
+
+    QString connectionName() const;
+    void setConnectionName(const QString &connectionName);
+    static const QString& defaultConnectionName();
+    static QString uniqueConnectionName();
 
     virtual bool prepareQueries() = 0;
     bool isOpen() const;
+
+    // true when the functions of SqliteAggregateFunctions are installed on the connection
+    bool hasAggregateFunctions() const;
+
+    // a read-only connection doesn't create the tables and indexes, so the
+    // database must exist and is never locked for writing
+    bool isReadOnly() const;
+    void setReadOnly(const bool readOnly);
+
+    // msecs a statement waits for a lock held by another connection, 0 fails at once
+    int busyTimeout() const;
+    void setBusyTimeout(const int msecs);
+
     bool open();
     bool open(const QString &dataBaseName, const QString &tableName);
 
@@ -36,26 +58,35 @@ public:
     static const ColumnsName& columnID();
     static const ColumnsName& columnNUM();
     static const ColumnsName& columnVALUE();
+    static const ColumnsName& columnSTATE();
 
 
 protected:
     bool execQuery(QSqlQuery &query, const QString& queryStr);
     bool createTable(QSqlQuery &query);
     bool createIndexes(QSqlQuery &query);
+    bool createStateTable(QSqlQuery &query);
+    void close();
     static void removeConnection();
+    static void removeConnection(const QString &connectionName);
 
 private:
     QSqlDatabase dataBase_;
     QString dataBaseName_;
     QString tableName_;
+    QString connectionName_;
 
-    static const QString connectionName_;
+    static const QString defaultConnectionName_;
 
     static const ColumnsName columnID_;
     static const ColumnsName columnNUM_;
     static const ColumnsName columnVALUE_;
+    static const ColumnsName columnSTATE_;
 
     bool open_;
+    bool aggregateFunctions_;
+    bool readOnly_;
+    int busyTimeout_;
 
 
 };
@@ -1,7 +1,11 @@
 #include "SqlPointListReader.h"
+#include "Metrics.h"
+
+const int SqlPointListReader::itemsPerAggregateQuery_ = 500;
 
 SqlPointListReader::SqlPointListReader(const QString &dataBaseName, const QString& tableName) :
-    SqlPointListInterface(dataBaseName, tableName)
+    SqlPointListInterface(dataBaseName, tableName),
+    hasStateTable_(false)
 {
 
 }
@@ -12,6 +16,22 @@ SqlPointListReader::~SqlPointListReader()
     {
         delete s;
     }
+
+    if(connectionName() != defaultConnectionName())
+    {
+        const QString clonedConnectionName = connectionName();
+
+        readPointsByID_ = QSqlQuery();
+        readAllPointsIDs_ = QSqlQuery();
+        readFirstPointsIDs_ = QSqlQuery();
+        readNextPointsIDs_ = QSqlQuery();
+        readStateByID_ = QSqlQuery();
+        readPointsCountByID_ = QSqlQuery();
+        readPointsByRange_ = QSqlQuery();
+        close();
+
+        removeConnection(clonedConnectionName);
+    }
 }
 
 bool SqlPointListReader::prepareQueries()
@@ -34,11 +54,68 @@ bool SqlPointListReader::prepareQueries()
         return false;
     }
 
+    readFirstPointsIDs_ = QSqlQuery(dataBase());
+    readFirstPointsIDs_.setForwardOnly(true);
+    readFirstPointsIDs_.prepare("SELECT DISTINCT " + columnID() + " FROM " + tableName()
+                                + " ORDER BY " + columnID() + " LIMIT :limit");
+    if(readFirstPointsIDs_.lastError().text() != " ")
+    {
+        qWarning() << "prepare select first points ids" << readFirstPointsIDs_.lastError().text();
+        return false;
+    }
+
+    readNextPointsIDs_ = QSqlQuery(dataBase());
+    readNextPointsIDs_.setForwardOnly(true);
+    readNextPointsIDs_.prepare("SELECT DISTINCT " + columnID() + " FROM " + tableName()
+                               + " WHERE " + columnID() + " > :after"
+                               + " ORDER BY " + columnID() + " LIMIT :limit");
+    if(readNextPointsIDs_.lastError().text() != " ")
+    {
+        qWarning() << "prepare select next points ids" << readNextPointsIDs_.lastError().text();
+        return false;
+    }
+
+    // a read-only connection doesn't create the state table of an older database
+    hasStateTable_ = !isReadOnly() || hasTable(stateTableName());
+    if(hasStateTable_)
+    {
+        readStateByID_ = QSqlQuery(dataBase());
+        readStateByID_.setForwardOnly(true);
+        readStateByID_.prepare("SELECT " + columnSTATE() + " FROM " + stateTableName() + " WHERE " + columnID() + " = :id");
+        if(readStateByID_.lastError().text() != " ")
+        {
+            qWarning() << "prepare select state" << readStateByID_.lastError().text();
+            return false;
+        }
+    }
+
+    readPointsCountByID_ = QSqlQuery(dataBase());
+    readPointsCountByID_.setForwardOnly(true);
+    readPointsCountByID_.prepare("SELECT COUNT(*) FROM " + tableName() + " WHERE " + columnID() + " = :id");
+    if(readPointsCountByID_.lastError().text() != " ")
+    {
+        qWarning() << "prepare select points count" << readPointsCountByID_.lastError().text();
+        return false;
+    }
+
+    readPointsByRange_ = QSqlQuery(dataBase());
+    readPointsByRange_.setForwardOnly(true);
+    readPointsByRange_.prepare("SELECT " + columnID() + ", " + columnVALUE() + " FROM " + tableName()
+                               + " WHERE " + columnID() + " >= :first AND " + columnID() + " <= :last"
+                               + " ORDER BY " + columnID() + ", " + columnNUM());
+    if(readPointsByRange_.lastError().text() != " ")
+    {
+        qWarning() << "prepare select points range" << readPointsByRange_.lastError().text();
+        return false;
+    }
+
     return true;
 }
 
 PointList SqlPointListReader::read(const ID &item)
 {
+    METRICS_TIMER("reader/read");
+
     if(isOpen())
     {
         PointList points(item);
@@ -60,6 +137,8 @@ PointList SqlPointListReader::read(const ID &item)
 
         readPointsByID_.finish();
 
+        METRICS_COUNT("reader/points", points.count());
+
         return points;
     }
     else
@@ -70,6 +149,194 @@ PointList SqlPointListReader::read(const ID &item)
     return PointList();
 }
 
+QVector<Point> SqlPointListReader::readValues(const ID &item)
+{
+    METRICS_TIMER("reader/read");
+
+    if(!isOpen())
+    {
+        qWarning() << "database not open";
+        return QVector<Point>();
+    }
+
+    readPointsByID_.bindValue(":id", item);
+
+    readPointsByID_.exec();
+    if(readPointsByID_.lastError().text() != " ")
+    {
+        qWarning() << "exec select point" << readPointsByID_.lastError().text();
+        return QVector<Point>();
+    }
+
+    QVector<Point> points;
+    while(readPointsByID_.next())
+    {
+        points.append(readPointsByID_.value(0).toDouble());
+    }
+
+    readPointsByID_.finish();
+
+    METRICS_COUNT("reader/points", points.count());
+
+    return points;
+}
+
+bool SqlPointListReader::readState(const ID &item, SequenceState *state)
+{
+    if(!isOpen())
+    {
+        qWarning() << "database not open";
+        return false;
+    }
+
+    if(!hasStateTable_)
+    {
+        return false;
+    }
+
+    readStateByID_.bindValue(":id", item);
+
+    if(!readStateByID_.exec())
+    {
+        qWarning() << "exec select state" << readStateByID_.lastError().text();
+        return false;
+    }
+
+    const bool isStored = readStateByID_.next();
+    const QByteArray data = isStored ? readStateByID_.value(0).toByteArray() : QByteArray();
+    readStateByID_.finish();
+
+    if(!isStored)
+    {
+        return false;
+    }
+
+    bool isRead = false;
+    *state = SequenceState::fromByteArray(data, &isRead);
+
+    return isRead;
+}
+
+bool SqlPointListReader::hasTable(const QString &tableName)
+{
+    QSqlQuery query(dataBase());
+    query.prepare("SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' AND name = :name");
+    query.bindValue(":name", tableName);
+
+    if(!query.exec() || !query.next())
+    {
+        qWarning() << "exec select table" << query.lastError().text();
+        return false;
+    }
+
+    return query.value(0).toInt() > 0;
+}
+
+bool SqlPointListReader::canAggregate(const StorageAggregateList &aggregates) const
+{
+    foreach(const StorageAggregate &aggregate, aggregates)
+    {
+        if(aggregateExpression(aggregate).isEmpty())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SqlPointListReader::readAggregates(const IDList &items, const StorageAggregateList &aggregates, QVector<double> *values)
+{
+    if(!isOpen())
+    {
+        qWarning() << "database not open";
+        return false;
+    }
+
+    QStringList expressions;
+    foreach(const StorageAggregate &aggregate, aggregates)
+    {
+        const QString expression = aggregateExpression(aggregate);
+        if(expression.isEmpty())
+        {
+            qWarning() << "storage can't compute aggregate" << aggregate.aggregate();
+            return false;
+        }
+        expressions << expression;
+    }
+
+    const int width = aggregates.count();
+    *values = QVector<double>(items.count() * width, 0.0);
+
+    // items without points keep 0, like the analyses of an empty sequence
+    for(int first = 0; first < items.count(); first += itemsPerAggregateQuery_)
+    {
+        const int count = qMin(itemsPerAggregateQuery_, items.count() - first);
+
+        QHash<ID, int> rows;
+        QStringList placeholders;
+        for(int i = first; i < first + count; i++)
+        {
+            rows.insert(items.at(i), i);
+            placeholders << "?";
+        }
+
+        QSqlQuery query(dataBase());
+        query.setForwardOnly(true);
+        query.prepare("SELECT " + columnID() + ", " + expressions.join(", ") + " FROM " + tableName()
+                      + " WHERE " + columnID() + " IN (" + placeholders.join(", ") + ")"
+                      + " GROUP BY " + columnID());
+        for(int i = first; i < first + count; i++)
+        {
+            query.addBindValue(items.at(i));
+        }
+
+        if(!query.exec())
+        {
+            qWarning() << "exec select aggregates" << query.lastError().text();
+            return false;
+        }
+
+        while(query.next())
+        {
+            const int row = rows.value(query.value(0).toString(), -1);
+            if(row < 0)
+            {
+                continue;
+            }
+
+            for(int column = 0; column < width; column++)
+            {
+                (*values)[row * width + column] = query.value(column + 1).toDouble();
+            }
+        }
+    }
+
+    return true;
+}
+
+int SqlPointListReader::readPointsCount(const ID &item)
+{
+    if(!isOpen())
+    {
+        qWarning() << "database not open";
+        return 0;
+    }
+
+    readPointsCountByID_.bindValue(":id", item);
+
+    if(!readPointsCountByID_.exec())
+    {
+        qWarning() << "exec select points count" << readPointsCountByID_.lastError().text();
+        return 0;
+    }
+
+    const int count = readPointsCountByID_.next() ? readPointsCountByID_.value(0).toInt() : 0;
+    readPointsCountByID_.finish();
+
+    return count;
+}
+
 IDList SqlPointListReader::readAllItems()
 {
     if(isOpen())
@@ -103,6 +370,82 @@ IDList SqlPointListReader::readAllItems()
     return IDList();
 }
 
+IDList SqlPointListReader::readItems(const ID &after, const int limit)
+{
+    if(isOpen())
+    {
+        const bool isFirst = after.isNull();
+        QSqlQuery &query = isFirst ? readFirstPointsIDs_ : readNextPointsIDs_;
+
+        if(!isFirst)
+        {
+            query.bindValue(":after", after);
+        }
+        query.bindValue(":limit", limit);
+
+        const bool querySuccess = query.exec();
+
+        if(!querySuccess)
+        {
+            qWarning() << "exec select point ids page" << query.lastError().text();
+            return IDList();
+        }
+
+        IDList items;
+        while(query.next())
+        {
+            items << query.value(0).toString();
+        }
+
+        query.finish();
+
+        return items;
+    }
+    else
+    {
+        qWarning() << "database not open";
+    }
+    return IDList();
+}
+
+bool SqlPointListReader::readRange(const ID &first, const ID &last, IDList *items, QList< QVector<Point> > *values)
+{
+    items->clear();
+    values->clear();
+
+    if(!isOpen())
+    {
+        qWarning() << "database not open";
+        return false;
+    }
+
+    readPointsByRange_.bindValue(":first", first);
+    readPointsByRange_.bindValue(":last", last);
+
+    if(!readPointsByRange_.exec())
+    {
+        qWarning() << "exec select points range" << readPointsByRange_.lastError().text();
+        return false;
+    }
+
+    while(readPointsByRange_.next())
+    {
+        const ID item = readPointsByRange_.value(0).toString();
+
+        if(items->isEmpty() || (items->last() != item))
+        {
+            items->append(item);
+            values->append(QVector<Point>());
+        }
+
+        values->last().append(readPointsByRange_.value(1).toDouble());
+    }
+
+    readPointsByRange_.finish();
+
+    return true;
+}
+
 void SqlPointListReader::appendStatistics(AbstractStatictics *statistics)
 {
     statisticsCollection.append(statistics);
@@ -119,9 +462,59 @@ PointListStorageStatistics SqlPointListReader::statistics()
 
     foreach(AbstractStatictics *s, statisticsCollection)
     {
+        // on the connection of the reader, so a cloned reader computes them in its own thread
+        if(!s->isOpen())
+        {
+            s->setConnectionName(connectionName());
+            s->setReadOnly(isReadOnly());
+        }
+
         s->open(dataBaseName(), tableName());
         storageStatistics << PointListStatistics(s->name(), s->exec());
     }
 
     return storageStatistics;
 }
+
+QString SqlPointListReader::aggregateExpression(const StorageAggregate &aggregate) const
+{
+    const QString value = columnVALUE();
+    const bool isNative = hasAggregateFunctions();
+
+    // without the functions of SqliteAggregateFunctions the non-zero average
+    // falls back to plain SQL and the other ones are computed in memory
+    switch(aggregate.aggregate())
+    {
+    case StorageAggregate::Average: return "AVG(" + value + ")";
+    case StorageAggregate::Count: return "COUNT(*)";
+    case StorageAggregate::Minimum: return "MIN(" + value + ")";
+    case StorageAggregate::Maximum: return "MAX(" + value + ")";
+    case StorageAggregate::AverageIgnoreNull:
+        return isNative ? "nonzero_avg(" + value + ")"
+                        : "COALESCE(SUM(" + value + ") / NULLIF(SUM(" + value + " <> 0), 0), 0)";
+    case StorageAggregate::StandardDeviation:
+        return isNative ? "stddev(" + value + ")" : QString();
+    case StorageAggregate::Median:
+        return isNative ? "median(" + value + ")" : QString();
+    case StorageAggregate::Quantile:
+        return isNative ? "quantile(" + value + ", " + QString::number(aggregate.parameter(), 'g', 17) + ")" : QString();
+    case StorageAggregate::NoAggregate: break;
+    }
+
+    return QString();
+}
+
+SqlPointListReader *SqlPointListReader::clone() const
+{
+    SqlPointListReader* reader = new SqlPointListReader(dataBaseName(), tableName());
+    reader->setConnectionName(uniqueConnectionName());
+    reader->setReadOnly(isReadOnly());
+    reader->setBusyTimeout(busyTimeout());
+
+    if(!reader->open())
+    {
+        qWarning() << "can't open cloned reader for" << dataBaseName();
+    }
+
+    return reader;
+}
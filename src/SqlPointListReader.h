@@ -17,19 +17,45 @@ public:
     bool prepareQueries();
 
     PointList read(const ID &item);
+    QVector<Point> readValues(const ID &item);
+    bool readState(const ID &item, SequenceState *state);
+    bool canAggregate(const StorageAggregateList &aggregates) const;
+    bool readAggregates(const IDList &items, const StorageAggregateList &aggregates, QVector<double> *values);
+    int readPointsCount(const ID &item);
     IDList readAllItems();
+    IDList readItems(const ID &after, const int limit);
+
+    // points of the items from first to last, in id order with one ordered
+    // scan of the index
+    bool readRange(const ID &first, const ID &last, IDList *items, QList< QVector<Point> > *values);
 
     void appendStatistics(AbstractStatictics* statistics);
     void appendStatistics(const StatisticsList& statisticsList);
 
     PointListStorageStatistics statistics();
 
+    SqlPointListReader* clone() const;
+
 private:
     QSqlQuery readPointsByID_;
     QSqlQuery readAllPointsIDs_;
+    QSqlQuery readFirstPointsIDs_;
+    QSqlQuery readNextPointsIDs_;
+    QSqlQuery readStateByID_;
+    QSqlQuery readPointsCountByID_;
+    QSqlQuery readPointsByRange_;
+
+    // false for a read-only database written before the states were stored
+    bool hasStateTable_;
 
     StatisticsList statisticsCollection;
 
+    // ids bound to one aggregate query, below the SQLite host parameter limit
+    static const int itemsPerAggregateQuery_;
+
+    QString aggregateExpression(const StorageAggregate &aggregate) const;
+    bool hasTable(const QString &tableName);
+
 };
 
 #endif // SQLPOINTLISTREADER_H
@@ -1,4 +1,5 @@
 #include "SqlPointListWriter.h"
+#include "Metrics.h"
 
 SqlPointListWriter::SqlPointListWriter(const QString &dataBaseName, const QString &tableName) :
     SqlPointListInterface(dataBaseName, tableName)
@@ -6,16 +7,21 @@ SqlPointListWriter::SqlPointListWriter(const QString &dataBaseName, const QStrin
 
 }
 
-void SqlPointListWriter::write(const PointList &points)
+bool SqlPointListWriter::write(const PointList &points)
 {
+    METRICS_TIMER("writer/write");
+
     if(!points.isValid())
     {
         qWarning() << "Point list do not valid";
-        return ;
+        return false;
     }
 
+    bool isWritten = false;
+
     if(isOpen())
     {
+        isWritten = true;
         dataBase().transaction();
         for(int num = 0; num < points.count(); ++num)
         {
@@ -28,34 +34,44 @@ void SqlPointListWriter::write(const PointList &points)
             if(!querySuccess)
             {
                 qWarning() << "exec insert table" << writePointsByID_.lastError().text();
+                isWritten = false;
                 break;
             }
         }
-        dataBase().commit();
         writePointsByID_.finish();
+        isWritten = dataBase().commit() && isWritten;
+
+        METRICS_COUNT("writer/sequences", 1);
     }
     else
     {
         qWarning() << "database not open";
     }
+
+    return isWritten;
 }
 
-void SqlPointListWriter::write(const SequencePointList &seqPoints)
+bool SqlPointListWriter::write(const SequencePointList &seqPoints)
 {
+    METRICS_TIMER("writer/write");
+
     if(seqPoints.isEmpty())
     {
         qWarning() << "empty SequencePointList";
-        return;
+        return false;
     }
 
     if(!seqPoints.isValid())
     {
         qWarning() << "not valid SequencePointList";
-        return;
+        return false;
     }
 
+    bool isWritten = false;
+
     if(isOpen())
     {
+        isWritten = true;
         dataBase().transaction();
         for(int i = 0; i < seqPoints.count(); i++){
             for(int num = 0; num < seqPoints.at(i).count(); ++num)
@@ -69,17 +85,183 @@ void SqlPointListWriter::write(const SequencePointList &seqPoints)
                 if(!querySuccess)
                 {
                     qWarning() << "exec insert table" << writePointsByID_.lastError().text();
+                    isWritten = false;
                     break;
                 }
             }
         }
-        dataBase().commit();
         writePointsByID_.finish();
+        isWritten = dataBase().commit() && isWritten;
+
+        METRICS_COUNT("writer/sequences", seqPoints.count());
     }
     else
     {
         qWarning() << "database not open";
     }
+
+    return isWritten;
+}
+
+bool SqlPointListWriter::replace(const SequencePointList &seqPoints)
+{
+    METRICS_TIMER("writer/write");
+
+    if(!seqPoints.isValid())
+    {
+        qWarning() << "not valid SequencePointList";
+        return false;
+    }
+
+    if(!isOpen())
+    {
+        qWarning() << "database not open";
+        return false;
+    }
+
+    dataBase().transaction();
+
+    for(int i = 0; i < seqPoints.count(); i++)
+    {
+        const PointList &points = seqPoints.at(i);
+
+        deletePointsByID_.bindValue(":id", points.id());
+        deleteStateByID_.bindValue(":id", points.id());
+
+        if(!deletePointsByID_.exec() || !deleteStateByID_.exec())
+        {
+            qWarning() << "exec delete sequence" << deletePointsByID_.lastError().text()
+                       << deleteStateByID_.lastError().text();
+            deletePointsByID_.finish();
+            deleteStateByID_.finish();
+            dataBase().rollback();
+            return false;
+        }
+
+        for(int num = 0; num < points.count(); ++num)
+        {
+            writePointsByID_.bindValue(":id", points.id());
+            writePointsByID_.bindValue(":num", num);
+            writePointsByID_.bindValue(":value", points.at(num));
+
+            if(!writePointsByID_.exec())
+            {
+                qWarning() << "exec insert table" << writePointsByID_.lastError().text();
+                writePointsByID_.finish();
+                dataBase().rollback();
+                return false;
+            }
+        }
+    }
+    deletePointsByID_.finish();
+    deleteStateByID_.finish();
+    writePointsByID_.finish();
+
+    if(!dataBase().commit())
+    {
+        qWarning() << "commit sequences" << dataBase().lastError().text();
+        return false;
+    }
+
+    METRICS_COUNT("writer/sequences", seqPoints.count());
+
+    return true;
+}
+
+bool SqlPointListWriter::append(const ID &id, const QVector<Point> &points)
+{
+    if(!isOpen())
+    {
+        qWarning() << "database not open";
+        return false;
+    }
+
+    dataBase().transaction();
+
+    SequenceState state;
+    if(!readState(id, &state))
+    {
+        dataBase().rollback();
+        return false;
+    }
+
+    for(int i = 0; i < points.count(); ++i)
+    {
+        writePointsByID_.bindValue(":id", id);
+        writePointsByID_.bindValue(":num", state.count() + i);
+        writePointsByID_.bindValue(":value", points.at(i));
+
+        if(!writePointsByID_.exec())
+        {
+            qWarning() << "exec insert table" << writePointsByID_.lastError().text();
+            writePointsByID_.finish();
+            dataBase().rollback();
+            return false;
+        }
+    }
+    writePointsByID_.finish();
+
+    state.append(points.constData(), points.count());
+
+    writeStateByID_.bindValue(":id", id);
+    writeStateByID_.bindValue(":state", state.toByteArray());
+
+    if(!writeStateByID_.exec())
+    {
+        qWarning() << "exec insert state" << writeStateByID_.lastError().text();
+        writeStateByID_.finish();
+        dataBase().rollback();
+        return false;
+    }
+    writeStateByID_.finish();
+
+    dataBase().commit();
+    return true;
+}
+
+bool SqlPointListWriter::readState(const ID &id, SequenceState *state)
+{
+    readStateByID_.bindValue(":id", id);
+
+    if(!readStateByID_.exec())
+    {
+        qWarning() << "exec select state" << readStateByID_.lastError().text();
+        return false;
+    }
+
+    const bool isStored = readStateByID_.next();
+    const QByteArray data = isStored ? readStateByID_.value(0).toByteArray() : QByteArray();
+    readStateByID_.finish();
+
+    bool isRead = false;
+    if(isStored)
+    {
+        *state = SequenceState::fromByteArray(data, &isRead);
+    }
+
+    if(isRead)
+    {
+        return true;
+    }
+
+    // the sequence was written without a state, it is built from the points once
+    readPointsByID_.bindValue(":id", id);
+
+    if(!readPointsByID_.exec())
+    {
+        qWarning() << "exec select point" << readPointsByID_.lastError().text();
+        return false;
+    }
+
+    QVector<Point> values;
+    while(readPointsByID_.next())
+    {
+        values.append(readPointsByID_.value(0).toDouble());
+    }
+    readPointsByID_.finish();
+
+    *state = SequenceState::fromPoints(values);
+    return true;
 }
 
 bool SqlPointListWriter::prepareQueries()
@@ -93,6 +275,49 @@ bool SqlPointListWriter::prepareQueries()
         return false;
     }
 
+    readPointsByID_ = QSqlQuery(dataBase());
+    readPointsByID_.setForwardOnly(true);
+    readPointsByID_.prepare("SELECT " + columnVALUE() + " FROM " + tableName()
+                            + " WHERE " + columnID() + " = :id ORDER BY " + columnNUM());
+    if(readPointsByID_.lastError().text() != " ")
+    {
+        qWarning() << "prepare select points" << readPointsByID_.lastError().text();
+        return false;
+    }
+
+    readStateByID_ = QSqlQuery(dataBase());
+    readStateByID_.setForwardOnly(true);
+    readStateByID_.prepare("SELECT " + columnSTATE() + " FROM " + stateTableName() + " WHERE " + columnID() + " = :id");
+    if(readStateByID_.lastError().text() != " ")
+    {
+        qWarning() << "prepare select state" << readStateByID_.lastError().text();
+        return false;
+    }
+
+    writeStateByID_ = QSqlQuery(dataBase());
+    writeStateByID_.prepare("INSERT OR REPLACE INTO " + stateTableName() + " VALUES(:id, :state)");
+    if(writeStateByID_.lastError().text() != " ")
+    {
+        qWarning() << "prepare insert state" << writeStateByID_.lastError().text();
+        return false;
+    }
+
+    deletePointsByID_ = QSqlQuery(dataBase());
+    deletePointsByID_.prepare("DELETE FROM " + tableName() + " WHERE " + columnID() + " = :id");
+    if(deletePointsByID_.lastError().text() != " ")
+    {
+        qWarning() << "prepare delete points" << deletePointsByID_.lastError().text();
+        return false;
+    }
+
+    deleteStateByID_ = QSqlQuery(dataBase());
+    deleteStateByID_.prepare("DELETE FROM " + stateTableName() + " WHERE " + columnID() + " = :id");
+    if(deleteStateByID_.lastError().text() != " ")
+    {
+        qWarning() << "prepare delete state" << deleteStateByID_.lastError().text();
+        return false;
+    }
+
 
     return true;
 }
@@ -10,14 +10,28 @@ class SqlPointListWriter : public SqlPointListInterface
 public:
     SqlPointListWriter(const QString &dataBaseName, const QString& tableName);
 
-    void write(const PointList &points);
-    void write(const SequencePointList &seqPoints);
+    // false when a point isn't stored, e.g. the sequence already exists
+    bool write(const PointList &points);
+    bool write(const SequencePointList &seqPoints);
 
+    // stores the sequences in place of the points and states of the same ids
+    // in one transaction, an empty sequence only removes the old one
+    bool replace(const SequencePointList &seqPoints);
+
+    // appends points to the end of the sequence and updates its stored state
+    bool append(const ID &id, const QVector<Point> &points);
 
     bool prepareQueries();
 
 private:
     QSqlQuery writePointsByID_;
+    QSqlQuery readPointsByID_;
+    QSqlQuery readStateByID_;
+    QSqlQuery writeStateByID_;
+    QSqlQuery deletePointsByID_;
+    QSqlQuery deleteStateByID_;
+
+    bool readState(const ID &id, SequenceState *state);
 };
 
 #endif // SQLPOINTLISTWRITER_H
@@ -0,0 +1,237 @@
+#include "SqliteAggregateFunctions.h"
+
+#include <QSqlDriver>
+#include <QSqlQuery>
+#include <QVariant>
+#include <QDebug>
+
+#ifdef SQLITE_FUNCTIONS
+
+#include <sqlite3.h>
+
+#include "PercentileAnalysis.h"
+
+namespace
+{
+
+struct DeviationContext
+{
+    sqlite3_int64 count;
+    double mean;
+    double squares;
+};
+
+struct NonZeroContext
+{
+    double sum;
+    sqlite3_int64 nonZero;
+};
+
+// the points are collected for the selection in the final step
+struct PointsContext
+{
+    QVector<Point> *points;
+    double parameter;
+};
+
+void deviationStep(sqlite3_context *context, int argc, sqlite3_value **argv)
+{
+    Q_UNUSED(argc);
+
+    if(sqlite3_value_type(argv[0]) == SQLITE_NULL)
+    {
+        return;
+    }
+
+    DeviationContext *deviation = static_cast<DeviationContext*>(sqlite3_aggregate_context(context, sizeof(DeviationContext)));
+    if(deviation == 0)
+    {
+        sqlite3_result_error_nomem(context);
+        return;
+    }
+
+    const double value = sqlite3_value_double(argv[0]);
+
+    deviation->count++;
+    const double delta = value - deviation->mean;
+    deviation->mean += delta / deviation->count;
+    deviation->squares += delta * (value - deviation->mean);
+}
+
+void deviationFinal(sqlite3_context *context)
+{
+    const DeviationContext *deviation = static_cast<DeviationContext*>(sqlite3_aggregate_context(context, 0));
+
+    if((deviation == 0) || (deviation->count < 2))
+    {
+        sqlite3_result_double(context, 0.0);
+        return;
+    }
+
+    sqlite3_result_double(context, qSqrt(deviation->squares / (deviation->count - 1.0)));
+}
+
+void nonZeroStep(sqlite3_context *context, int argc, sqlite3_value **argv)
+{
+    Q_UNUSED(argc);
+
+    if(sqlite3_value_type(argv[0]) == SQLITE_NULL)
+    {
+        return;
+    }
+
+    NonZeroContext *nonZero = static_cast<NonZeroContext*>(sqlite3_aggregate_context(context, sizeof(NonZeroContext)));
+    if(nonZero == 0)
+    {
+        sqlite3_result_error_nomem(context);
+        return;
+    }
+
+    const double value = sqlite3_value_double(argv[0]);
+
+    nonZero->sum += value;
+    nonZero->nonZero += (value != 0.0) ? 1 : 0;
+}
+
+void nonZeroFinal(sqlite3_context *context)
+{
+    const NonZeroContext *nonZero = static_cast<NonZeroContext*>(sqlite3_aggregate_context(context, 0));
+
+    if((nonZero == 0) || (nonZero->nonZero == 0))
+    {
+        sqlite3_result_double(context, 0.0);
+        return;
+    }
+
+    sqlite3_result_double(context, nonZero->sum / static_cast<double>(nonZero->nonZero));
+}
+
+void pointsStep(sqlite3_context *context, int argc, sqlite3_value **argv)
+{
+    if(sqlite3_value_type(argv[0]) == SQLITE_NULL)
+    {
+        return;
+    }
+
+    PointsContext *points = static_cast<PointsContext*>(sqlite3_aggregate_context(context, sizeof(PointsContext)));
+    if(points == 0)
+    {
+        sqlite3_result_error_nomem(context);
+        return;
+    }
+
+    if(points->points == 0)
+    {
+        points->points = new QVector<Point>();
+        points->parameter = (argc > 1) ? sqlite3_value_double(argv[1]) : 0.5;
+    }
+
+    points->points->append(sqlite3_value_double(argv[0]));
+}
+
+// value at position (count - 1) * quantile of the sorted points, interpolated
+// between the two neighbouring ranks like PercentileAnalysis
+void pointsFinal(sqlite3_context *context)
+{
+    PointsContext *points = static_cast<PointsContext*>(sqlite3_aggregate_context(context, 0));
+
+    if((points == 0) || (points->points == 0))
+    {
+        sqlite3_result_double(context, 0.0);
+        return;
+    }
+
+    const QVector<Point> values = *points->points;
+    const double quantile = qBound(0.0, points->parameter, 1.0);
+    delete points->points;
+    points->points = 0;
+
+    const double position = (values.count() - 1) * quantile;
+    const int lowRank = int(qFloor(position));
+    const int highRank = int(qCeil(position));
+
+    QVector<int> ranks;
+    ranks << lowRank;
+    if(highRank != lowRank)
+    {
+        ranks << highRank;
+    }
+
+    const QVector<Point> selected = PercentileAnalysis::orderStatistics(values, ranks);
+    const double low = selected.first();
+    const double high = selected.last();
+
+    sqlite3_result_double(context, low + (position - lowRank) * (high - low));
+}
+
+}
+
+bool SqliteAggregateFunctions::isAvailable()
+{
+    return true;
+}
+
+bool SqliteAggregateFunctions::install(const QSqlDatabase &dataBase)
+{
+    const QVariant handle = dataBase.driver()->handle();
+
+    if(!handle.isValid() || (qstrcmp(handle.typeName(), "sqlite3*") != 0))
+    {
+        qWarning() << "sqlite handle is not accessible, aggregate functions are not installed";
+        return false;
+    }
+
+    sqlite3 *connection = *static_cast<sqlite3* const*>(handle.constData());
+    if(connection == 0)
+    {
+        qWarning() << "sqlite connection is not open, aggregate functions are not installed";
+        return false;
+    }
+
+    // a driver with a bundled SQLite hands out a handle of another library,
+    // the functions of the linked one would corrupt it
+    QSqlQuery query(dataBase);
+    if(!query.exec("SELECT sqlite_version()") || !query.next())
+    {
+        qWarning() << "can't read the sqlite version of the driver, aggregate functions are not installed";
+        return false;
+    }
+
+    const QString driverVersion = query.value(0).toString();
+    if(driverVersion != QString::fromLatin1(sqlite3_libversion()))
+    {
+        qWarning() << "sqlite of the driver" << driverVersion << "is not the linked" << sqlite3_libversion()
+                   << ", aggregate functions are not installed";
+        return false;
+    }
+
+    // median is quantile 0.5, the interpolation averages the two middle points of even counts
+    const bool isInstalled =
+            (sqlite3_create_function(connection, "stddev", 1, SQLITE_UTF8, 0, 0, deviationStep, deviationFinal) == SQLITE_OK)
+            && (sqlite3_create_function(connection, "nonzero_avg", 1, SQLITE_UTF8, 0, 0, nonZeroStep, nonZeroFinal) == SQLITE_OK)
+            && (sqlite3_create_function(connection, "median", 1, SQLITE_UTF8, 0, 0, pointsStep, pointsFinal) == SQLITE_OK)
+            && (sqlite3_create_function(connection, "quantile", 2, SQLITE_UTF8, 0, 0, pointsStep, pointsFinal) == SQLITE_OK);
+
+    if(!isInstalled)
+    {
+        qWarning() << "can't install sqlite aggregate functions" << sqlite3_errmsg(connection);
+    }
+
+    return isInstalled;
+}
+
+#else
+
+bool SqliteAggregateFunctions::isAvailable()
+{
+    return false;
+}
+
+bool SqliteAggregateFunctions::install(const QSqlDatabase &dataBase)
+{
+    Q_UNUSED(dataBase);
+
+    return false;
+}
+
+#endif
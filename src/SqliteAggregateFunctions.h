@@ -0,0 +1,25 @@
+#ifndef SQLITEAGGREGATEFUNCTIONS_H
+
+#define SQLITEAGGREGATEFUNCTIONS_H
+
+#include <QSqlDatabase>
+
+// Aggregate functions registered on the SQLite connections of
+// SqlPointListInterface:
+//   stddev(x)       - as StandardDeviationAnalysis
+//   median(x)       - as MedianAnalysis
+//   quantile(x, p)  - as PercentileAnalysis, p from 0 to 1
+//   nonzero_avg(x)  - as AverageIgnoreNullAnalysis
+// Empty groups give 0 and NULL values are skipped. The functions need the
+// sqlite3 handle of the Qt driver and the sqlite_functions build option,
+// which links the same SQLite library as the driver (Qt built with
+// -system-sqlite); install() compares the versions of both. Without them
+// install() fails and the callers keep computing these values in memory.
+class SqliteAggregateFunctions
+{
+public:
+    static bool isAvailable();
+    static bool install(const QSqlDatabase &dataBase);
+};
+
+#endif // SQLITEAGGREGATEFUNCTIONS_H
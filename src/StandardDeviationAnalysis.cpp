@@ -22,21 +22,53 @@ double StandardDeviationAnalysis::analyze(const PointList &values) const
         return 0.0;
     }
 
-    AverageAnalysis averageAnalysis;
-    double average = averageAnalysis.analyze(values);
+    const QVector<Point> points = values.toVector();
 
-    double sum = 0;
-    foreach(Point value, values.points())
+    if(ParallelPoints::isParallel(points.count()))
     {
-        sum += qPow(value - average, 2.0);
+        return ParallelPoints::accumulate(points).standardDeviation();
     }
 
+    const double average = PointKernels::sum(points) / static_cast<double>(values.count());
+    const double sum = PointKernels::sumOfSquares(points, average);
+
     double result = sum / (values.count() - 1.0);
     result = qSqrt(result);
 
     return result;
 }
 
+SequenceBatch::Statistic StandardDeviationAnalysis::batchStatistic() const
+{
+    return SequenceBatch::StandardDeviation;
+}
+
+bool StandardDeviationAnalysis::isIncremental() const
+{
+    return true;
+}
+
+void StandardDeviationAnalysis::analyzeState(const SequenceState &state, double *outputs) const
+{
+    outputs[0] = state.accumulator().standardDeviation();
+}
+
+StorageAggregateList StandardDeviationAnalysis::storageAggregates() const
+{
+    return StorageAggregateList() << StorageAggregate::StandardDeviation;
+}
+
+int StandardDeviationAnalysis::intermediates() const
+{
+    return AnalysisIntermediates::SumOfSquares;
+}
+
+void StandardDeviationAnalysis::analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const
+{
+    const int count = intermediates.count();
+    outputs[0] = (count < 2) ? 0.0 : qSqrt(intermediates.sumOfSquares() / (count - 1.0));
+}
+
 StandardDeviationAnalysis *StandardDeviationAnalysis::clone()
 {
     return  new StandardDeviationAnalysis(*this);
@@ -14,6 +14,12 @@ public:
 
 
     double analyze(const PointList &values) const;
+    SequenceBatch::Statistic batchStatistic() const;
+    bool isIncremental() const;
+    void analyzeState(const SequenceState &state, double *outputs) const;
+    StorageAggregateList storageAggregates() const;
+    int intermediates() const;
+    void analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const;
     StandardDeviationAnalysis* clone();
 };
 
@@ -0,0 +1,302 @@
+#ifndef STATICANALYSISSET_H
+
+#define STATICANALYSISSET_H
+
+#include <algorithm>
+
+#include "AbstractAnalysis.h"
+
+// Values shared by the analyses of a StaticAnalysisSet. Only the parts
+// requested by the needs flags of the set are computed.
+class StaticPointContext
+{
+public:
+    enum Needs
+    {
+        NeedsNothing = 0,
+        NeedsSum = 1,
+        NeedsNonZero = 2,
+        NeedsSquares = 4,
+        NeedsMinMax = 8,
+        NeedsSorted = 16
+    };
+
+    StaticPointContext(const double *values, const int count) :
+        values(values),
+        count(count),
+        sum(0.0),
+        nonZero(0),
+        squares(0.0),
+        minimum(0.0),
+        maximum(0.0)
+    {
+    }
+
+    // median of the sorted points with ranks first .. first + length - 1
+    inline double sortedMedian(const int first, const int length) const
+    { return AnalysisIntermediates::sortedMedian(sorted, first, length); }
+
+    const double *values;
+    int count;
+
+    double sum;
+    int nonZero;
+    double squares;
+    double minimum;
+    double maximum;
+    QVector<Point> sorted;
+};
+
+// Analyses for StaticAnalysisSet. They give the same results as the
+// AbstractAnalysis subclasses with the same id.
+class StaticAverage
+{
+public:
+    enum { needs = StaticPointContext::NeedsSum };
+
+    static IDAnalysis id() { return "average";}
+    static double result(const StaticPointContext &context)
+    { return (context.count == 0) ? 0.0 : context.sum / context.count; }
+};
+
+class StaticAverageIgnoreNull
+{
+public:
+    enum { needs = StaticPointContext::NeedsSum | StaticPointContext::NeedsNonZero };
+
+    static IDAnalysis id() { return "average-ignore-null";}
+    static double result(const StaticPointContext &context)
+    { return (context.nonZero == 0) ? 0.0 : context.sum / context.nonZero; }
+};
+
+class StaticStandardDeviation
+{
+public:
+    enum { needs = StaticPointContext::NeedsSum | StaticPointContext::NeedsSquares };
+
+    static IDAnalysis id() { return "standard-deviation";}
+    static double result(const StaticPointContext &context)
+    { return (context.count < 2) ? 0.0 : qSqrt(context.squares / (context.count - 1.0)); }
+};
+
+class StaticMinimum
+{
+public:
+    enum { needs = StaticPointContext::NeedsMinMax };
+
+    static IDAnalysis id() { return "minimum";}
+    static double result(const StaticPointContext &context) { return context.minimum;}
+};
+
+class StaticMaximum
+{
+public:
+    enum { needs = StaticPointContext::NeedsMinMax };
+
+    static IDAnalysis id() { return "maximum";}
+    static double result(const StaticPointContext &context) { return context.maximum;}
+};
+
+class StaticMedian
+{
+public:
+    enum { needs = StaticPointContext::NeedsSorted };
+
+    static IDAnalysis id() { return "median";}
+    static double result(const StaticPointContext &context)
+    { return context.sortedMedian(0, context.count); }
+};
+
+class StaticFirstQuartile
+{
+public:
+    enum { needs = StaticPointContext::NeedsSorted };
+
+    static IDAnalysis id() { return "first-quartile";}
+    static double result(const StaticPointContext &context)
+    { return context.sortedMedian(0, (context.count + 1) / 2); }
+};
+
+class StaticThirdQuartile
+{
+public:
+    enum { needs = StaticPointContext::NeedsSorted };
+
+    static IDAnalysis id() { return "third-quartile";}
+    static double result(const StaticPointContext &context)
+    { return context.sortedMedian(context.count / 2, context.count - context.count / 2); }
+};
+
+class StaticNoAnalysis
+{
+};
+
+// Fixed set of up to eight analyses composed at compile time, e.g.
+// StaticAnalysisSet<StaticAverage, StaticStandardDeviation, StaticMedian>.
+// The needs of all analyses are merged, so the points are walked once for
+// the sums and min/max and sorted at most once; the results are written
+// in template order without virtual calls.
+template<class A1,
+         class A2 = StaticNoAnalysis, class A3 = StaticNoAnalysis, class A4 = StaticNoAnalysis,
+         class A5 = StaticNoAnalysis, class A6 = StaticNoAnalysis, class A7 = StaticNoAnalysis,
+         class A8 = StaticNoAnalysis>
+class StaticAnalysisSet
+{
+    typedef StaticAnalysisSet<A2, A3, A4, A5, A6, A7, A8> Tail;
+
+public:
+    enum
+    {
+        size = 1 + Tail::size,
+        needs = A1::needs | Tail::needs
+    };
+
+    static IDAnalysisList ids()
+    { return IDAnalysisList() << A1::id() << Tail::ids(); }
+
+    static void results(const StaticPointContext &context, double *outputs)
+    {
+        outputs[0] = A1::result(context);
+        Tail::results(context, outputs + 1);
+    }
+
+    static void analyze(const double *values, const int count, double *outputs)
+    {
+        StaticPointContext context(values, count);
+        prepare(context);
+        results(context, outputs);
+    }
+
+    static void analyze(const QVector<Point> &values, double *outputs)
+    { analyze(values.constData(), values.count(), outputs); }
+
+    static void prepare(StaticPointContext &context)
+    {
+        const bool isSum = (needs & (StaticPointContext::NeedsSum | StaticPointContext::NeedsSquares)) != 0;
+        const bool isNonZero = (needs & StaticPointContext::NeedsNonZero) != 0;
+        const bool isMinMax = (needs & StaticPointContext::NeedsMinMax) != 0;
+
+        if(context.count == 0)
+        {
+            return;
+        }
+
+        // one fused pass, the flags are constants and the unused parts are compiled out
+        if(isSum || isNonZero || isMinMax)
+        {
+            double sum = 0.0;
+            int nonZero = 0;
+            double minimum = context.values[0];
+            double maximum = context.values[0];
+
+            for(int i = 0; i < context.count; i++)
+            {
+                const double value = context.values[i];
+
+                if(isSum)
+                {
+                    sum += value;
+                }
+                if(isNonZero)
+                {
+                    nonZero += (value != 0.0) ? 1 : 0;
+                }
+                if(isMinMax)
+                {
+                    minimum = (value < minimum) ? value : minimum;
+                    maximum = (maximum < value) ? value : maximum;
+                }
+            }
+
+            context.sum = sum;
+            context.nonZero = nonZero;
+            context.minimum = minimum;
+            context.maximum = maximum;
+        }
+
+        if(needs & StaticPointContext::NeedsSquares)
+        {
+            context.squares = PointKernels::sumOfSquares(context.values, context.count, context.sum / context.count);
+        }
+
+        if(needs & StaticPointContext::NeedsSorted)
+        {
+            context.sorted = QVector<Point>(context.count);
+            std::copy(context.values, context.values + context.count, context.sorted.begin());
+            std::sort(context.sorted.begin(), context.sorted.end());
+        }
+    }
+};
+
+template<>
+class StaticAnalysisSet<StaticNoAnalysis>
+{
+public:
+    enum
+    {
+        size = 0,
+        needs = StaticPointContext::NeedsNothing
+    };
+
+    static IDAnalysisList ids() { return IDAnalysisList();}
+    static void results(const StaticPointContext &context, double *outputs) {}
+};
+
+// StaticAnalysisSet as an analysis with one output per analysis of the set,
+// so a fixed set can be added to AnalysisCollection and AnalysisTableModel.
+template<class Set>
+class StaticAnalysisAdapter : public AbstractAnalysis
+{
+public:
+    StaticAnalysisAdapter() :
+        AbstractAnalysis("static-" + QStringList(Set::ids()).join("-"))
+    {
+    }
+
+    StaticAnalysisAdapter(const StaticAnalysisAdapter &a) :
+        AbstractAnalysis(a.id())
+    {
+    }
+
+    // first analysis of the set
+    double analyze(const PointList &values) const
+    {
+        double outputs[Set::size];
+        analyzeOutputs(values, outputs);
+
+        return outputs[0];
+    }
+
+    StaticAnalysisAdapter* clone()
+    {
+        return new StaticAnalysisAdapter(*this);
+    }
+
+    int outputCount() const
+    {
+        return Set::size;
+    }
+
+    IDAnalysisList outputIDs() const
+    {
+        return Set::ids();
+    }
+
+    void analyzeOutputs(const PointList &values, double *outputs) const
+    {
+        Set::analyze(values.toVector(), outputs);
+    }
+
+    // the set computes its own intermediates from the points
+    int intermediates() const
+    {
+        return AnalysisIntermediates::NoIntermediates;
+    }
+
+    void analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const
+    {
+        Set::analyze(intermediates.values(), outputs);
+    }
+};
+
+#endif // STATICANALYSISSET_H
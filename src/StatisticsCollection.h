@@ -3,6 +3,7 @@
 #define STATISTICSCOLLECTION_H
 
 #include "SqlPointListInterface.h"
+#include "Metrics.h"
 
 class AbstractStatictics : public SqlPointListInterface
 {
@@ -39,6 +40,8 @@ public:
 
     QVariant exec()
     {
+        METRICS_TIMER("statistics/query");
+
         if(isOpen())
         {
             if(query_.exec())
@@ -497,5 +500,28 @@ protected:
 };
 
 
+// every storage statistic, the caller owns the list
+inline StatisticsList allStatistics()
+{
+    StatisticsList statisticsList;
+    statisticsList << new MaxSequenceLengthIdStatistics
+                   << new MaxSequenceLengthStatistics
+                   << new FiveTopSequenceLengthStatistics
+                   << new MinSequenceLengthIdStatistics
+                   << new MinSequenceLengthStatistics
+                   << new AverageSequenceLengthStatistics
+                   << new AverageNullCountPointsStatistics
+                   << new AverageNoneNullCountPointsStatistics
+                   << new PercentNullCountPointsStatistics
+                   << new PercentNoneNullCountPointsStatistics
+                   << new MaxPointStatistics
+                   << new MinPointStatistics
+                   << new FiveTopPointsValueStatistics
+                   << new SequenceWithRepeatCountStatistics
+                   << new IncSequenceCountStatistics
+                   << new DecSequenceCountStatistics;
+
+    return statisticsList;
+}
 
 #endif // STATISTICSCOLLECTION_H
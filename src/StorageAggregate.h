@@ -0,0 +1,43 @@
+#ifndef STORAGEAGGREGATE_H
+
+#define STORAGEAGGREGATE_H
+
+#include <QtCore>
+
+// Per sequence aggregates a point storage computes itself, so the points
+// are not read into memory. Each aggregate gives the same value as the
+// analysis declaring it, empty sequences give 0.
+class StorageAggregate
+{
+public:
+    enum Aggregate
+    {
+        NoAggregate,
+        Average,
+        Count,
+        Minimum,
+        Maximum,
+        AverageIgnoreNull,
+        StandardDeviation,
+        Median,
+        Quantile
+    };
+
+    // parameter is the quantile from 0 to 1, unused by the other aggregates
+    StorageAggregate(const Aggregate aggregate = NoAggregate, const double parameter = 0.0) :
+        aggregate_(aggregate),
+        parameter_(parameter)
+    {
+    }
+
+    inline Aggregate aggregate() const { return aggregate_;}
+    inline double parameter() const { return parameter_;}
+
+private:
+    Aggregate aggregate_;
+    double parameter_;
+};
+
+typedef QList<StorageAggregate> StorageAggregateList;
+
+#endif // STORAGEAGGREGATE_H
@@ -0,0 +1,158 @@
+#include "StorageLoader.h"
+
+#include <QFile>
+
+#include "SqlPointListWriter.h"
+#include "Metatypes.h"
+
+const int StorageLoader::defaultPageSize_ = 1000;
+
+StorageLoader::StorageLoader(const QString &dataBaseName, const QString &tableName, QObject *parent) :
+    QThread(parent),
+    dataBaseName_(dataBaseName),
+    tableName_(tableName),
+    generatedSequences_(0),
+    pageSize_(defaultPageSize_),
+    statisticsLoaded_(false)
+{
+    qRegisterMetaType<IDList>("IDList");
+    qRegisterMetaType<PointListStorageStatistics>("PointListStorageStatistics");
+}
+
+StorageLoader::~StorageLoader()
+{
+    wait();
+}
+
+int StorageLoader::generatedSequences() const
+{
+    return generatedSequences_;
+}
+
+void StorageLoader::setGeneratedSequences(const int count)
+{
+    generatedSequences_ = qMax(0, count);
+}
+
+int StorageLoader::pageSize() const
+{
+    return pageSize_;
+}
+
+void StorageLoader::setPageSize(const int pageSize)
+{
+    if(pageSize < 1)
+    {
+        qWarning() << "Page size must be more than zero";
+        return;
+    }
+
+    pageSize_ = pageSize;
+}
+
+bool StorageLoader::isStatisticsLoaded() const
+{
+    QMutexLocker locker(&mutex_);
+    return statisticsLoaded_;
+}
+
+PointListStorageStatistics StorageLoader::statistics() const
+{
+    QMutexLocker locker(&mutex_);
+    return statistics_;
+}
+
+void StorageLoader::load()
+{
+    wait();
+
+    {
+        QMutexLocker locker(&mutex_);
+        statisticsLoaded_ = false;
+        statistics_ = PointListStorageStatistics();
+    }
+
+    start(QThread::LowPriority);
+}
+
+void StorageLoader::run()
+{
+    if(generatedSequences_ > 0)
+    {
+        const bool isGenerated = generate();
+        generatedSequences_ = 0;
+
+        if(!isGenerated)
+        {
+            emit loadFailed();
+            return;
+        }
+    }
+
+    if(!QFile::exists(dataBaseName_))
+    {
+        qWarning() << "database" << dataBaseName_ << "not exists";
+        emit loadFailed();
+        return;
+    }
+
+    SqlPointListReader reader(dataBaseName_, tableName_);
+    reader.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+    reader.setReadOnly(true);
+
+    if(!reader.open())
+    {
+        qWarning() << "can't open loader reader for" << dataBaseName_;
+        emit loadFailed();
+        return;
+    }
+
+    emit itemsLoaded(reader.readItems(ID(), pageSize_));
+
+    reader.appendStatistics(allStatistics());
+    const PointListStorageStatistics statistics = reader.statistics();
+
+    {
+        QMutexLocker locker(&mutex_);
+        statistics_ = statistics;
+        statisticsLoaded_ = true;
+    }
+
+    emit statisticsLoaded(statistics);
+}
+
+bool StorageLoader::generate()
+{
+    if(QFile::exists(dataBaseName_))
+    {
+        if(!QFile::remove(dataBaseName_))
+        {
+            qWarning() << "can't remove database" << dataBaseName_;
+            return false;
+        }
+    }
+
+    const QString connectionName = SqlPointListInterface::uniqueConnectionName();
+    bool isOpened = false;
+
+    {
+        SqlPointListWriter writer(dataBaseName_, tableName_);
+        writer.setConnectionName(connectionName);
+        isOpened = writer.open();
+
+        if(isOpened)
+        {
+            SequencePointList sequences;
+            for(int i = 0; i < generatedSequences_; i++)
+            {
+                sequences.append(PointList(QString("id%1").arg(i)) << Point(0));
+            }
+
+            writer.write(sequences);
+        }
+    }
+
+    QSqlDatabase::removeDatabase(connectionName);
+
+    return isOpened;
+}
@@ -0,0 +1,59 @@
+#ifndef STORAGELOADER_H
+
+#define STORAGELOADER_H
+
+#include <QThread>
+#include <QMutex>
+
+#include "SqlPointListReader.h"
+#include "PointListStorageStatistics.h"
+
+// Opens a database in its own thread and connection, so a window is shown
+// before the storage is touched: the first page of items is delivered by
+// itemsLoaded() and the storage statistics, which scan the whole table,
+// later by statisticsLoaded(). The database is opened read-only unless
+// sequences are generated into it first.
+class StorageLoader : public QThread
+{
+    Q_OBJECT
+public:
+    StorageLoader(const QString &dataBaseName, const QString &tableName, QObject *parent = 0);
+    ~StorageLoader();
+
+    // sequences written to a new database by the next load(), 0 loads the existing one
+    int generatedSequences() const;
+    void setGeneratedSequences(const int count);
+
+    int pageSize() const;
+    void setPageSize(const int pageSize);
+
+    bool isStatisticsLoaded() const;
+    PointListStorageStatistics statistics() const;
+
+    void load();
+
+signals:
+    void itemsLoaded(const IDList &firstPage);
+    void statisticsLoaded(const PointListStorageStatistics &statistics);
+    void loadFailed();
+
+protected:
+    void run();
+
+private:
+    const QString dataBaseName_;
+    const QString tableName_;
+
+    int generatedSequences_;
+    int pageSize_;
+
+    mutable QMutex mutex_;
+    bool statisticsLoaded_;
+    PointListStorageStatistics statistics_;
+
+    static const int defaultPageSize_;
+
+    bool generate();
+};
+
+#endif // STORAGELOADER_H
@@ -26,6 +26,26 @@ double StupidAnalysis::analyze(const PointList &list) const
     return value_;
 }
 
+bool StupidAnalysis::isIncremental() const
+{
+    return true;
+}
+
+void StupidAnalysis::analyzeState(const SequenceState &state, double *outputs) const
+{
+    outputs[0] = value_;
+}
+
+int StupidAnalysis::intermediates() const
+{
+    return AnalysisIntermediates::NoIntermediates;
+}
+
+void StupidAnalysis::analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const
+{
+    outputs[0] = value_;
+}
+
 StupidAnalysis *StupidAnalysis::clone()
 {
     return new StupidAnalysis(*this);
@@ -12,6 +12,10 @@ public:
     StupidAnalysis(const StupidAnalysis &a);
 
     double analyze(const PointList &list) const;
+    bool isIncremental() const;
+    void analyzeState(const SequenceState &state, double *outputs) const;
+    int intermediates() const;
+    void analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const;
     StupidAnalysis* clone();
 
 
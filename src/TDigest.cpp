@@ -0,0 +1,252 @@
+#include "TDigest.h"
+
+#include <algorithm>
+
+const double TDigest::defaultCompression = 100.0;
+
+TDigest::TDigest(const double compression) :
+    compression_(qMax(compression, 10.0)),
+    minimum_(0.0),
+    maximum_(0.0),
+    totalWeight_(0.0),
+    bufferWeight_(0.0)
+{
+}
+
+TDigest TDigest::fromPoints(const double *values, const int count, const double compression)
+{
+    TDigest digest(compression);
+    digest.add(values, count);
+    return digest;
+}
+
+void TDigest::add(const double value, const double weight)
+{
+    if(weight <= 0.0)
+    {
+        return;
+    }
+
+    if(isEmpty())
+    {
+        minimum_ = value;
+        maximum_ = value;
+    }
+    else
+    {
+        minimum_ = qMin(minimum_, value);
+        maximum_ = qMax(maximum_, value);
+    }
+
+    buffer_.append(TDigestCentroid(value, weight));
+    bufferWeight_ += weight;
+
+    if(buffer_.count() >= bufferLimit())
+    {
+        compress();
+    }
+}
+
+void TDigest::add(const double *values, const int count)
+{
+    for(int i = 0; i < count; i++)
+    {
+        add(values[i]);
+    }
+}
+
+void TDigest::merge(const TDigest &other)
+{
+    if(other.isEmpty())
+    {
+        return;
+    }
+
+    other.compress();
+
+    foreach(const TDigestCentroid& centroid, other.centroids_)
+    {
+        add(centroid.mean, centroid.weight);
+    }
+
+    // the centroid means lie inside, but the extremes may not be centroids
+    minimum_ = qMin(minimum_, other.minimum_);
+    maximum_ = qMax(maximum_, other.maximum_);
+}
+
+double TDigest::quantile(const double q) const
+{
+    if(isEmpty())
+    {
+        return 0.0;
+    }
+
+    compress();
+
+    if(q <= 0.0)
+    {
+        return minimum_;
+    }
+
+    if(q >= 1.0)
+    {
+        return maximum_;
+    }
+
+    // the points are interpolated linearly between the centroid centers,
+    // the minimum and maximum are the knots at both ends
+    const double index = q * totalWeight_;
+
+    double previousPosition = 0.0;
+    double previousValue = minimum_;
+    double weightSoFar = 0.0;
+
+    for(int i = 0; i < centroids_.count(); i++)
+    {
+        const TDigestCentroid &centroid = centroids_.at(i);
+        const double position = weightSoFar + centroid.weight / 2.0;
+
+        if(index < position)
+        {
+            const double fraction = (index - previousPosition) / (position - previousPosition);
+            return previousValue + fraction * (centroid.mean - previousValue);
+        }
+
+        previousPosition = position;
+        previousValue = centroid.mean;
+        weightSoFar += centroid.weight;
+    }
+
+    if(totalWeight_ <= previousPosition)
+    {
+        return maximum_;
+    }
+
+    const double fraction = (index - previousPosition) / (totalWeight_ - previousPosition);
+    return previousValue + fraction * (maximum_ - previousValue);
+}
+
+int TDigest::centroidCount() const
+{
+    compress();
+    return centroids_.count();
+}
+
+QVector<TDigestCentroid> TDigest::centroids() const
+{
+    compress();
+    return centroids_;
+}
+
+void TDigest::compress() const
+{
+    if(buffer_.isEmpty())
+    {
+        return;
+    }
+
+    QVector<TDigestCentroid> sorted = centroids_;
+    sorted << buffer_;
+    std::sort(sorted.begin(), sorted.end());
+
+    const double totalWeight = totalWeight_ + bufferWeight_;
+
+    QVector<TDigestCentroid> merged;
+    merged.reserve(int(compression_) * 2);
+
+    TDigestCentroid current = sorted.first();
+    double weightSoFar = 0.0;
+    double weightLimit = totalWeight * inverseScale(scale(0.0) + 1.0);
+
+    for(int i = 1; i < sorted.count(); i++)
+    {
+        const TDigestCentroid &next = sorted.at(i);
+
+        if(weightSoFar + current.weight + next.weight <= weightLimit)
+        {
+            current.weight += next.weight;
+            current.mean += (next.mean - current.mean) * next.weight / current.weight;
+            continue;
+        }
+
+        weightSoFar += current.weight;
+        merged.append(current);
+
+        weightLimit = totalWeight * inverseScale(scale(weightSoFar / totalWeight) + 1.0);
+        current = next;
+    }
+
+    merged.append(current);
+
+    centroids_ = merged;
+    totalWeight_ = totalWeight;
+
+    buffer_.clear();
+    bufferWeight_ = 0.0;
+}
+
+int TDigest::bufferLimit() const
+{
+    return int(compression_) * 5;
+}
+
+double TDigest::scale(const double q) const
+{
+    return compression_ / (2.0 * M_PI) * qAsin(2.0 * qBound(0.0, q, 1.0) - 1.0);
+}
+
+double TDigest::inverseScale(const double k) const
+{
+    const double angle = qBound(-M_PI / 2.0, k * 2.0 * M_PI / compression_, M_PI / 2.0);
+    return (qSin(angle) + 1.0) / 2.0;
+}
+
+QDataStream &operator<<(QDataStream &stream, const TDigest &digest)
+{
+    digest.compress();
+
+    stream << digest.compression_
+           << digest.minimum_
+           << digest.maximum_
+           << qint32(digest.centroids_.count());
+
+    foreach(const TDigestCentroid& centroid, digest.centroids_)
+    {
+        stream << centroid.mean << centroid.weight;
+    }
+
+    return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, TDigest &digest)
+{
+    double compression;
+    double minimum;
+    double maximum;
+    qint32 count;
+
+    stream >> compression >> minimum >> maximum >> count;
+
+    TDigest result(compression);
+
+    for(qint32 i = 0; (i < count) && (stream.status() == QDataStream::Ok); i++)
+    {
+        TDigestCentroid centroid;
+        stream >> centroid.mean >> centroid.weight;
+
+        result.centroids_.append(centroid);
+        result.totalWeight_ += centroid.weight;
+    }
+
+    if(stream.status() != QDataStream::Ok)
+    {
+        qWarning() << "can't read t-digest";
+        return stream;
+    }
+
+    result.minimum_ = minimum;
+    result.maximum_ = maximum;
+
+    digest = result;
+    return stream;
+}
@@ -0,0 +1,81 @@
+#ifndef TDIGEST_H
+
+#define TDIGEST_H
+
+#include <QtCore>
+
+class TDigestCentroid
+{
+public:
+    TDigestCentroid() :
+        mean(0.0),
+        weight(0.0)
+    {
+    }
+
+    TDigestCentroid(const double mean, const double weight) :
+        mean(mean),
+        weight(weight)
+    {
+    }
+
+    inline bool operator<(const TDigestCentroid &other) const { return mean < other.mean;}
+
+    double mean;
+    double weight;
+};
+
+// Merging t-digest (Dunning, Ertl) with the arcsine scale function.
+// Memory depends only on the compression: about compression centroids
+// plus a buffer of unmerged points. Quantile error is smallest near the
+// tails, so p99 stays accurate over billions of points. Digests of chunks
+// or shards are merged with merge() and stored with QDataStream.
+class TDigest
+{
+public:
+    TDigest(const double compression = defaultCompression);
+
+    static TDigest fromPoints(const double *values, const int count, const double compression = defaultCompression);
+
+    inline double compression() const { return compression_;}
+    inline double count() const { return totalWeight_ + bufferWeight_;}
+    inline bool isEmpty() const { return count() == 0.0;}
+
+    inline double minimum() const { return minimum_;}
+    inline double maximum() const { return maximum_;}
+
+    void add(const double value, const double weight = 1.0);
+    void add(const double *values, const int count);
+    void merge(const TDigest &other);
+
+    double quantile(const double q) const;
+
+    int centroidCount() const;
+    QVector<TDigestCentroid> centroids() const;
+
+    static const double defaultCompression;
+
+private:
+    double compression_;
+    double minimum_;
+    double maximum_;
+
+    mutable QVector<TDigestCentroid> centroids_;
+    mutable QVector<TDigestCentroid> buffer_;
+    mutable double totalWeight_;
+    mutable double bufferWeight_;
+
+    void compress() const;
+    int bufferLimit() const;
+
+    double scale(const double q) const;
+    double inverseScale(const double k) const;
+
+    friend QDataStream &operator<<(QDataStream &stream, const TDigest &digest);
+    friend QDataStream &operator>>(QDataStream &stream, TDigest &digest);
+};
+
+QDataStream &operator<<(QDataStream &stream, const TDigest &digest);
+QDataStream &operator>>(QDataStream &stream, TDigest &digest);
+
+#endif // TDIGEST_H
@@ -12,43 +12,29 @@ ThirdQuartileAnalysis::ThirdQuartileAnalysis(const ThirdQuartileAnalysis &a):
 
 double ThirdQuartileAnalysis::analyze(const PointList &values) const
 {
-    QList<Point> sortedList = values.points();
-    qSort(sortedList);
-    const int listCount = sortedList.count();
-
-    if(sortedList.isEmpty())
-    {
-        return 0.0;
-    }
-
-    if(listCount == 1)
+    if(ParallelPoints::isParallel(values.count()))
     {
-        return sortedList.first();
+        const QVector<Point> points = values.toVector();
+        const int first = points.count() / 2;
+        return ParallelPoints::rangeMedian(points, first, points.count() - first);
     }
 
-    const bool even = (listCount % 2 == 0);
-    const int index = listCount / 2;
+    QVector<Point> sortedPoints = values.toVector();
+    qSort(sortedPoints);
 
-    PointList secondPart;
-
-    if(even)
-    {
-        for(int i = index ; i < listCount; i++)
-        {
-            secondPart.append(sortedList.at(i));
-        }
-    }
-    else
-    {
-        for(int i = index; i < listCount; i++)
-        {
-            secondPart.append(sortedList.at(i));
-        }
-    }
+    const int first = sortedPoints.count() / 2;
+    return AnalysisIntermediates::sortedMedian(sortedPoints, first, sortedPoints.count() - first);
+}
 
-    MedianAnalysis median;
+int ThirdQuartileAnalysis::intermediates() const
+{
+    return AnalysisIntermediates::Sorted;
+}
 
-    return median.analyze(secondPart);
+void ThirdQuartileAnalysis::analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const
+{
+    const int first = intermediates.count() / 2;
+    outputs[0] = intermediates.sortedMedian(first, intermediates.count() - first);
 }
 
 ThirdQuartileAnalysis *ThirdQuartileAnalysis::clone()
@@ -2,7 +2,7 @@
 
 #define THIRDQUARTILEANALYSIS_H
 
-#include "MedianAnalysis.h"
+#include "AbstractAnalysis.h"
 
 class ThirdQuartileAnalysis : public AbstractAnalysis
 {
@@ -12,6 +12,8 @@ public:
 
 
     double analyze(const PointList &values) const;
+    int intermediates() const;
+    void analyzeIntermediates(const AnalysisIntermediates &intermediates, double *outputs) const;
     ThirdQuartileAnalysis* clone();
 };
 
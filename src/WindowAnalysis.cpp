@@ -0,0 +1,311 @@
+#include "WindowAnalysis.h"
+
+#include <set>
+
+// total order of the points with NaN after every number, the plain < would
+// lose a NaN in the sets of the moving median
+class PointLessThan
+{
+public:
+    inline bool operator()(const double a, const double b) const
+    {
+        const bool isANan = (a != a);
+        const bool isBNan = (b != b);
+
+        if(isANan || isBNan)
+        {
+            return !isANan && isBNan;
+        }
+
+        return a < b;
+    }
+};
+
+typedef std::multiset<double, PointLessThan> PointMultiset;
+
+WindowAnalysis::WindowAnalysis(const Statistic statistic, const int window) :
+    statistic_(statistic),
+    window_(window)
+{
+    if(window < 1)
+    {
+        qWarning() << "window must contain at least one point:" << window;
+    }
+}
+
+IDAnalysis WindowAnalysis::id() const
+{
+    if(!isValid())
+    {
+        return IDAnalysis();
+    }
+
+    QString name;
+    switch(statistic_)
+    {
+    case Average: name = "average"; break;
+    case StandardDeviation: name = "standard-deviation"; break;
+    case Minimum: name = "minimum"; break;
+    case Maximum: name = "maximum"; break;
+    case Median: name = "median"; break;
+    }
+
+    return QString("moving-%1-%2").arg(name).arg(window_);
+}
+
+bool WindowAnalysis::isValid() const
+{
+    return window_ > 0;
+}
+
+QVector<Point> WindowAnalysis::analyze(const QVector<Point> &values) const
+{
+    if(!isValid() || (values.count() < window_))
+    {
+        return QVector<Point>();
+    }
+
+    switch(statistic_)
+    {
+    case Average: return movingAverage(values, window_);
+    case StandardDeviation: return movingStandardDeviation(values, window_);
+    case Minimum: return movingExtremum(values, window_, true);
+    case Maximum: return movingExtremum(values, window_, false);
+    case Median: return movingMedian(values, window_);
+    }
+
+    return QVector<Point>();
+}
+
+PointList WindowAnalysis::analyze(const PointList &list) const
+{
+    return PointList::fromVector(seriesID(list.id(), id()), analyze(list.toVector()));
+}
+
+SequencePointList WindowAnalysis::analyze(const SequencePointList &sequences) const
+{
+    SequencePointList series;
+
+    for(int i = 0; i < sequences.count(); i++)
+    {
+        series.append(analyze(sequences.at(i)));
+    }
+
+    return series;
+}
+
+ID WindowAnalysis::seriesID(const ID &item, const IDAnalysis &analysis)
+{
+    return item + ":" + analysis;
+}
+
+int WindowAnalysis::writeSeries(AbstractPointListReader *reader, const IDList &items,
+                                const QList<WindowAnalysis> &analyzes, SqlPointListWriter *writer)
+{
+    if(!writer->isOpen())
+    {
+        qWarning() << "database not open";
+        return 0;
+    }
+
+    int written = 0;
+    SequencePointList series;
+
+    foreach(const ID& item, items)
+    {
+        const QVector<Point> values = reader->readValues(item);
+
+        foreach(const WindowAnalysis& analysis, analyzes)
+        {
+            // an empty series still removes the one of an earlier run
+            series.append(PointList::fromVector(seriesID(item, analysis.id()), analysis.analyze(values)));
+        }
+
+        if(series.count() >= sequencesPerWrite_)
+        {
+            written += replaceSeries(series, writer);
+            series.clear();
+        }
+    }
+
+    if(!series.isEmpty())
+    {
+        written += replaceSeries(series, writer);
+    }
+
+    return written;
+}
+
+int WindowAnalysis::replaceSeries(const SequencePointList &series, SqlPointListWriter *writer)
+{
+    if(!writer->replace(series))
+    {
+        return 0;
+    }
+
+    int stored = 0;
+    for(int i = 0; i < series.count(); i++)
+    {
+        stored += series.at(i).isEmpty() ? 0 : 1;
+    }
+
+    return stored;
+}
+
+QVector<Point> WindowAnalysis::movingAverage(const QVector<Point> &values, const int window)
+{
+    const int count = values.count() - window + 1;
+    QVector<Point> result(count);
+
+    double sum = 0.0;
+    for(int i = 0; i < count; i++)
+    {
+        // the sum is recounted once per window, so rounding errors of the
+        // running updates do not build up along the sequence
+        if(i % window == 0)
+        {
+            sum = PointKernels::sum(values.constData() + i, window);
+        }
+        else
+        {
+            sum += values.at(i + window - 1) - values.at(i - 1);
+        }
+
+        result[i] = sum / window;
+    }
+
+    return result;
+}
+
+QVector<Point> WindowAnalysis::movingStandardDeviation(const QVector<Point> &values, const int window)
+{
+    const int count = values.count() - window + 1;
+    QVector<Point> result(count);
+
+    if(window == 1)
+    {
+        return result;
+    }
+
+    double average = 0.0;
+    double squares = 0.0;
+
+    for(int i = 0; i < count; i++)
+    {
+        if(i % window == 0)
+        {
+            const PointAccumulator accumulator = PointAccumulator::fromPoints(values.constData() + i, window);
+            average = accumulator.average();
+            squares = accumulator.variance() * (window - 1);
+        }
+        else
+        {
+            // Welford update for the point entering and the point leaving the window
+            const double entering = values.at(i + window - 1);
+            const double leaving = values.at(i - 1);
+            const double previousAverage = average;
+
+            average += (entering - leaving) / window;
+            squares += (entering - leaving) * (entering - average + leaving - previousAverage);
+        }
+
+        result[i] = qSqrt(qMax(squares, 0.0) / (window - 1));
+    }
+
+    return result;
+}
+
+QVector<Point> WindowAnalysis::movingExtremum(const QVector<Point> &values, const int window, const bool isMinimum)
+{
+    const int count = values.count() - window + 1;
+    QVector<Point> result(count);
+
+    // indices of the points that can still become the extremum, their
+    // values are monotonic from head to tail; every index enters once
+    QVector<int> deque(values.count());
+    int head = 0;
+    int tail = 0;
+
+    for(int i = 0; i < values.count(); i++)
+    {
+        const double value = values.at(i);
+
+        while((tail > head) && (isMinimum ? (values.at(deque.at(tail - 1)) >= value)
+                                          : (values.at(deque.at(tail - 1)) <= value)))
+        {
+            tail--;
+        }
+        deque[tail++] = i;
+
+        if(deque.at(head) <= i - window)
+        {
+            head++;
+        }
+
+        if(i >= window - 1)
+        {
+            result[i - window + 1] = values.at(deque.at(head));
+        }
+    }
+
+    return result;
+}
+
+QVector<Point> WindowAnalysis::movingMedian(const QVector<Point> &values, const int window)
+{
+    const int count = values.count() - window + 1;
+    QVector<Point> result(count);
+
+    // lower half holds (window + 1) / 2 points, every point of it is not
+    // greater than any point of the upper half
+    const PointLessThan lessThan;
+    PointMultiset lower;
+    PointMultiset upper;
+
+    for(int i = 0; i < values.count(); i++)
+    {
+        const double entering = values.at(i);
+        if(lower.empty() || !lessThan(*lower.rbegin(), entering))
+        {
+            lower.insert(entering);
+        }
+        else
+        {
+            upper.insert(entering);
+        }
+
+        if(i >= window)
+        {
+            const double leaving = values.at(i - window);
+            if(!lessThan(*lower.rbegin(), leaving))
+            {
+                lower.erase(lower.find(leaving));
+            }
+            else
+            {
+                upper.erase(upper.find(leaving));
+            }
+        }
+
+        while(lower.size() > upper.size() + 1)
+        {
+            upper.insert(*lower.rbegin());
+            lower.erase(--lower.end());
+        }
+
+        while(lower.size() < upper.size())
+        {
+            lower.insert(*upper.begin());
+            upper.erase(upper.begin());
+        }
+
+        if(i >= window - 1)
+        {
+            result[i - window + 1] = (window % 2 == 1)
+                    ? *lower.rbegin()
+                    : (*lower.rbegin() + *upper.begin()) / 2.0;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,58 @@
+#ifndef WINDOWANALYSIS_H
+
+#define WINDOWANALYSIS_H
+
+#include "AbstractPointListReader.h"
+#include "SqlPointListWriter.h"
+
+// Statistic of every window of window() consecutive points, a sequence of
+// n points gives a series of n - window() + 1 points. The window is updated
+// per point instead of analyzing every window anew: running sums for the
+// average and deviation, a monotonic deque for the minimum and maximum and
+// two balanced halves for the median.
+class WindowAnalysis
+{
+public:
+    enum Statistic
+    {
+        Average,
+        StandardDeviation,
+        Minimum,
+        Maximum,
+        Median
+    };
+
+    WindowAnalysis(const Statistic statistic, const int window);
+
+    inline Statistic statistic() const { return statistic_;}
+    inline int window() const { return window_;}
+
+    IDAnalysis id() const;
+    bool isValid() const;
+
+    QVector<Point> analyze(const QVector<Point> &values) const;
+    PointList analyze(const PointList &list) const;
+    SequencePointList analyze(const SequencePointList &sequences) const;
+
+    // series of item produced by the analysis, e.g. "id7:moving-average-10"
+    static ID seriesID(const ID &item, const IDAnalysis &analysis);
+
+    // reads items and replaces the series of every analysis, the series of
+    // earlier runs included; returns the count of stored non-empty series
+    static int writeSeries(AbstractPointListReader *reader, const IDList &items,
+                           const QList<WindowAnalysis> &analyzes, SqlPointListWriter *writer);
+
+private:
+    Statistic statistic_;
+    int window_;
+
+    static const int sequencesPerWrite_ = 256;
+
+    static int replaceSeries(const SequencePointList &series, SqlPointListWriter *writer);
+    static QVector<Point> movingAverage(const QVector<Point> &values, const int window);
+    static QVector<Point> movingStandardDeviation(const QVector<Point> &values, const int window);
+    static QVector<Point> movingExtremum(const QVector<Point> &values, const int window, const bool isMinimum);
+    static QVector<Point> movingMedian(const QVector<Point> &values, const int window);
+};
+
+#endif // WINDOWANALYSIS_H
@@ -377,3 +377,80 @@ void TAnalysis::TestFirstAndThirdQuartile()
 
     FUZZY_COMPARE(actualThirdQuartileResult, expectedThirdQuartileResult);
 }
+
+void TAnalysis::TestPercentile_data()
+{
+    QTest::addColumn< PointList >("values");
+    QTest::addColumn< QList<Point> >("percentiles");
+    QTest::addColumn< QList<Point> >("result");
+
+    QTest::newRow("empty") << PointList()
+                           << PercentileAnalysis::defaultPercentiles()
+                           << (QList<Point>() << 0.0 << 0.0 << 0.0 << 0.0 << 0.0 << 0.0 << 0.0);
+
+    QTest::newRow("one-value") << (PointList() << Point(26.0))
+                               << (QList<Point>() << 1.0 << 50.0 << 99.0)
+                               << (QList<Point>() << 26.0 << 26.0 << 26.0);
+
+    QTest::newRow("five-value-sorted") << (PointList()
+                                           << Point(1.0)
+                                           << Point(2.0)
+                                           << Point(3.0)
+                                           << Point(4.0)
+                                           << Point(5.0))
+                                       << (QList<Point>() << 0.0 << 25.0 << 50.0 << 100.0)
+                                       << (QList<Point>() << 1.0 << 2.0 << 3.0 << 5.0);
+
+    QTest::newRow("four-value-unsorted") << (PointList()
+                                             << Point(23.0)
+                                             << Point(-5.0)
+                                             << Point(0.0)
+                                             << Point(31.0))
+                                         << (QList<Point>() << 90.0 << 10.0 << 50.0)
+                                         << (QList<Point>() << 28.6 << -3.5 << 11.5);
+
+    QTest::newRow("eleven-value-tails") << (PointList()
+                                            << Point(7.0)
+                                            << Point(2.0)
+                                            << Point(10.0)
+                                            << Point(0.0)
+                                            << Point(5.0)
+                                            << Point(9.0)
+                                            << Point(1.0)
+                                            << Point(4.0)
+                                            << Point(8.0)
+                                            << Point(3.0)
+                                            << Point(6.0))
+                                        << (QList<Point>() << 1.0 << 5.0 << 95.0 << 99.0)
+                                        << (QList<Point>() << 0.1 << 0.5 << 9.5 << 9.9);
+}
+
+void TAnalysis::TestPercentile()
+{
+    QFETCH(PointList, values);
+    QFETCH(QList<Point>, percentiles);
+    QFETCH(QList<Point>, result);
+
+    PercentileAnalysis analysis(percentiles);
+
+    QVERIFY(analysis.isValid());
+    QCOMPARE(analysis.outputCount(), result.count());
+    QCOMPARE(analysis.outputIDs().count(), result.count());
+
+    QVector<double> outputs(analysis.outputCount());
+    analysis.analyzeOutputs(values, outputs.data());
+
+    for(int i = 0; i < result.count(); i++)
+    {
+        FUZZY_COMPARE(outputs.at(i), result.at(i));
+    }
+
+    FUZZY_COMPARE(analysis.analyze(values), result.first());
+
+    // the median output agrees with the median analysis
+    const int median = percentiles.indexOf(50.0);
+    if(median >= 0)
+    {
+        FUZZY_COMPARE(outputs.at(median), MedianAnalysis().analyze(values));
+    }
+}
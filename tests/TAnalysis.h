@@ -10,6 +10,7 @@
 #include "../src/FirstQuartileAnalysis.h"
 #include "../src/ThirdQuartileAnalysis.h"
 #include "../src/MedianAnalysis.h"
+#include "../src/PercentileAnalysis.h"
 
 #include "../src/Metatypes.h"
 
@@ -45,6 +46,9 @@ private slots:
 
     void TestFirstAndThirdQuartile_data();
     void TestFirstAndThirdQuartile();
+
+    void TestPercentile_data();
+    void TestPercentile();
 };
 
 #endif // TANALYSIS_H
@@ -43,6 +43,20 @@ void TAnalysisCollection::TestAnalyzeAnalysis_data()
                                                  .insertInc(AverageAnalysis().id(), (5.0 + 0.0 + 9.0 + 14.0) / 4.0)
                                                  .insertInc(AverageIgnoreNullAnalysis().id(), (5.0 + 9.0 + 14.0) / 3.0));
 
+    QTest::newRow("multi-output-analysis-collection") << (AnalysisList()
+                                                          << new AverageAnalysis()
+                                                          << new PercentileAnalysis(QList<double>() << 0.0 << 50.0 << 100.0))
+                                                      << (PointList()
+                                                          << 5.0
+                                                          << 0.0
+                                                          << 9.0
+                                                          << 14.0)
+                                                      << (AnalysisResult()
+                                                          .insertInc(AverageAnalysis().id(), (5.0 + 0.0 + 9.0 + 14.0) / 4.0)
+                                                          .insertInc("p0", 0.0)
+                                                          .insertInc("p50", (5.0 + 9.0) / 2.0)
+                                                          .insertInc("p100", 14.0));
+
 }
 
 void TAnalysisCollection::TestAnalyzeAnalysis()
@@ -98,6 +112,14 @@ void TAnalysisCollection::TestAnalyzeAnalysisAddRemove_data()
             << 3
             << (IDAnalysisList() << "stupid" << "average" << "average-ignore-null");
 
+    QTest::newRow("overlapping-outputs-not-added")
+            << (AnalysisList()
+                << new PercentileAnalysis(QList<double>() << 25.0 << 50.0)
+                << new PercentileAnalysis(QList<double>() << 50.0 << 75.0)
+                << new PercentileAnalysis(QList<double>() << 75.0))
+            << 2
+            << (IDAnalysisList() << "percentiles-p25-p50" << "percentiles-p75");
+
 
 }
 
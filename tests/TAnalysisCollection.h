@@ -8,6 +8,7 @@
 #include "../src/StupidAnalysis.h"
 #include "../src/AverageAnalysis.h"
 #include "../src/AverageIgnoreNullAnalysis.h"
+#include "../src/PercentileAnalysis.h"
 
 #include "../src/Metatypes.h"
 
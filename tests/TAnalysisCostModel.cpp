@@ -0,0 +1,131 @@
+#include "TAnalysisCostModel.h"
+
+TAnalysisCostModel::TAnalysisCostModel()
+{
+}
+
+void TAnalysisCostModel::TestChoose_data()
+{
+    QTest::addColumn<bool>("isAggregate");
+    QTest::addColumn<bool>("isIncremental");
+    QTest::addColumn<int>("itemsCount");
+    QTest::addColumn<double>("pointsPerItem");
+    QTest::addColumn<int>("strategy");
+
+    QTest::newRow("points-only") << false << false << 1000 << 100.0 << int(AnalysisCostModel::InMemory);
+    QTest::newRow("aggregate") << true << false << 1000 << 100.0 << int(AnalysisCostModel::Pushdown);
+    QTest::newRow("aggregate-one-item") << true << false << 1 << 10.0 << int(AnalysisCostModel::Pushdown);
+    QTest::newRow("incremental-short") << false << true << 1000 << 5.0 << int(AnalysisCostModel::InMemory);
+    QTest::newRow("incremental-long") << false << true << 1000 << 1000.0 << int(AnalysisCostModel::Incremental);
+    QTest::newRow("aggregate-incremental-short") << true << true << 1000 << 100.0 << int(AnalysisCostModel::Pushdown);
+    QTest::newRow("aggregate-incremental-long") << true << true << 1000 << 10000.0 << int(AnalysisCostModel::Incremental);
+}
+
+void TAnalysisCostModel::TestChoose()
+{
+    QFETCH(bool, isAggregate);
+    QFETCH(bool, isIncremental);
+    QFETCH(int, itemsCount);
+    QFETCH(double, pointsPerItem);
+    QFETCH(int, strategy);
+
+    const AnalysisCostModel::Strategy actual = AnalysisCostModel::choose(isAggregate, isIncremental, itemsCount, pointsPerItem);
+
+    QCOMPARE(AnalysisCostModel::strategyName(actual), AnalysisCostModel::strategyName(AnalysisCostModel::Strategy(strategy)));
+}
+
+void TAnalysisCostModel::TestCollectionStrategy()
+{
+    const QString dataBaseName = "TestCollectionStrategy.db";
+    const QString tableName = "Points";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    SqlPointListWriter writer(dataBaseName, tableName);
+    writer.open();
+    writer.write(SequencePointList()
+                 << (PointList("First") << Point(1.0) << Point(2.0) << Point(3.0))
+                 << (PointList("Second") << Point(4.0) << Point(5.0)));
+
+    SqlPointListReader reader(dataBaseName, tableName);
+    reader.open();
+
+    const IDList items = IDList() << "First" << "Second";
+    FUZZY_COMPARE(AnalysisCostModel::pointsPerItem(&reader, items), 2.5);
+    FUZZY_COMPARE(AnalysisCostModel::pointsPerItem(&reader, IDList()), 2.5);
+
+    AnalysisCollection aggregates;
+    aggregates.addAnalysis(new AverageAnalysis);
+    aggregates.addAnalysis(new AverageIgnoreNullAnalysis);
+
+    QVERIFY(aggregates.isAggregate());
+    QCOMPARE(AnalysisCostModel::choose(aggregates, &reader, items), AnalysisCostModel::Pushdown);
+
+    // the quartile needs the points, so the whole collection is evaluated in memory
+    AnalysisCollection mixed;
+    mixed.addAnalysis(new AverageAnalysis);
+    mixed.addAnalysis(new FirstQuartileAnalysis);
+
+    QVERIFY(!mixed.isAggregate());
+    QCOMPARE(AnalysisCostModel::choose(mixed, &reader, items), AnalysisCostModel::InMemory);
+
+    QVector<double> values;
+    QVERIFY(!mixed.analyzeStorage(&reader, items, &values));
+}
+
+void TAnalysisCostModel::TestPushdown()
+{
+    const QString dataBaseName = "TestPushdown.db";
+    const QString tableName = "Points";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    // more items than one aggregate query takes
+    SequencePointList sequences;
+    IDList items;
+    for(int i = 0; i < 1200; i++)
+    {
+        PointList list(QString("id%1").arg(i));
+        for(int j = 0; j < (i % 7) + 1; j++)
+        {
+            list << Point(((i * 13 + j * 7) % 11) - 5.0);
+        }
+        sequences << list;
+        items << list.id();
+    }
+
+    SqlPointListWriter writer(dataBaseName, tableName);
+    writer.open();
+    writer.write(sequences);
+
+    SqlPointListReader reader(dataBaseName, tableName);
+    reader.open();
+
+    AnalysisCollection collection;
+    collection.addAnalysis(new AverageAnalysis);
+    collection.addAnalysis(new AverageIgnoreNullAnalysis);
+
+    QVector<double> values;
+    QVERIFY(collection.analyzeStorage(&reader, items, &values));
+    QCOMPARE(values.count(), items.count() * collection.outputCount());
+
+    for(int i = 0; i < sequences.count(); i++)
+    {
+        const QVector<double> expected = collection.analyzeValues(sequences.at(i));
+
+        FUZZY_COMPARE(values.at(i * 2), expected.at(0));
+        FUZZY_COMPARE(values.at(i * 2 + 1), expected.at(1));
+    }
+}
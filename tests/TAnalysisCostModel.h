@@ -0,0 +1,34 @@
+#ifndef TANALYSISCOSTMODEL_H
+
+#define TANALYSISCOSTMODEL_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/AnalysisCostModel.h"
+#include "../src/SqlPointListReader.h"
+#include "../src/SqlPointListWriter.h"
+#include "../src/AverageAnalysis.h"
+#include "../src/AverageIgnoreNullAnalysis.h"
+#include "../src/StandardDeviationAnalysis.h"
+#include "../src/MedianAnalysis.h"
+#include "../src/FirstQuartileAnalysis.h"
+
+#include "../src/Metatypes.h"
+
+class TAnalysisCostModel : public QObject
+{
+    Q_OBJECT
+public:
+    TAnalysisCostModel();
+
+private slots:
+    void TestChoose_data();
+    void TestChoose();
+
+    void TestCollectionStrategy();
+    void TestPushdown();
+};
+
+#endif // TANALYSISCOSTMODEL_H
@@ -0,0 +1,154 @@
+#include "TAnalysisEvaluator.h"
+
+TAnalysisEvaluator::TAnalysisEvaluator()
+{
+}
+
+void TAnalysisEvaluator::writeDatabase(const QString &dataBaseName, const QString &tableName, const int itemsCount)
+{
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    // short and long sequences, so both the batch and the single path are used
+    SequencePointList lists;
+    for(int item = 0; item < itemsCount; item++)
+    {
+        PointList list(QString("Item%1").arg(item, 4, 10, QChar('0')));
+
+        const int pointsCount = (item % 3 == 0) ? 100 : 1 + item % 10;
+        for(int point = 0; point < pointsCount; point++)
+        {
+            list << Point((point * 7 + item) % 5);
+        }
+
+        lists << list;
+    }
+
+    SqlPointListWriter writer(dataBaseName, tableName);
+    writer.open();
+    writer.write(lists);
+}
+
+void TAnalysisEvaluator::TestEvaluate_data()
+{
+    QTest::addColumn<bool>("isAggregate");
+
+    QTest::newRow("in-memory") << false;
+    QTest::newRow("pushdown") << true;
+}
+
+void TAnalysisEvaluator::TestEvaluate()
+{
+    QFETCH(bool, isAggregate);
+
+    const QString dataBaseName = "TestAnalysisEvaluator.db";
+    const QString tableName = "Points";
+
+    writeDatabase(dataBaseName, tableName, 30);
+
+    SqlPointListReader reader(dataBaseName, tableName);
+    reader.open();
+
+    AnalysisCollection collection;
+    collection.addAnalysis(new AverageAnalysis);
+    collection.addAnalysis(isAggregate ? static_cast<AbstractAnalysis*>(new AverageIgnoreNullAnalysis)
+                                       : static_cast<AbstractAnalysis*>(new FirstQuartileAnalysis));
+
+    const IDList items = reader.readItems(ID(), 100);
+
+    AnalysisEvaluator evaluator(collection, &reader);
+    evaluator.plan(items);
+
+    QCOMPARE(evaluator.strategy() == AnalysisCostModel::Pushdown, isAggregate);
+
+    AnalysisBatch batch(0, collection.outputCount());
+    evaluator.evaluate(items, batch);
+    evaluator.flush(batch);
+
+    QVERIFY(!evaluator.hasPending());
+    QCOMPARE(batch.count(), items.count());
+    QCOMPARE(batch.values.count(), items.count() * batch.width);
+
+    for(int i = 0; i < batch.count(); i++)
+    {
+        const QVector<double> expected = collection.analyzeValues(reader.read(batch.items.at(i)));
+
+        for(int output = 0; output < batch.width; output++)
+        {
+            FUZZY_COMPARE(batch.values.at(i * batch.width + output), expected.at(output));
+        }
+
+        FUZZY_COMPARE(evaluator.evaluateRow(batch.items.at(i)).at(0), expected.at(0));
+    }
+}
+
+void TAnalysisEvaluator::TestPendingSequences()
+{
+    AnalysisCollection collection;
+    collection.addAnalysis(new AverageAnalysis);
+
+    AnalysisEvaluator evaluator(collection, 0);
+    AnalysisBatch batch(0, collection.outputCount());
+
+    evaluator.evaluateValues("Short", QVector<Point>() << 1.0 << 3.0, batch);
+
+    QVERIFY(evaluator.hasPending());
+    QVERIFY(batch.isEmpty());
+
+    QVector<Point> longPoints(SequenceBatch::maxPoints + 1, 2.0);
+    evaluator.evaluateValues("Long", longPoints, batch);
+
+    QCOMPARE(batch.items, IDList() << "Long");
+
+    for(int i = 1; i < AnalysisEvaluator::sequencesPerBatch(); i++)
+    {
+        evaluator.evaluateValues(QString("Short%1").arg(i), QVector<Point>() << 4.0, batch);
+    }
+
+    QVERIFY(!evaluator.hasPending());
+    QCOMPARE(batch.count(), 1 + AnalysisEvaluator::sequencesPerBatch());
+    QCOMPARE(batch.items.at(1), ID("Short"));
+    FUZZY_COMPARE(batch.values.at(1), 2.0);
+
+    evaluator.flush(batch);
+    QCOMPARE(batch.count(), 1 + AnalysisEvaluator::sequencesPerBatch());
+}
+
+void TAnalysisEvaluator::TestItemPages()
+{
+    const QString dataBaseName = "TestItemPages.db";
+    const QString tableName = "Points";
+
+    writeDatabase(dataBaseName, tableName, 25);
+
+    SqlPointListReader reader(dataBaseName, tableName);
+    reader.open();
+
+    ItemPages pages(&reader);
+    QVERIFY(!pages.setPageSize(0));
+    QVERIFY(pages.setPageSize(10));
+    pages.setCachedPages(1);
+
+    pages.reset();
+    QCOMPARE(pages.rowCount(), 10);
+    QVERIFY(!pages.isFetched());
+    QCOMPARE(pages.nextPageCount(), 10);
+
+    pages.fetchPage();
+    QCOMPARE(pages.nextPageCount(), 5);
+
+    pages.fetchPage();
+    QCOMPARE(pages.rowCount(), 25);
+    QVERIFY(pages.isFetched());
+    QCOMPARE(pages.nextPageCount(), 0);
+
+    // evicted pages are read again
+    QCOMPARE(pages.itemAt(0), ID("Item0000"));
+    QCOMPARE(pages.itemAt(24), ID("Item0024"));
+    QCOMPARE(pages.itemAt(13), ID("Item0013"));
+}
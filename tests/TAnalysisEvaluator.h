@@ -0,0 +1,36 @@
+#ifndef TANALYSISEVALUATOR_H
+
+#define TANALYSISEVALUATOR_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/AnalysisEvaluator.h"
+#include "../src/ItemPages.h"
+#include "../src/SqlPointListReader.h"
+#include "../src/SqlPointListWriter.h"
+#include "../src/AverageAnalysis.h"
+#include "../src/AverageIgnoreNullAnalysis.h"
+#include "../src/FirstQuartileAnalysis.h"
+
+#include "../src/Metatypes.h"
+
+class TAnalysisEvaluator : public QObject
+{
+    Q_OBJECT
+public:
+    TAnalysisEvaluator();
+
+private slots:
+    void TestEvaluate_data();
+    void TestEvaluate();
+
+    void TestPendingSequences();
+    void TestItemPages();
+
+private:
+    static void writeDatabase(const QString &dataBaseName, const QString &tableName, const int itemsCount);
+};
+
+#endif // TANALYSISEVALUATOR_H
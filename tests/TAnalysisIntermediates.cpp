@@ -0,0 +1,121 @@
+#include "TAnalysisIntermediates.h"
+
+TAnalysisIntermediates::TAnalysisIntermediates()
+{
+}
+
+void TAnalysisIntermediates::TestPlan_data()
+{
+    QTest::addColumn<int>("intermediates");
+    QTest::addColumn< QList<int> >("plan");
+
+    QTest::newRow("nothing") << int(AnalysisIntermediates::NoIntermediates) << QList<int>();
+
+    QTest::newRow("mean") << int(AnalysisIntermediates::Mean)
+                          << (QList<int>() << AnalysisIntermediates::Sum << AnalysisIntermediates::Mean);
+
+    QTest::newRow("squares-and-sorted") << int(AnalysisIntermediates::SumOfSquares | AnalysisIntermediates::Sorted)
+                                        << (QList<int>()
+                                            << AnalysisIntermediates::Sum
+                                            << AnalysisIntermediates::Mean
+                                            << AnalysisIntermediates::SumOfSquares
+                                            << AnalysisIntermediates::Sorted);
+
+    QTest::newRow("shared-sum") << int(AnalysisIntermediates::Sum | AnalysisIntermediates::NonZeroCount | AnalysisIntermediates::Mean)
+                                << (QList<int>()
+                                    << AnalysisIntermediates::Sum
+                                    << AnalysisIntermediates::Mean
+                                    << AnalysisIntermediates::NonZeroCount);
+}
+
+void TAnalysisIntermediates::TestPlan()
+{
+    QFETCH(int, intermediates);
+    QFETCH(QList<int>, plan);
+
+    const AnalysisIntermediates::Plan actualPlan = AnalysisIntermediates::plan(intermediates);
+
+    QList<int> actual;
+    for(int i = 0; i < actualPlan.count(); i++)
+    {
+        actual << actualPlan.at(i);
+    }
+
+    QCOMPARE(actual, plan);
+}
+
+void TAnalysisIntermediates::TestPrepare()
+{
+    AnalysisIntermediates intermediates;
+
+    intermediates.reset("First", QVector<Point>() << 4.0 << 0.0 << 1.0 << 7.0);
+    intermediates.prepare(AnalysisIntermediates::plan(AnalysisIntermediates::SumOfSquares
+                                                      | AnalysisIntermediates::Sorted
+                                                      | AnalysisIntermediates::MinMax));
+
+    QVERIFY(intermediates.isPrepared(AnalysisIntermediates::Mean));
+    QVERIFY(!intermediates.isPrepared(AnalysisIntermediates::NonZeroCount));
+
+    FUZZY_COMPARE(intermediates.sum(), 12.0);
+    FUZZY_COMPARE(intermediates.mean(), 3.0);
+    FUZZY_COMPARE(intermediates.sumOfSquares(), 1.0 + 9.0 + 4.0 + 16.0);
+    FUZZY_COMPARE(intermediates.minimum(), 0.0);
+    FUZZY_COMPARE(intermediates.maximum(), 7.0);
+    QCOMPARE(intermediates.sorted(), QVector<Point>() << 0.0 << 1.0 << 4.0 << 7.0);
+    FUZZY_COMPARE(intermediates.sortedMedian(0, intermediates.count()), 2.5);
+
+    // the scratch object is reused for the next sequence
+    intermediates.reset("Second", QVector<Point>() << 2.0 << -1.0);
+    QVERIFY(!intermediates.isPrepared(AnalysisIntermediates::Sorted));
+
+    intermediates.prepare(AnalysisIntermediates::plan(AnalysisIntermediates::Sorted | AnalysisIntermediates::Points));
+    QCOMPARE(intermediates.sorted(), QVector<Point>() << -1.0 << 2.0);
+    QVERIFY(PointList::fuzzyCompare(intermediates.pointList(), PointList("Second") << 2.0 << -1.0));
+}
+
+void TAnalysisIntermediates::TestCollection_data()
+{
+    QTest::addColumn<PointList>("values");
+
+    QTest::newRow("empty") << PointList("Empty");
+    QTest::newRow("one-value") << (PointList("One") << 26.0);
+    QTest::newRow("even") << (PointList("Even") << 23.0 << -5.0 << 0.0 << 31.0);
+    QTest::newRow("odd") << (PointList("Odd") << -3.0 << 13.0 << 17.5 << 15.0 << -4.5 << 0.0 << 2.0);
+}
+
+void TAnalysisIntermediates::TestCollection()
+{
+    QFETCH(PointList, values);
+
+    AnalysisList analyzes;
+    analyzes << new StupidAnalysis(1.0)
+             << new AverageAnalysis
+             << new AverageIgnoreNullAnalysis
+             << new StandardDeviationAnalysis
+             << new MedianAnalysis
+             << new FirstQuartileAnalysis
+             << new ThirdQuartileAnalysis
+             << new PercentileAnalysis(QList<double>() << 10.0 << 90.0)
+             << new QuantileSketchAnalysis(0.5);
+
+    AnalysisCollection collection(analyzes);
+
+    // the shared intermediates give the results of every analysis on its own
+    const QVector<double> actual = collection.analyzeValues(values);
+
+    QVector<double> expected;
+    foreach(AbstractAnalysis* analysis, analyzes)
+    {
+        QVector<double> outputs(analysis->outputCount());
+        analysis->analyzeOutputs(values, outputs.data());
+        expected << outputs;
+    }
+
+    qDeleteAll(analyzes);
+
+    QCOMPARE(actual.count(), expected.count());
+    for(int i = 0; i < expected.count(); i++)
+    {
+        FUZZY_COMPARE(actual.at(i), expected.at(i));
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef TANALYSISINTERMEDIATES_H
+
+#define TANALYSISINTERMEDIATES_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/AnalysisIntermediates.h"
+#include "../src/StupidAnalysis.h"
+#include "../src/AverageAnalysis.h"
+#include "../src/AverageIgnoreNullAnalysis.h"
+#include "../src/StandardDeviationAnalysis.h"
+#include "../src/MedianAnalysis.h"
+#include "../src/FirstQuartileAnalysis.h"
+#include "../src/ThirdQuartileAnalysis.h"
+#include "../src/PercentileAnalysis.h"
+#include "../src/QuantileSketchAnalysis.h"
+
+#include "../src/Metatypes.h"
+
+class TAnalysisIntermediates : public QObject
+{
+    Q_OBJECT
+public:
+    TAnalysisIntermediates();
+
+private slots:
+    void TestPlan_data();
+    void TestPlan();
+
+    void TestPrepare();
+
+    void TestCollection_data();
+    void TestCollection();
+};
+
+#endif // TANALYSISINTERMEDIATES_H
@@ -0,0 +1,126 @@
+#include "TAnalysisResultMatrix.h"
+
+TAnalysisResultMatrix::TAnalysisResultMatrix()
+{
+}
+
+void TAnalysisResultMatrix::TestAppendRowsColumns_data()
+{
+    QTest::addColumn<IDList>("rows");
+    QTest::addColumn<IDAnalysisList>("columns");
+
+    QTest::newRow("empty") << IDList() << IDAnalysisList();
+
+    QTest::newRow("rows-only") << (IDList() << "First" << "Second")
+                               << IDAnalysisList();
+
+    QTest::newRow("columns-only") << IDList()
+                                  << (IDAnalysisList() << "stupid" << "average");
+
+    QTest::newRow("rows-and-columns") << (IDList() << "First" << "Second" << "Third")
+                                      << (IDAnalysisList() << "stupid" << "average");
+}
+
+void TAnalysisResultMatrix::TestAppendRowsColumns()
+{
+    QFETCH(IDList, rows);
+    QFETCH(IDAnalysisList, columns);
+
+    AnalysisResultMatrix matrix;
+
+    for(int i = 0; i < rows.count() / 2; i++)
+    {
+        matrix.appendRow(rows.at(i));
+    }
+
+    foreach(const IDAnalysis& column, columns)
+    {
+        matrix.appendColumn(column);
+    }
+
+    for(int i = rows.count() / 2; i < rows.count(); i++)
+    {
+        matrix.appendRow(rows.at(i));
+    }
+
+    QCOMPARE(matrix.rowCount(), rows.count());
+    QCOMPARE(matrix.columnCount(), columns.count());
+    QCOMPARE(matrix.rowIDs(), rows);
+    QCOMPARE(matrix.columnIDs(), columns);
+
+    for(int row = 0; row < rows.count(); row++)
+    {
+        QCOMPARE(matrix.indexOfRow(rows.at(row)), row);
+        QVERIFY(!matrix.isAnalyzed(row));
+
+        for(int column = 0; column < columns.count(); column++)
+        {
+            FUZZY_COMPARE(matrix.value(row, column), 0.0);
+        }
+    }
+
+    QCOMPARE(matrix.indexOfRow("not-exists"), -1);
+}
+
+void TAnalysisResultMatrix::TestResultsExport_data()
+{
+    QTest::addColumn<IDList>("rows");
+    QTest::addColumn<IDAnalysisList>("columns");
+    QTest::addColumn<AnalysisResults>("results");
+
+    QTest::newRow("empty") << IDList() << IDAnalysisList() << AnalysisResults();
+
+    QTest::newRow("not-analyzed") << (IDList() << "First")
+                                  << (IDAnalysisList() << "stupid" << "average")
+                                  << AnalysisResults().insertInc("First", AnalysisResult());
+
+    QTest::newRow("two") << (IDList() << "First" << "Second")
+                         << (IDAnalysisList() << "stupid" << "average")
+                         << AnalysisResults()
+                            .insertInc("First",
+                                       AnalysisResult().insertInc("stupid", 1.0)
+                                       .insertInc("average", 2.5))
+                            .insertInc("Second",
+                                       AnalysisResult().insertInc("stupid", 1.0)
+                                       .insertInc("average", -4.0));
+
+    QTest::newRow("partially-analyzed") << (IDList() << "First" << "Second")
+                                        << (IDAnalysisList() << "average")
+                                        << AnalysisResults()
+                                           .insertInc("First", AnalysisResult())
+                                           .insertInc("Second",
+                                                      AnalysisResult().insertInc("average", 3.0));
+}
+
+void TAnalysisResultMatrix::TestResultsExport()
+{
+    QFETCH(IDList, rows);
+    QFETCH(IDAnalysisList, columns);
+    QFETCH(AnalysisResults, results);
+
+    AnalysisResultMatrix matrix;
+
+    foreach(const ID& row, rows)
+    {
+        matrix.appendRow(row);
+    }
+
+    foreach(const IDAnalysis& column, columns)
+    {
+        matrix.appendColumn(column);
+    }
+
+    matrix.setResults(results);
+
+    const AnalysisResults actualResults = matrix.toResults();
+    const AnalysisResults expectedResults = results;
+
+    bool isCompare = AnalysisResults::fuzzyCompare(actualResults, expectedResults);
+    if(!isCompare)
+    {
+        QFAIL(QString("Compare values are not the same. \nActual:\n"
+                      + actualResults.toString()
+                      + "\nExpected:\n"
+                      + expectedResults.toString()).toStdString().c_str());
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef TANALYSISRESULTMATRIX_H
+
+#define TANALYSISRESULTMATRIX_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/AnalysisResultMatrix.h"
+
+#include "../src/Metatypes.h"
+
+class TAnalysisResultMatrix : public QObject
+{
+    Q_OBJECT
+public:
+    TAnalysisResultMatrix();
+
+private slots:
+    void TestAppendRowsColumns_data();
+    void TestAppendRowsColumns();
+
+    void TestResultsExport_data();
+    void TestResultsExport();
+};
+
+#endif // TANALYSISRESULTMATRIX_H
@@ -0,0 +1,282 @@
+#include "TAnalysisRowOrder.h"
+
+TAnalysisRowOrder::TAnalysisRowOrder()
+{
+}
+
+void TAnalysisRowOrder::TestSortByColumn_data()
+{
+    QTest::addColumn<IDList>("rows");
+    QTest::addColumn< QList<Point> >("values");
+    QTest::addColumn<Qt::SortOrder>("sortType");
+    QTest::addColumn<IDList>("result");
+
+    QTest::newRow("one") << (IDList() << "First")
+                         << (QList<Point>() << 1.0)
+                         << Qt::AscendingOrder
+                         << (IDList() << "First");
+
+    QTest::newRow("three-asc") << (IDList() << "First" << "Second" << "Third")
+                               << (QList<Point>() << 4.0 << 3.0 << 1.0)
+                               << Qt::AscendingOrder
+                               << (IDList() << "Third" << "Second" << "First");
+
+    QTest::newRow("three-desc") << (IDList() << "First" << "Second" << "Third")
+                                << (QList<Point>() << 5.0 << 10.0 << 6.0)
+                                << Qt::DescendingOrder
+                                << (IDList() << "Second" << "Third" << "First");
+
+    QTest::newRow("four-negative-asc") << (IDList() << "First" << "Second" << "Third" << "Four")
+                                       << (QList<Point>() << 0.0 << -3.5 << 2.0 << -1.0)
+                                       << Qt::AscendingOrder
+                                       << (IDList() << "Second" << "Four" << "First" << "Third");
+
+    QTest::newRow("equal-keep-order") << (IDList() << "First" << "Second" << "Third" << "Four")
+                                      << (QList<Point>() << 1.0 << 2.0 << 1.0 << 2.0)
+                                      << Qt::DescendingOrder
+                                      << (IDList() << "Second" << "Four" << "First" << "Third");
+}
+
+void TAnalysisRowOrder::TestSortByColumn()
+{
+    QFETCH(IDList, rows);
+    QFETCH(QList<Point>, values);
+    QFETCH(Qt::SortOrder, sortType);
+    QFETCH(IDList, result);
+
+    if(rows.count() != values.count())
+    {
+        QFAIL("incorrect testing data");
+    }
+
+    AnalysisResultMatrix matrix;
+    matrix.appendColumn("value");
+
+    for(int i = 0; i < rows.count(); i++)
+    {
+        const int row = matrix.appendRow(rows.at(i));
+        matrix.setRow(row, QVector<double>() << values.at(i));
+    }
+
+    AnalysisRowOrder order;
+    order.reset(matrix.rowCount());
+    order.sort(matrix, AnalysisSortKeys() << AnalysisSortKey(0, sortType), matrix.rowCount());
+
+    QVERIFY(order.isSorted());
+    QCOMPARE(matrix.rowIDs(), rows);
+
+    IDList sortedRows;
+    for(int row = 0; row < order.rowCount(); row++)
+    {
+        sortedRows.append(matrix.rowID(order.sourceRow(row)));
+        QCOMPARE(order.viewRow(order.sourceRow(row)), row);
+    }
+
+    QCOMPARE(sortedRows, result);
+}
+
+void TAnalysisRowOrder::TestPartialSort_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::addColumn<int>("firstRows");
+    QTest::addColumn<int>("stepRows");
+    QTest::addColumn<int>("radixThreshold");
+    QTest::addColumn<Qt::SortOrder>("sortType");
+
+    QTest::newRow("full-asc") << 100 << 100 << 1 << 1000000 << Qt::AscendingOrder;
+    QTest::newRow("viewport-asc") << 1000 << 10 << 100 << 1000000 << Qt::AscendingOrder;
+    QTest::newRow("viewport-desc") << 1000 << 10 << 100 << 1000000 << Qt::DescendingOrder;
+    QTest::newRow("radix-asc") << 5000 << 50 << 5000 << 1 << Qt::AscendingOrder;
+    QTest::newRow("radix-desc") << 5000 << 50 << 5000 << 1 << Qt::DescendingOrder;
+    QTest::newRow("radix-full") << 5000 << 5000 << 1 << 1 << Qt::AscendingOrder;
+}
+
+void TAnalysisRowOrder::TestPartialSort()
+{
+    QFETCH(int, rows);
+    QFETCH(int, firstRows);
+    QFETCH(int, stepRows);
+    QFETCH(int, radixThreshold);
+    QFETCH(Qt::SortOrder, sortType);
+
+    qsrand(rows);
+
+    AnalysisResultMatrix matrix;
+    matrix.appendColumn("value");
+
+    QList< QPair<double, int> > expected;
+
+    for(int row = 0; row < rows; row++)
+    {
+        const double value = double(qrand() % 200 - 100) / 8.0;
+
+        matrix.appendRow(QString::number(row));
+        matrix.setRow(row, QVector<double>() << value);
+
+        expected.append(qMakePair((sortType == Qt::AscendingOrder) ? value : -value, row));
+    }
+
+    qSort(expected);
+
+    const int oldRadixThreshold = AnalysisRowOrder::radixThreshold();
+    AnalysisRowOrder::setRadixThreshold(radixThreshold);
+
+    AnalysisRowOrder order;
+    order.reset(matrix.rowCount());
+    order.sort(matrix, AnalysisSortKeys() << AnalysisSortKey(0, sortType), firstRows);
+
+    QCOMPARE(order.sortedRows(), firstRows);
+    for(int row = 0; row < firstRows; row++)
+    {
+        QCOMPARE(order.sourceRow(row), expected.at(row).second);
+    }
+
+    while(!order.isSorted())
+    {
+        const int sortedRows = order.sortedRows();
+        order.sortMore(matrix, stepRows);
+        QVERIFY(order.sortedRows() > sortedRows);
+    }
+
+    AnalysisRowOrder::setRadixThreshold(oldRadixThreshold);
+
+    for(int row = 0; row < rows; row++)
+    {
+        QCOMPARE(order.sourceRow(row), expected.at(row).second);
+        QCOMPARE(order.viewRow(order.sourceRow(row)), row);
+    }
+}
+
+void TAnalysisRowOrder::TestStableMultiColumn_data()
+{
+    QTest::addColumn< QList<Point> >("first");
+    QTest::addColumn< QList<Point> >("second");
+    QTest::addColumn<Qt::SortOrder>("sortType");
+    QTest::addColumn< QList<int> >("result");
+
+    QTest::newRow("asc") << (QList<Point>() << 1.0 << 2.0 << 1.0 << 2.0 << 1.0)
+                         << (QList<Point>() << 3.0 << 1.0 << 2.0 << 1.0 << 3.0)
+                         << Qt::AscendingOrder
+                         << (QList<int>() << 2 << 0 << 4 << 1 << 3);
+
+    QTest::newRow("desc") << (QList<Point>() << 1.0 << 2.0 << 1.0 << 2.0 << 1.0)
+                          << (QList<Point>() << 3.0 << 1.0 << 2.0 << 1.0 << 3.0)
+                          << Qt::DescendingOrder
+                          << (QList<int>() << 1 << 3 << 2 << 0 << 4);
+}
+
+void TAnalysisRowOrder::TestStableMultiColumn()
+{
+    QFETCH(QList<Point>, first);
+    QFETCH(QList<Point>, second);
+    QFETCH(Qt::SortOrder, sortType);
+    QFETCH(QList<int>, result);
+
+    AnalysisResultMatrix matrix;
+    matrix.appendColumn("first");
+    matrix.appendColumn("second");
+
+    for(int row = 0; row < first.count(); row++)
+    {
+        matrix.appendRow(QString::number(row));
+        matrix.setRow(row, QVector<double>() << first.at(row) << second.at(row));
+    }
+
+    AnalysisRowOrder order;
+    order.reset(matrix.rowCount());
+    order.sort(matrix,
+               AnalysisSortKeys() << AnalysisSortKey(0, sortType) << AnalysisSortKey(1, Qt::AscendingOrder),
+               1);
+
+    while(!order.isSorted())
+    {
+        order.sortMore(matrix, 1);
+    }
+
+    QCOMPARE(order.order().toList(), result);
+}
+
+void TAnalysisRowOrder::TestRadixKey()
+{
+    const double zero = 0.0;
+    const double infinity = 1.0 / zero;
+    const double nan = zero / zero;
+
+    const QList<Point> values = QList<Point>() << -infinity << -5.0 << -0.5 << 0.0 << 0.25 << 3.0 << infinity << nan;
+
+    for(int i = 1; i < values.count(); i++)
+    {
+        QVERIFY(AnalysisRowOrder::radixKey(values.at(i - 1)) < AnalysisRowOrder::radixKey(values.at(i)));
+    }
+
+    QCOMPARE(AnalysisRowOrder::radixKey(-0.0), AnalysisRowOrder::radixKey(0.0));
+}
+
+void TAnalysisRowOrder::TestAppendDuringSort()
+{
+    const int rows = 100;
+    const int newRows = 5;
+
+    qsrand(rows);
+
+    AnalysisResultMatrix matrix;
+    matrix.appendColumn("value");
+
+    QList< QPair<double, int> > expected;
+
+    for(int row = 0; row < rows; row++)
+    {
+        const double value = double(qrand() % 200);
+
+        matrix.appendRow(QString::number(row));
+        matrix.setRow(row, QVector<double>() << value);
+
+        expected.append(qMakePair(value, row));
+    }
+
+    qSort(expected);
+
+    AnalysisRowOrder order;
+    order.reset(matrix.rowCount());
+    order.sort(matrix, AnalysisSortKeys() << AnalysisSortKey(0, Qt::AscendingOrder), 10);
+    QVERIFY(!order.isSorted());
+
+    // the new rows would be first by value, they still stay at the end
+    for(int row = rows; row < rows + newRows; row++)
+    {
+        matrix.appendRow(QString::number(row));
+        matrix.setRow(row, QVector<double>() << -double(row));
+    }
+    order.appendRows(newRows);
+
+    QCOMPARE(order.rowCount(), rows + newRows);
+    QVERIFY(!order.isSorted());
+
+    while(!order.isSorted())
+    {
+        order.sortMore(matrix, 7);
+    }
+
+    for(int row = 0; row < rows; row++)
+    {
+        QCOMPARE(order.sourceRow(row), expected.at(row).second);
+    }
+
+    for(int row = rows; row < rows + newRows; row++)
+    {
+        QCOMPARE(order.sourceRow(row), row);
+    }
+
+    for(int row = 0; row < order.rowCount(); row++)
+    {
+        QCOMPARE(order.viewRow(order.sourceRow(row)), row);
+    }
+
+    // rows appended after a finished sort keep the order sorted
+    matrix.appendRow(QString::number(rows + newRows));
+    matrix.setRow(rows + newRows, QVector<double>() << -1.0);
+    order.appendRows(1);
+
+    QVERIFY(order.isSorted());
+    QCOMPARE(order.sourceRow(rows + newRows), rows + newRows);
+}
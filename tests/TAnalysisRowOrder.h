@@ -0,0 +1,34 @@
+#ifndef TANALYSISROWORDER_H
+
+#define TANALYSISROWORDER_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/AnalysisRowOrder.h"
+
+#include "../src/Metatypes.h"
+
+class TAnalysisRowOrder : public QObject
+{
+    Q_OBJECT
+public:
+    TAnalysisRowOrder();
+
+private slots:
+    void TestSortByColumn_data();
+    void TestSortByColumn();
+
+    void TestPartialSort_data();
+    void TestPartialSort();
+
+    void TestStableMultiColumn_data();
+    void TestStableMultiColumn();
+
+    void TestRadixKey();
+
+    void TestAppendDuringSort();
+};
+
+#endif // TANALYSISROWORDER_H
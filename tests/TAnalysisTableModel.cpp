@@ -2,7 +2,7 @@
 
 TAnalysisTableModel::TAnalysisTableModel()
 {
-
+    qRegisterMetaType<QModelIndex>("QModelIndex");
 }
 
 void TAnalysisTableModel::TestAddRemoveMoc_data()
@@ -478,3 +478,224 @@ void TAnalysisTableModel::TestSorting()
 
     QCOMPARE(actualPointsID, expectedPointsID);
 }
+
+void TAnalysisTableModel::TestInsertSignals()
+{
+    AnalysisTableModel model(0);
+
+    QSignalSpy rowsAboutSpy(&model, SIGNAL(rowsAboutToBeInserted(QModelIndex,int,int)));
+    QSignalSpy rowsSpy(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy columnsAboutSpy(&model, SIGNAL(columnsAboutToBeInserted(QModelIndex,int,int)));
+    QSignalSpy columnsSpy(&model, SIGNAL(columnsInserted(QModelIndex,int,int)));
+
+    model.appendPointList(ID("First"));
+    model.appendPointList(IDList() << ID("Second") << ID("Third"));
+
+    QCOMPARE(rowsAboutSpy.count(), 2);
+    QCOMPARE(rowsSpy.count(), 2);
+    QCOMPARE(rowsSpy.at(0).at(1).toInt(), 0);
+    QCOMPARE(rowsSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(rowsSpy.at(1).at(1).toInt(), 1);
+    QCOMPARE(rowsSpy.at(1).at(2).toInt(), 2);
+    QVERIFY(!qvariant_cast<QModelIndex>(rowsSpy.at(1).at(0)).isValid());
+    QCOMPARE(model.rowCount(), 3);
+
+    StupidAnalysis stupid(1.0);
+    AverageAnalysis average;
+
+    model.addAnalysis(&stupid);
+    model.addAnalysis(&average);
+
+    // the identifier column stays first
+    QCOMPARE(columnsAboutSpy.count(), 2);
+    QCOMPARE(columnsSpy.count(), 2);
+    QCOMPARE(columnsSpy.at(0).at(1).toInt(), 1);
+    QCOMPARE(columnsSpy.at(0).at(2).toInt(), stupid.outputIDs().count());
+    QCOMPARE(columnsSpy.at(1).at(1).toInt(), 1 + stupid.outputIDs().count());
+    QCOMPARE(model.columnCount(), 1 + stupid.outputIDs().count() + average.outputIDs().count());
+
+    // an analysis already in the model adds no columns
+    model.addAnalysis(&average);
+    QCOMPARE(columnsSpy.count(), 2);
+    QCOMPARE(rowsSpy.count(), 2);
+}
+
+void TAnalysisTableModel::TestSortPersistentIndexes()
+{
+    AnalysisTableModel model(0);
+
+    StupidAnalysis stupid(1.0);
+    model.addAnalysis(&stupid);
+    model.appendPointList(IDList() << ID("First") << ID("Second") << ID("Third") << ID("Fourth"));
+
+    model.setResults(AnalysisResults()
+                     .insertInc("First", AnalysisResult().insertInc(stupid.id(), 3.0))
+                     .insertInc("Second", AnalysisResult().insertInc(stupid.id(), 1.0))
+                     .insertInc("Third", AnalysisResult().insertInc(stupid.id(), 4.0))
+                     .insertInc("Fourth", AnalysisResult().insertInc(stupid.id(), 2.0)));
+
+    const QPersistentModelIndex first(model.index(0, 0));
+    const QPersistentModelIndex thirdValue(model.index(2, 1));
+
+    QSignalSpy aboutSpy(&model, SIGNAL(layoutAboutToBeChanged()));
+    QSignalSpy changedSpy(&model, SIGNAL(layoutChanged()));
+
+    model.sort(1, Qt::AscendingOrder);
+
+    QCOMPARE(aboutSpy.count(), 1);
+    QCOMPARE(changedSpy.count(), 1);
+    QVERIFY(model.isSorted());
+    QCOMPARE(model.getPointsIDs(), IDList() << ID("Second") << ID("Fourth") << ID("First") << ID("Third"));
+
+    // the persistent indexes follow their rows
+    QVERIFY(first.isValid());
+    QCOMPARE(first.row(), 2);
+    QCOMPARE(first.data().toString(), QString("First"));
+    QVERIFY(thirdValue.isValid());
+    QCOMPARE(thirdValue.row(), 3);
+    QCOMPARE(thirdValue.column(), 1);
+    FUZZY_COMPARE(thirdValue.data().toDouble(), 4.0);
+
+    model.sort(1, Qt::DescendingOrder);
+
+    QCOMPARE(changedSpy.count(), 2);
+    QCOMPARE(first.row(), 1);
+    QCOMPARE(thirdValue.row(), 0);
+
+    // restoring the insertion order keeps them too
+    model.sort(-1);
+
+    QCOMPARE(changedSpy.count(), 3);
+    QCOMPARE(first.row(), 0);
+    QCOMPARE(thirdValue.row(), 2);
+}
+
+void TAnalysisTableModel::TestAppendDuplicates()
+{
+    AnalysisTableModel model(0);
+    model.appendPointList(IDList() << ID("First") << ID("Second"));
+
+    QSignalSpy rowsSpy(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+    // duplicates in the model, in the list itself and empty ids are skipped
+    model.appendPointList(IDList() << ID("Second") << ID("Third") << ID("Third") << ID("") << ID("Fourth"));
+
+    QCOMPARE(rowsSpy.count(), 1);
+    QCOMPARE(rowsSpy.at(0).at(1).toInt(), 2);
+    QCOMPARE(rowsSpy.at(0).at(2).toInt(), 3);
+    QCOMPARE(model.getPointsIDs(), IDList() << ID("First") << ID("Second") << ID("Third") << ID("Fourth"));
+
+    // nothing new, no signal
+    model.appendPointList(IDList() << ID("First") << ID("Fourth"));
+    model.appendPointList(ID("Third"));
+
+    QCOMPARE(rowsSpy.count(), 1);
+    QCOMPARE(model.rowCount(), 4);
+}
+
+IDList TAnalysisTableModel::lazyItems(const int count) const
+{
+    IDList items;
+    for(int i = 0; i < count; i++)
+    {
+        items << QString("Item%1").arg(i, 3, 10, QChar('0'));
+    }
+
+    return items;
+}
+
+bool TAnalysisTableModel::waitAnalyzed(const AnalysisTableModel &model, const int row) const
+{
+    const int sourceRow = model.order_.sourceRow(row);
+
+    QTime timer;
+    timer.start();
+    while(!model.results_.isAnalyzed(sourceRow) && (timer.elapsed() < 10000))
+    {
+        QTest::qWait(10);
+    }
+
+    return model.results_.isAnalyzed(sourceRow);
+}
+
+void TAnalysisTableModel::TestLazyPlaceholder()
+{
+    const IDList items = lazyItems(10);
+    MocPointListReader reader(items);
+
+    AnalysisTableModel model(&reader);
+    model.appendPointList(items);
+
+    StupidAnalysis stupid(1.0);
+    model.addAnalysis(&stupid);
+
+    model.setLazyMode(true);
+    QVERIFY(model.isLazyMode());
+
+    // nothing is analyzed before the events are processed
+    QCOMPARE(model.data(model.index(3, 1)).toString(), QString("..."));
+    QCOMPARE(model.data(model.index(3, 0)).toString(), items.at(3));
+    QVERIFY(!model.results_.isAnalyzed(3));
+
+    // requesting the row again doesn't queue it twice
+    model.data(model.index(3, 1));
+    QCOMPARE(model.pendingRequests_.count(), 1);
+}
+
+void TAnalysisTableModel::TestLazyDelivery()
+{
+    const IDList items = lazyItems(10);
+    MocPointListReader reader(items);
+
+    AnalysisTableModel model(&reader);
+    model.appendPointList(items);
+
+    StupidAnalysis stupid(1.0);
+    model.addAnalysis(&stupid);
+
+    model.setLazyMode(true);
+
+    QSignalSpy changedSpy(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex)));
+
+    QCOMPARE(model.data(model.index(5, 1)).toString(), QString("..."));
+    QVERIFY(waitAnalyzed(model, 5));
+
+    // the delivered row is reported and shown
+    QVERIFY(changedSpy.count() > 0);
+    FUZZY_COMPARE(model.data(model.index(5, 1)).toDouble(), 1.0);
+}
+
+void TAnalysisTableModel::TestLazyPrefetch()
+{
+    const IDList items = lazyItems(50);
+    MocPointListReader reader(items);
+
+    AnalysisTableModel model(&reader);
+    model.appendPointList(items);
+
+    StupidAnalysis stupid(1.0);
+    model.addAnalysis(&stupid);
+
+    model.setPrefetchRows(2);
+    model.setLazyMode(true);
+
+    model.data(model.index(20, 1));
+    QVERIFY(waitAnalyzed(model, 20));
+
+    // the neighbours are prefetched with the requested row
+    for(int row = 18; row <= 22; row++)
+    {
+        QVERIFY(waitAnalyzed(model, row));
+    }
+
+    // give a stray analysis the time to arrive
+    QTest::qWait(100);
+
+    for(int row = 0; row < model.rowCount(); row++)
+    {
+        if((row < 18) || (row > 22))
+        {
+            QVERIFY2(!model.results_.isAnalyzed(row), qPrintable(QString("row %1 analyzed").arg(row)));
+        }
+    }
+}
@@ -3,9 +3,11 @@
 #define TANALYSISTABLEMODEL_H
 
 #include <QTest>
+#include <QSignalSpy>
 
 #include "TestingUtilities.h"
 
+#include "../mocs/MocPointListReader.h"
 #include "../src/AnalysisCollection.h"
 #include "../src/StupidAnalysis.h"
 #include "../src/AverageAnalysis.h"
@@ -33,6 +35,18 @@ private slots:
 
     void TestSorting_data();
     void TestSorting();
+
+    void TestInsertSignals();
+    void TestSortPersistentIndexes();
+    void TestAppendDuplicates();
+
+    void TestLazyPlaceholder();
+    void TestLazyDelivery();
+    void TestLazyPrefetch();
+
+private:
+    IDList lazyItems(const int count) const;
+    bool waitAnalyzed(const AnalysisTableModel &model, const int row) const;
 };
 
 #endif // TANALYSISTABLEMODEL_H
@@ -0,0 +1,153 @@
+#include "TAnalysisWorker.h"
+
+AnalysisWorkerReceiver::AnalysisWorkerReceiver(AnalysisWorker *worker) :
+    worker(worker),
+    emitted(0),
+    duplicates(0),
+    staleBatches(0),
+    staleProgress(0),
+    lastProcessed(0),
+    lastTotal(0)
+{
+    connect(worker, SIGNAL(resultsReady(AnalysisBatch)),
+            this, SLOT(onResults(AnalysisBatch)), Qt::QueuedConnection);
+    connect(worker, SIGNAL(progressChanged(int,int,int,double)),
+            this, SLOT(onProgress(int,int,int,double)), Qt::QueuedConnection);
+    connect(worker, SIGNAL(progressChanged(int,int,int,double)),
+            this, SLOT(countEmitted(int,int,int,double)), Qt::DirectConnection);
+}
+
+void AnalysisWorkerReceiver::onResults(const AnalysisBatch &batch)
+{
+    if(batch.run != worker->currentRun())
+    {
+        staleBatches++;
+        return;
+    }
+
+    for(int i = 0; i < batch.count(); i++)
+    {
+        if(values.contains(batch.items.at(i)))
+        {
+            duplicates++;
+        }
+        values.insert(batch.items.at(i), batch.values.at(i * batch.width));
+    }
+}
+
+void AnalysisWorkerReceiver::onProgress(const int run, const int processed, const int total, const double itemsPerSecond)
+{
+    Q_UNUSED(itemsPerSecond);
+
+    if(run != worker->currentRun())
+    {
+        staleProgress++;
+        return;
+    }
+
+    lastProcessed = processed;
+    lastTotal = total;
+}
+
+void AnalysisWorkerReceiver::countEmitted(const int run, const int processed, const int total, const double itemsPerSecond)
+{
+    Q_UNUSED(run);
+    Q_UNUSED(processed);
+    Q_UNUSED(total);
+    Q_UNUSED(itemsPerSecond);
+
+    emitted.ref();
+}
+
+TAnalysisWorker::TAnalysisWorker()
+{
+}
+
+void TAnalysisWorker::TestCancelRestart()
+{
+    const QString dataBaseName = "TestAnalysisWorker.db";
+    const QString tableName = "Points";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    SequencePointList lists;
+    IDList items;
+    for(int i = 0; i < 3000; i++)
+    {
+        PointList list(QString("Item%1").arg(i, 4, 10, QChar('0')));
+        for(int j = 0; j < 20; j++)
+        {
+            list << Point(i + j);
+        }
+
+        lists << list;
+        items << list.id();
+    }
+
+    {
+        SqlPointListWriter writer(dataBaseName, tableName);
+        writer.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+        QVERIFY(writer.open());
+        writer.write(lists);
+    }
+
+    SqlPointListReader reader(dataBaseName, tableName);
+    reader.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+    QVERIFY(reader.open());
+
+    AverageAnalysis average;
+    AnalysisCollection collection;
+    collection.addAnalysis(&average);
+
+    AnalysisWorker worker(&reader);
+    worker.setBatchInterval(0);
+
+    AnalysisWorkerReceiver receiver(&worker);
+
+    // no events are processed until the restart, so every signal of the
+    // first run is still queued when the second one starts
+    worker.analyze(collection, items);
+    const int firstRun = worker.currentRun();
+
+    while(worker.isRunning() && (int(receiver.emitted) == 0))
+    {
+        QThread::yieldCurrentThread();
+    }
+
+    worker.cancel();
+    worker.wait();
+
+    QVERIFY(int(receiver.emitted) > 0);
+
+    worker.analyze(collection, items);
+    QVERIFY(worker.currentRun() != firstRun);
+
+    QTime timer;
+    timer.start();
+    while(worker.isRunning() && (timer.elapsed() < 60000))
+    {
+        QTest::qWait(10);
+    }
+    QVERIFY(!worker.isRunning());
+
+    QCoreApplication::processEvents();
+
+    QVERIFY(receiver.staleBatches > 0);
+    QVERIFY(receiver.staleProgress > 0);
+
+    // only the restarted run is kept, every item once
+    QCOMPARE(receiver.duplicates, 0);
+    QCOMPARE(receiver.values.count(), items.count());
+    QCOMPARE(receiver.lastProcessed, items.count());
+    QCOMPARE(receiver.lastTotal, items.count());
+
+    // the average of i .. i + 19
+    FUZZY_COMPARE(receiver.values.value(ID("Item0000")), 9.5);
+    FUZZY_COMPARE(receiver.values.value(ID("Item2999")), 3008.5);
+}
@@ -0,0 +1,51 @@
+#ifndef TANALYSISWORKER_H
+
+#define TANALYSISWORKER_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/AnalysisWorker.h"
+#include "../src/SqlPointListReader.h"
+#include "../src/SqlPointListWriter.h"
+#include "../src/AverageAnalysis.h"
+
+#include "../src/Metatypes.h"
+
+// keeps the signals of the current run of the worker, like the window does
+class AnalysisWorkerReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    AnalysisWorkerReceiver(AnalysisWorker *worker);
+
+    AnalysisWorker *worker;
+
+    // emitted on the worker thread, counted directly
+    QAtomicInt emitted;
+
+    QHash<ID, double> values;
+    int duplicates;
+    int staleBatches;
+    int staleProgress;
+    int lastProcessed;
+    int lastTotal;
+
+public slots:
+    void onResults(const AnalysisBatch &batch);
+    void onProgress(const int run, const int processed, const int total, const double itemsPerSecond);
+    void countEmitted(const int run, const int processed, const int total, const double itemsPerSecond);
+};
+
+class TAnalysisWorker : public QObject
+{
+    Q_OBJECT
+public:
+    TAnalysisWorker();
+
+private slots:
+    void TestCancelRestart();
+};
+
+#endif // TANALYSISWORKER_H
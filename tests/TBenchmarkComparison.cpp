@@ -0,0 +1,133 @@
+#include "TBenchmarkComparison.h"
+
+Q_DECLARE_METATYPE(QVector<qint64>)
+
+TBenchmarkComparison::TBenchmarkComparison()
+{
+}
+
+BenchmarkResult TBenchmarkComparison::result(const QString &name, const QVector<qint64> &samples)
+{
+    BenchmarkResult benchmarkResult(name, 1000.0, 8000.0);
+    benchmarkResult.samples = samples;
+
+    return benchmarkResult;
+}
+
+void TBenchmarkComparison::TestMannWhitney_data()
+{
+    QTest::addColumn< QVector<qint64> >("first");
+    QTest::addColumn< QVector<qint64> >("second");
+    QTest::addColumn<double>("pValue");
+
+    // exact: 2 of the C(6, 3) = 20 orderings are as extreme
+    QTest::newRow("exact-separated-3") << (QVector<qint64>() << 1 << 2 << 3)
+                                       << (QVector<qint64>() << 4 << 5 << 6) << 0.1;
+    // exact: 2 of C(10, 5) = 252
+    QTest::newRow("exact-separated-5") << (QVector<qint64>() << 1 << 2 << 3 << 4 << 5)
+                                       << (QVector<qint64>() << 6 << 7 << 8 << 9 << 10) << 2.0 / 252.0;
+    // exact: U = 1, 2 * 2 / 20
+    QTest::newRow("exact-one-swap") << (QVector<qint64>() << 1 << 2 << 4)
+                                    << (QVector<qint64>() << 3 << 5 << 6) << 0.2;
+    QTest::newRow("exact-interleaved") << (QVector<qint64>() << 1 << 4 << 5)
+                                       << (QVector<qint64>() << 2 << 3 << 6) << 1.0;
+    // ties: normal approximation, all equal gives no evidence
+    QTest::newRow("ties-equal") << (QVector<qint64>() << 7 << 7 << 7)
+                                << (QVector<qint64>() << 7 << 7 << 7) << 1.0;
+    QTest::newRow("empty") << QVector<qint64>()
+                           << (QVector<qint64>() << 1 << 2) << 1.0;
+}
+
+void TBenchmarkComparison::TestMannWhitney()
+{
+    QFETCH(QVector<qint64>, first);
+    QFETCH(QVector<qint64>, second);
+    QFETCH(double, pValue);
+
+    FUZZY_COMPARE(BenchmarkComparison::mannWhitneyPValue(first, second), pValue);
+    FUZZY_COMPARE(BenchmarkComparison::mannWhitneyPValue(second, first), pValue);
+}
+
+void TBenchmarkComparison::TestCompare()
+{
+    QVector<qint64> fast;
+    QVector<qint64> slow;
+    QVector<qint64> noisy;
+    for(int i = 0; i < 10; i++)
+    {
+        fast << 1000 + i;
+        slow << 1200 + i;
+        noisy << 1000 + ((i % 2 == 0) ? i : -i);
+    }
+
+    const BenchmarkResultList baseline = BenchmarkResultList()
+            << result("regressed", fast)
+            << result("improved", slow)
+            << result("noise", fast)
+            << result("removed", fast);
+
+    const BenchmarkResultList current = BenchmarkResultList()
+            << result("regressed", slow)
+            << result("improved", fast)
+            << result("noise", noisy)
+            << result("added", fast);
+
+    BenchmarkComparison comparison(0.05, 0.05);
+    QVERIFY(!comparison.compare(baseline, current));
+    QVERIFY(comparison.hasRegression());
+
+    const BenchmarkDifferenceList differences = comparison.differences();
+    QCOMPARE(differences.count(), 5);
+
+    QCOMPARE(differences.at(0).name, QString("regressed"));
+    QCOMPARE(differences.at(0).status, BenchmarkDifference::Regression);
+    // medians 1004 and 1204
+    FUZZY_COMPARE_EPS(differences.at(0).change, 0.2, 0.01);
+
+    QCOMPARE(differences.at(1).status, BenchmarkDifference::Improvement);
+    QCOMPARE(differences.at(2).status, BenchmarkDifference::Unchanged);
+    QCOMPARE(differences.at(3).status, BenchmarkDifference::Added);
+    QCOMPARE(differences.at(4).name, QString("removed"));
+    QCOMPARE(differences.at(4).status, BenchmarkDifference::Removed);
+
+    // a significant change below the threshold passes
+    comparison.setThreshold(0.5);
+    QVERIFY(comparison.compare(baseline, current));
+    QCOMPARE(comparison.differences().at(0).status, BenchmarkDifference::Unchanged);
+}
+
+void TBenchmarkComparison::TestJsonRoundTrip()
+{
+    const QString fileName = "TestBenchmarkBaseline.json";
+
+    BenchmarkRunner runner;
+    runner.setWarmups(0);
+    runner.setRepetitions(5);
+
+    BenchmarkResult &measured = runner.measure("round trip/\"quoted\" name", this, &TBenchmarkComparison::noop,
+                                               100.0, 800.0);
+    measured.parameters["threads"] = 4;
+    measured.parameters["distribution"] = QString("heavy-tailed");
+
+    QVERIFY(runner.writeJson(fileName));
+
+    BenchmarkResultList results;
+    QVERIFY(BenchmarkRunner::readJson(fileName, &results));
+    QCOMPARE(results.count(), 1);
+
+    const BenchmarkResult &read = results.first();
+    QCOMPARE(read.name, QString("round trip/\"quoted\" name"));
+    QCOMPARE(read.samples, runner.results().first().samples);
+    FUZZY_COMPARE(read.points, 100.0);
+    FUZZY_COMPARE(read.bytes, 800.0);
+    QCOMPARE(read.peakResidentSize, runner.results().first().peakResidentSize);
+    QCOMPARE(read.parameters.value("threads").toInt(), 4);
+    QCOMPARE(read.parameters.value("distribution").toString(), QString("heavy-tailed"));
+
+    // a run compared with itself doesn't regress
+    BenchmarkComparison comparison;
+    QVERIFY(comparison.compare(results, runner.results()));
+    QCOMPARE(comparison.differences().first().status, BenchmarkDifference::Unchanged);
+
+    QVERIFY(!BenchmarkRunner::readJson("TestBenchmarkMissing.json", &results));
+}
@@ -0,0 +1,31 @@
+#ifndef TBENCHMARKCOMPARISON_H
+
+#define TBENCHMARKCOMPARISON_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../benchmarks/BenchmarkRunner.h"
+#include "../benchmarks/BenchmarkComparison.h"
+
+class TBenchmarkComparison : public QObject
+{
+    Q_OBJECT
+public:
+    TBenchmarkComparison();
+
+private slots:
+    void TestMannWhitney_data();
+    void TestMannWhitney();
+
+    void TestCompare();
+    void TestJsonRoundTrip();
+
+private:
+    void noop() {}
+
+    static BenchmarkResult result(const QString &name, const QVector<qint64> &samples);
+};
+
+#endif // TBENCHMARKCOMPARISON_H
@@ -0,0 +1,170 @@
+#include "TCommandLine.h"
+
+TCommandLine::TCommandLine()
+{
+}
+
+void TCommandLine::TestParse_data()
+{
+    QTest::addColumn<QStringList>("arguments");
+    QTest::addColumn<bool>("isParsed");
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("rangeSize");
+
+    // the default thread count is the CPU count
+    const int idealThreads = QThread::idealThreadCount();
+
+    QTest::newRow("analyze") << (QStringList() << "cli" << "analyze" << "--database" << "points.db")
+                             << true << idealThreads << 0;
+
+    QTest::newRow("numbers") << (QStringList() << "cli" << "analyze" << "--database" << "points.db"
+                                 << "--threads" << "3" << "--range-size" << "500")
+                             << true << 3 << 500;
+
+    QTest::newRow("import-file") << (QStringList() << "cli" << "import" << "points.csv" << "--database" << "points.db")
+                                 << true << idealThreads << 0;
+
+    QTest::newRow("no-command") << (QStringList() << "cli")
+                                << false << idealThreads << 0;
+
+    QTest::newRow("no-database") << (QStringList() << "cli" << "statistics" << "--table" << "points")
+                                 << false << idealThreads << 0;
+
+    QTest::newRow("missing-value") << (QStringList() << "cli" << "analyze" << "--database")
+                                   << false << idealThreads << 0;
+
+    QTest::newRow("unknown-option") << (QStringList() << "cli" << "analyze" << "--database" << "points.db"
+                                        << "--color" << "red")
+                                    << false << idealThreads << 0;
+
+    QTest::newRow("extra-argument") << (QStringList() << "cli" << "import" << "a.csv" << "b.csv"
+                                        << "--database" << "points.db")
+                                    << false << idealThreads << 0;
+
+    QTest::newRow("threads-not-number") << (QStringList() << "cli" << "analyze" << "--database" << "points.db"
+                                            << "--threads" << "many")
+                                        << false << 0 << 0;
+
+    QTest::newRow("range-size-not-number") << (QStringList() << "cli" << "analyze" << "--database" << "points.db"
+                                               << "--range-size" << "1k")
+                                           << false << idealThreads << 0;
+}
+
+void TCommandLine::TestParse()
+{
+    QFETCH(QStringList, arguments);
+    QFETCH(bool, isParsed);
+    QFETCH(int, threads);
+    QFETCH(int, rangeSize);
+
+    CommandLine commandLine(arguments);
+
+    QCOMPARE(commandLine.parse(), isParsed);
+    QCOMPARE(commandLine.threads_, threads);
+    QCOMPARE(commandLine.rangeSize_, rangeSize);
+}
+
+void TCommandLine::TestMissingDatabase()
+{
+    CommandLine withoutOption(QStringList() << "cli" << "analyze");
+    QCOMPARE(withoutOption.run(), int(CommandLine::UsageError));
+
+    const QString dataBaseName = "TestCommandLineMissing.db";
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    // nothing is created for a database that doesn't exist
+    CommandLine missingFile(QStringList() << "cli" << "statistics" << "--database" << dataBaseName);
+    QCOMPARE(missingFile.run(), int(CommandLine::Failure));
+    QVERIFY(!QFile::exists(dataBaseName));
+}
+
+void TCommandLine::TestExport()
+{
+    const QString dataBaseName = "TestCommandLineExport.db";
+    const QString fileName = "TestCommandLineExport.csv";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    {
+        SqlPointListWriter writer(dataBaseName, "points");
+        writer.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+        QVERIFY(writer.open());
+        writer.write(SequencePointList() << (PointList("First") << Point(1.0) << Point(2.0)));
+    }
+
+    // a file of an earlier export is replaced
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QFile::WriteOnly | QIODevice::Text));
+        file.write("Stale;1\nStale;2\nStale;3\n");
+    }
+
+    CommandLine commandLine(QStringList() << "cli" << "export" << "--database" << dataBaseName
+                            << "--output" << fileName);
+    QCOMPARE(commandLine.run(), int(CommandLine::Success));
+
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::ReadOnly | QIODevice::Text));
+    const QString content = QString(file.readAll());
+    file.close();
+
+    QVERIFY(!content.contains("Stale"));
+    QCOMPARE(content.split('\n', QString::SkipEmptyParts).count(), 2);
+
+    // an output that can't be written fails
+    CommandLine failing(QStringList() << "cli" << "export" << "--database" << dataBaseName
+                        << "--output" << "TestCommandLineMissingDir/export.csv");
+    QCOMPARE(failing.run(), int(CommandLine::Failure));
+}
+
+void TCommandLine::TestResultsTable()
+{
+    const QString dataBaseName = "TestCommandLineResults.db";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    {
+        SqlPointListWriter writer(dataBaseName, "points");
+        writer.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+        QVERIFY(writer.open());
+        QVERIFY(writer.write(SequencePointList() << (PointList("First") << Point(1.0) << Point(2.0))));
+    }
+
+    // the points and state tables of the analyzed database are never replaced
+    const QStringList tables = QStringList() << "points" << "POINTS" << "points_state";
+    foreach(const QString &table, tables)
+    {
+        CommandLine commandLine(QStringList() << "cli" << "analyze" << "--database" << dataBaseName
+                                << "--output" << dataBaseName << "--results-table" << table);
+        QCOMPARE(commandLine.run(), int(CommandLine::UsageError));
+    }
+
+    {
+        SqlPointListReader reader(dataBaseName, "points");
+        reader.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+        QVERIFY(reader.open());
+        QCOMPARE(reader.read("First").count(), 2);
+    }
+
+    CommandLine commandLine(QStringList() << "cli" << "analyze" << "--database" << dataBaseName
+                            << "--output" << dataBaseName);
+    QCOMPARE(commandLine.run(), int(CommandLine::Success));
+}
@@ -0,0 +1,32 @@
+#ifndef TCOMMANDLINE_H
+
+#define TCOMMANDLINE_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../CommandLine.h"
+#include "../src/SqlPointListWriter.h"
+#include "../src/SqlPointListReader.h"
+
+#include "../src/Metatypes.h"
+
+class TCommandLine : public QObject
+{
+    Q_OBJECT
+public:
+    TCommandLine();
+
+private slots:
+    void TestParse_data();
+    void TestParse();
+
+    void TestMissingDatabase();
+
+    void TestExport();
+
+    void TestResultsTable();
+};
+
+#endif // TCOMMANDLINE_H
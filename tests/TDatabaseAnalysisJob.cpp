@@ -0,0 +1,247 @@
+#include "TDatabaseAnalysisJob.h"
+
+// rows kept in memory to compare them with the collection
+class MemoryAnalysisSink : public AbstractAnalysisSink
+{
+public:
+    MemoryAnalysisSink() : width(0), duplicates(0) {}
+
+    bool begin(const IDAnalysisList &outputIDs)
+    {
+        width = outputIDs.count();
+        return true;
+    }
+
+    bool write(const IDList &items, const QVector<double> &values)
+    {
+        for(int row = 0; row < items.count(); row++)
+        {
+            if(rows.contains(items.at(row)))
+            {
+                duplicates++;
+            }
+            rows.insert(items.at(row), values.mid(row * width, width));
+        }
+        return true;
+    }
+
+    bool finish()
+    {
+        return true;
+    }
+
+    int width;
+    int duplicates;
+    QHash<ID, QVector<double> > rows;
+};
+
+TDatabaseAnalysisJob::TDatabaseAnalysisJob()
+{
+}
+
+SequencePointList TDatabaseAnalysisJob::sequences(const int count) const
+{
+    SequencePointList lists;
+
+    for(int i = 0; i < count; i++)
+    {
+        PointList list(QString("id%1").arg(i, 5, 10, QChar('0')));
+
+        // a few long sequences go past the short sequences batch
+        const int length = (i % 50 == 0) ? 200 : (i % 9) + 1;
+        for(int j = 0; j < length; j++)
+        {
+            list << Point(((i * 31 + j * 17) % 23) - 11.0);
+        }
+
+        lists << list;
+    }
+
+    return lists;
+}
+
+bool TDatabaseAnalysisJob::writeDataBase(const QString &dataBaseName, const SequencePointList &lists) const
+{
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            return false;
+        }
+    }
+
+    SqlPointListWriter writer(dataBaseName, "Points");
+    writer.open();
+    writer.write(lists);
+
+    return true;
+}
+
+AnalysisCollection *TDatabaseAnalysisJob::collection() const
+{
+    AnalysisCollection *analyses = new AnalysisCollection;
+    analyses->addAnalysis(new AverageAnalysis);
+    analyses->addAnalysis(new StandardDeviationAnalysis);
+    analyses->addAnalysis(new MedianAnalysis);
+
+    return analyses;
+}
+
+void TDatabaseAnalysisJob::TestPartition()
+{
+    const QString dataBaseName = "TestPartition.db";
+    QVERIFY(writeDataBase(dataBaseName, sequences(25)));
+
+    SqlPointListReader reader(dataBaseName, "Points");
+    reader.open();
+
+    const IDRangeList ranges = DatabaseAnalysisJob::partition(&reader, 10);
+
+    QCOMPARE(ranges.count(), 3);
+    QCOMPARE(ranges.at(0).first, ID("id00000"));
+    QCOMPARE(ranges.at(0).last, ID("id00009"));
+    QCOMPARE(ranges.at(1).first, ID("id00010"));
+    QCOMPARE(ranges.at(2).last, ID("id00024"));
+
+    IDList items;
+    QList< QVector<Point> > points;
+    QVERIFY(reader.readRange(ranges.at(2).first, ranges.at(2).last, &items, &points));
+    QCOMPARE(items.count(), 5);
+    QCOMPARE(points.count(), 5);
+
+    for(int i = 0; i < items.count(); i++)
+    {
+        QVERIFY(PointList::fuzzyCompare(PointList::fromVector(items.at(i), points.at(i)), reader.read(items.at(i))));
+    }
+
+    QVERIFY(DatabaseAnalysisJob::partition(&reader, 100).count() == 1);
+}
+
+void TDatabaseAnalysisJob::TestRun_data()
+{
+    QTest::addColumn<int>("sequencesCount");
+    QTest::addColumn<int>("workersCount");
+    QTest::addColumn<int>("rangeSize");
+
+    QTest::newRow("empty") << 0 << 4 << 16;
+    QTest::newRow("one-worker") << 300 << 1 << 16;
+    QTest::newRow("more-workers-than-ranges") << 30 << 8 << 16;
+    QTest::newRow("stealing") << 1000 << 4 << 7;
+}
+
+void TDatabaseAnalysisJob::TestRun()
+{
+    QFETCH(int, sequencesCount);
+    QFETCH(int, workersCount);
+    QFETCH(int, rangeSize);
+
+    const QString dataBaseName = QString(QTest::currentDataTag()) + "TestRun.db";
+    const SequencePointList lists = sequences(sequencesCount);
+    QVERIFY(writeDataBase(dataBaseName, lists));
+
+    QScopedPointer<AnalysisCollection> analyses(collection());
+
+    DatabaseAnalysisJob job(dataBaseName, "Points");
+    job.setWorkersCount(workersCount);
+    job.setRangeSize(rangeSize);
+
+    MemoryAnalysisSink sink;
+    QVERIFY(job.run(*analyses, &sink));
+
+    QCOMPARE(job.processedCount(), sequencesCount);
+    QCOMPARE(sink.rows.count(), sequencesCount);
+    QCOMPARE(sink.duplicates, 0);
+
+    for(int i = 0; i < lists.count(); i++)
+    {
+        const QVector<double> expected = analyses->analyzeValues(lists.at(i));
+        const QVector<double> actual = sink.rows.value(lists.at(i).id());
+
+        QCOMPARE(actual.count(), expected.count());
+        for(int column = 0; column < expected.count(); column++)
+        {
+            FUZZY_COMPARE(actual.at(column), expected.at(column));
+        }
+    }
+}
+
+void TDatabaseAnalysisJob::TestSinks()
+{
+    const QString dataBaseName = "TestSinks.db";
+    const QString resultsDataBaseName = "TestSinksResults.db";
+    const QString resultsFileName = "TestSinksResults.csv";
+
+    QVERIFY(writeDataBase(dataBaseName, sequences(120)));
+
+    QScopedPointer<AnalysisCollection> analyses(collection());
+
+    DatabaseAnalysisJob job(dataBaseName, "Points");
+    job.setWorkersCount(3);
+    job.setRangeSize(25);
+
+    {
+        SqlAnalysisSink sink(resultsDataBaseName, "Results");
+        QVERIFY(job.run(*analyses, &sink));
+    }
+
+    {
+        QSqlDatabase dataBase = QSqlDatabase::addDatabase("QSQLITE", "TestSinks");
+        dataBase.setDatabaseName(resultsDataBaseName);
+        QVERIFY(dataBase.open());
+
+        QSqlQuery query(dataBase);
+        QVERIFY(query.exec("SELECT COUNT(*) FROM Results"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toInt(), 120);
+
+        query = QSqlQuery();
+        dataBase.close();
+    }
+    QSqlDatabase::removeDatabase("TestSinks");
+
+    // the results table next to the points, the workers read while it is written
+    {
+        SqlAnalysisSink sink(dataBaseName, "Results");
+        QVERIFY(job.run(*analyses, &sink));
+    }
+
+    {
+        QSqlDatabase dataBase = QSqlDatabase::addDatabase("QSQLITE", "TestSinks");
+        dataBase.setDatabaseName(dataBaseName);
+        QVERIFY(dataBase.open());
+
+        QSqlQuery query(dataBase);
+        QVERIFY(query.exec("SELECT COUNT(*) FROM Results"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toInt(), 120);
+
+        QVERIFY(query.exec("SELECT COUNT(DISTINCT " + SqlPointListInterface::columnID() + ") FROM Points"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toInt(), 120);
+
+        query = QSqlQuery();
+        dataBase.close();
+    }
+    QSqlDatabase::removeDatabase("TestSinks");
+
+    {
+        CSVAnalysisSink sink(resultsFileName);
+        QVERIFY(job.run(*analyses, &sink));
+    }
+
+    QFile file(resultsFileName);
+    QVERIFY(file.open(QFile::ReadOnly | QIODevice::Text));
+
+    const QStringList lines = QString(file.readAll()).split('\n', QString::SkipEmptyParts);
+    QCOMPARE(lines.count(), 121);
+    QCOMPARE(lines.first(), QString("id;average;standard-deviation;median"));
+    QCOMPARE(lines.at(1).split(';').count(), 4);
+
+#ifdef Q_OS_LINUX
+    // the results don't fit on the device, the error shows up when the sink is finished
+    {
+        CSVAnalysisSink sink("/dev/full");
+        QVERIFY(!job.run(*analyses, &sink));
+    }
+#endif
+}
@@ -0,0 +1,39 @@
+#ifndef TDATABASEANALYSISJOB_H
+
+#define TDATABASEANALYSISJOB_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/DatabaseAnalysisJob.h"
+#include "../src/SqlAnalysisSink.h"
+#include "../src/CSVAnalysisSink.h"
+#include "../src/SqlPointListWriter.h"
+#include "../src/AverageAnalysis.h"
+#include "../src/StandardDeviationAnalysis.h"
+#include "../src/MedianAnalysis.h"
+
+#include "../src/Metatypes.h"
+
+class TDatabaseAnalysisJob : public QObject
+{
+    Q_OBJECT
+public:
+    TDatabaseAnalysisJob();
+
+private slots:
+    void TestPartition();
+
+    void TestRun_data();
+    void TestRun();
+
+    void TestSinks();
+
+private:
+    SequencePointList sequences(const int count) const;
+    bool writeDataBase(const QString &dataBaseName, const SequencePointList &lists) const;
+    AnalysisCollection *collection() const;
+};
+
+#endif // TDATABASEANALYSISJOB_H
@@ -134,3 +134,78 @@ void TItemListModel::TestAddRemoveSql()
 
     QCOMPARE(actualData, expectedData);
 }
+
+void TItemListModel::TestPagingSql_data()
+{
+    QTest::addColumn<int>("itemsCount");
+    QTest::addColumn<int>("pageSize");
+    QTest::addColumn<int>("cachedPages");
+
+    QTest::newRow("empty") << 0 << 3 << 2;
+    QTest::newRow("one-page") << 3 << 5 << 2;
+    QTest::newRow("full-page") << 5 << 5 << 2;
+    QTest::newRow("many-pages") << 23 << 5 << 2;
+    QTest::newRow("single-cached-page") << 23 << 4 << 1;
+    QTest::newRow("page-size-one") << 7 << 1 << 3;
+}
+
+void TItemListModel::TestPagingSql()
+{
+    QFETCH(int, itemsCount);
+    QFETCH(int, pageSize);
+    QFETCH(int, cachedPages);
+
+    const QString dataBaseName = QString(QTest::currentDataTag()) + "TestPagingSql.db";
+    const QString tableName = "Points";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    IDList expectedItems;
+    SequencePointList points;
+    for(int i = itemsCount - 1; i >= 0; i--)
+    {
+        const ID item = QString("id%1").arg(i, 3, 10, QChar('0'));
+        points << (PointList(item) << Point(1.0) << Point(2.0));
+        expectedItems.prepend(item);
+    }
+
+    SqlPointListWriter writer(dataBaseName, tableName);
+    writer.open();
+    if(!points.isEmpty())
+    {
+        writer.write(points);
+    }
+
+    SqlPointListReader reader(dataBaseName, tableName);
+    reader.open();
+
+    ItemListModel model(&reader);
+    model.setCachedPages(cachedPages);
+    model.setPageSize(pageSize);
+
+    QVERIFY(model.rowCount() <= pageSize);
+
+    while(model.canFetchMore(QModelIndex()))
+    {
+        model.fetchMore(QModelIndex());
+    }
+
+    QCOMPARE(model.rowCount(), itemsCount);
+
+    IDList items;
+    for(int i = model.rowCount() - 1; i >= 0; i--)
+    {
+        items.prepend(model.index(i, 0).data().toString());
+    }
+
+    const IDList actualData = items;
+    const IDList expectedData = expectedItems;
+
+    QCOMPARE(actualData, expectedData);
+}
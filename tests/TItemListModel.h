@@ -4,6 +4,7 @@
 
 #include <QTest>
 
+#include "../mocs/MocPointListReader.h"
 #include "../src/ItemListModel.h"
 #include "../src/SqlPointListReader.h"
 #include "../src/SqlPointListWriter.h"
@@ -23,6 +24,9 @@ private slots:
 
     void TestAddRemoveSql_data();
     void TestAddRemoveSql();
+
+    void TestPagingSql_data();
+    void TestPagingSql();
 };
 
 #endif // TITEMLISTMODEL_H
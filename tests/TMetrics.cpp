@@ -0,0 +1,114 @@
+#include "TMetrics.h"
+
+TMetrics::TMetrics()
+{
+}
+
+MetricValue TMetrics::find(const QString &name)
+{
+    foreach(const MetricValue &value, Metrics::snapshot())
+    {
+        if(value.name == name)
+        {
+            return value;
+        }
+    }
+
+    return MetricValue();
+}
+
+void TMetrics::TestCounter()
+{
+    Metrics::reset();
+
+    const int index = Metrics::index("test/counter", MetricValue::Counter);
+    QVERIFY(index >= 0);
+    QCOMPARE(Metrics::index("test/counter", MetricValue::Counter), index);
+
+    Metrics::add(index, 3);
+    Metrics::add(index, 4);
+
+    const MetricValue value = find("test/counter");
+    QCOMPARE(value.name, QString("test/counter"));
+    QCOMPARE(value.kind, MetricValue::Counter);
+    QCOMPARE(value.count, qint64(7));
+
+    QVERIFY(Metrics::toString(Metrics::snapshot()).contains("test/counter: 7"));
+
+    // an invalid index of a full registry is ignored
+    Metrics::add(-1, 1);
+}
+
+void TMetrics::TestTimer()
+{
+    Metrics::reset();
+
+    const int index = Metrics::index("test/timer", MetricValue::Timer);
+    Metrics::record(index, 100);
+    Metrics::record(index, 300);
+
+    MetricValue value = find("test/timer");
+    QCOMPARE(value.count, qint64(2));
+    QCOMPARE(value.total, qint64(400));
+    QCOMPARE(value.maximum, qint64(300));
+
+    {
+        MetricsTimer timer(index);
+    }
+
+    value = find("test/timer");
+    QCOMPARE(value.count, qint64(3));
+    QVERIFY(value.total >= 400);
+}
+
+void TMetrics::TestGauge()
+{
+    Metrics::reset();
+
+    const int index = Metrics::index("test/gauge", MetricValue::Gauge);
+    Metrics::set(index, 5);
+    Metrics::set(index, 9);
+
+    QCOMPARE(find("test/gauge").total, qint64(9));
+    QCOMPARE(find("test/gauge").count, qint64(2));
+}
+
+void TMetrics::TestThreads()
+{
+    Metrics::reset();
+
+    const int index = Metrics::index("test/threads", MetricValue::Counter);
+    const int threadsCount = 4;
+    const int addsPerThread = 10000;
+
+    QList<TMetricsThread*> threads;
+    for(int i = 0; i < threadsCount; i++)
+    {
+        threads << new TMetricsThread(index, addsPerThread);
+        threads.last()->start();
+    }
+
+    Metrics::add(index, 1);
+
+    foreach(TMetricsThread *thread, threads)
+    {
+        thread->wait();
+        delete thread;
+    }
+
+    // the slots of the finished threads are folded into the registry
+    QCOMPARE(find("test/threads").count, qint64(threadsCount * addsPerThread + 1));
+}
+
+void TMetrics::TestReset()
+{
+    const int index = Metrics::index("test/reset", MetricValue::Counter);
+    Metrics::add(index, 5);
+    QCOMPARE(find("test/reset").count, qint64(5));
+
+    Metrics::reset();
+    QCOMPARE(find("test/reset").count, qint64(0));
+
+    Metrics::add(index, 2);
+    QCOMPARE(find("test/reset").count, qint64(2));
+}
@@ -0,0 +1,47 @@
+#ifndef TMETRICS_H
+
+#define TMETRICS_H
+
+#include <QTest>
+#include <QThread>
+
+#include "../src/Metrics.h"
+
+class TMetrics : public QObject
+{
+    Q_OBJECT
+public:
+    TMetrics();
+
+private slots:
+    void TestCounter();
+    void TestTimer();
+    void TestGauge();
+    void TestThreads();
+    void TestReset();
+
+private:
+    static MetricValue find(const QString &name);
+};
+
+// adds to a counter from its own thread
+class TMetricsThread : public QThread
+{
+public:
+    TMetricsThread(const int index, const int count) : index_(index), count_(count) {}
+
+protected:
+    void run()
+    {
+        for(int i = 0; i < count_; i++)
+        {
+            Metrics::add(index_, 1);
+        }
+    }
+
+private:
+    int index_;
+    int count_;
+};
+
+#endif // TMETRICS_H
@@ -0,0 +1,145 @@
+#include "TParallelPoints.h"
+
+TParallelPoints::TParallelPoints()
+{
+}
+
+void TParallelPoints::TestAccumulatorMerge_data()
+{
+    QTest::addColumn< QList<Point> >("points");
+    QTest::addColumn<int>("split");
+
+    QTest::newRow("empty") << QList<Point>() << 0;
+
+    QTest::newRow("one") << (QList<Point>() << 2.0) << 1;
+
+    QTest::newRow("left-empty") << (QList<Point>() << 1.0 << 2.0 << 4.0) << 0;
+
+    QTest::newRow("middle") << (QList<Point>() << 1.0 << 0.0 << -3.0 << 4.0 << 10.0 << 0.0) << 3;
+
+    QTest::newRow("large-offset") << (QList<Point>() << 1e9 + 1.0 << 1e9 + 2.0 << 1e9 + 3.0 << 1e9 + 4.0) << 1;
+}
+
+void TParallelPoints::TestAccumulatorMerge()
+{
+    QFETCH(QList<Point>, points);
+    QFETCH(int, split);
+
+    const QVector<Point> values = points.toVector();
+
+    PointAccumulator whole;
+    foreach(const Point point, points)
+    {
+        whole.add(point);
+    }
+
+    PointAccumulator merged = PointAccumulator::fromPoints(values.constData(), split);
+    merged.merge(PointAccumulator::fromPoints(values.constData() + split, values.count() - split));
+
+    QCOMPARE(merged.count(), whole.count());
+    QCOMPARE(merged.nonZeroCount(), whole.nonZeroCount());
+    FUZZY_COMPARE(merged.average(), whole.average());
+    FUZZY_COMPARE(merged.averageIgnoreNull(), whole.averageIgnoreNull());
+    FUZZY_COMPARE(merged.standardDeviation(), whole.standardDeviation());
+    FUZZY_COMPARE(merged.minimum(), whole.minimum());
+    FUZZY_COMPARE(merged.maximum(), whole.maximum());
+
+    PointList list;
+    foreach(const Point point, points)
+    {
+        list << point;
+    }
+
+    FUZZY_COMPARE(merged.average(), AverageAnalysis().analyze(list));
+    FUZZY_COMPARE(merged.standardDeviation(), StandardDeviationAnalysis().analyze(list));
+}
+
+void TParallelPoints::TestOrderStatistics_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("chunkSize");
+
+    QTest::newRow("small") << 10 << 3;
+    QTest::newRow("sample") << 20000 << 1000;
+    QTest::newRow("large") << 200000 << 16384;
+}
+
+void TParallelPoints::TestOrderStatistics()
+{
+    QFETCH(int, count);
+    QFETCH(int, chunkSize);
+
+    qsrand(count);
+
+    QVector<Point> values(count);
+    for(int i = 0; i < count; i++)
+    {
+        values[i] = double(qrand() % 1000) - 500.0;
+    }
+
+    QVector<Point> sorted = values;
+    qSort(sorted);
+
+    const QVector<int> ranks = QVector<int>() << 0 << count / 4 << count / 2 << count - 1;
+
+    const int oldChunkSize = ParallelPoints::chunkSize();
+    ParallelPoints::setChunkSize(chunkSize);
+
+    const QVector<Point> statistics = ParallelPoints::orderStatistics(values, ranks);
+
+    ParallelPoints::setChunkSize(oldChunkSize);
+
+    for(int i = 0; i < ranks.count(); i++)
+    {
+        FUZZY_COMPARE(statistics.at(i), sorted.at(ranks.at(i)));
+    }
+}
+
+void TParallelPoints::TestAnalyses_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("odd") << 10001;
+    QTest::newRow("even") << 10000;
+}
+
+void TParallelPoints::TestAnalyses()
+{
+    QFETCH(int, count);
+
+    qsrand(count);
+
+    PointList list("long");
+    for(int i = 0; i < count; i++)
+    {
+        list << ((qrand() % 5 == 0) ? 0.0 : double(qrand() % 100) / 4.0);
+    }
+
+    AnalysisList analyzes;
+    analyzes << new AverageAnalysis
+             << new AverageIgnoreNullAnalysis
+             << new StandardDeviationAnalysis
+             << new MedianAnalysis
+             << new FirstQuartileAnalysis
+             << new ThirdQuartileAnalysis;
+
+    const int oldThreshold = ParallelPoints::threshold();
+    const int oldChunkSize = ParallelPoints::chunkSize();
+
+    foreach(AbstractAnalysis* analysis, analyzes)
+    {
+        ParallelPoints::setThreshold(0);
+        const double expected = analysis->analyze(list);
+
+        ParallelPoints::setThreshold(1);
+        ParallelPoints::setChunkSize(999);
+        const double actual = analysis->analyze(list);
+
+        ParallelPoints::setThreshold(oldThreshold);
+        ParallelPoints::setChunkSize(oldChunkSize);
+
+        FUZZY_COMPARE(actual, expected);
+    }
+
+    qDeleteAll(analyzes);
+}
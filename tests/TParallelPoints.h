@@ -0,0 +1,36 @@
+#ifndef TPARALLELPOINTS_H
+
+#define TPARALLELPOINTS_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/ParallelPoints.h"
+#include "../src/AverageAnalysis.h"
+#include "../src/AverageIgnoreNullAnalysis.h"
+#include "../src/StandardDeviationAnalysis.h"
+#include "../src/MedianAnalysis.h"
+#include "../src/FirstQuartileAnalysis.h"
+#include "../src/ThirdQuartileAnalysis.h"
+
+#include "../src/Metatypes.h"
+
+class TParallelPoints : public QObject
+{
+    Q_OBJECT
+public:
+    TParallelPoints();
+
+private slots:
+    void TestAccumulatorMerge_data();
+    void TestAccumulatorMerge();
+
+    void TestOrderStatistics_data();
+    void TestOrderStatistics();
+
+    void TestAnalyses_data();
+    void TestAnalyses();
+};
+
+#endif // TPARALLELPOINTS_H
@@ -0,0 +1,106 @@
+#include "TPointKernels.h"
+
+TPointKernels::TPointKernels()
+{
+}
+
+void TPointKernels::TestKernels_data()
+{
+    QTest::addColumn< QList<Point> >("points");
+    QTest::addColumn<double>("sum");
+    QTest::addColumn<double>("sumOfSquares");
+    QTest::addColumn<double>("min");
+    QTest::addColumn<double>("max");
+    QTest::addColumn<int>("nonZero");
+    QTest::addColumn<int>("ones");
+
+    QTest::newRow("empty") << QList<Point>() << 0.0 << 0.0 << 0.0 << 0.0 << 0 << 0;
+
+    QTest::newRow("one") << (QList<Point>() << 1.0) << 1.0 << 1.0 << 1.0 << 1.0 << 1 << 1;
+
+    QTest::newRow("zeros") << (QList<Point>() << 0.0 << 0.0 << 0.0) << 0.0 << 0.0 << 0.0 << 0.0 << 0 << 0;
+
+    QTest::newRow("mixed") << (QList<Point>() << 1.0 << -2.0 << 0.0 << 3.5 << 1.0 << 0.0 << -1.0 << 4.0 << 1.0)
+                           << 7.5 << 36.25 << -2.0 << 4.0 << 7 << 3;
+}
+
+void TPointKernels::TestKernels()
+{
+    QFETCH(QList<Point>, points);
+    QFETCH(double, sum);
+    QFETCH(double, sumOfSquares);
+    QFETCH(double, min);
+    QFETCH(double, max);
+    QFETCH(int, nonZero);
+    QFETCH(int, ones);
+
+    const QVector<Point> values = points.toVector();
+
+    double actualMin;
+    double actualMax;
+    PointKernels::minMax(values.constData(), values.count(), &actualMin, &actualMax);
+
+    FUZZY_COMPARE(PointKernels::sum(values), sum);
+    FUZZY_COMPARE(PointKernels::sumOfSquares(values), sumOfSquares);
+    FUZZY_COMPARE(actualMin, min);
+    FUZZY_COMPARE(actualMax, max);
+    QCOMPARE(PointKernels::countNonZero(values), nonZero);
+    QCOMPARE(PointKernels::countEqual(values.constData(), values.count(), 1.0), ones);
+}
+
+void TPointKernels::TestInstructionsMatchScalar_data()
+{
+    QTest::addColumn<int>("count");
+
+    for(int count = 0; count <= 40; count++)
+    {
+        QTest::newRow(QString::number(count).toAscii().constData()) << count;
+    }
+
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("1001") << 1001;
+}
+
+void TPointKernels::TestInstructionsMatchScalar()
+{
+    QFETCH(int, count);
+
+    qsrand(count);
+
+    QVector<Point> values(count);
+    for(int i = 0; i < count; i++)
+    {
+        values[i] = double(qrand() % 11 - 5) / 2.0;
+    }
+
+    const PointKernels::Instructions supported = PointKernels::supportedInstructions();
+
+    PointKernels::setInstructions(PointKernels::Scalar);
+
+    const double sum = PointKernels::sum(values);
+    const double sumOfSquares = PointKernels::sumOfSquares(values, 0.25);
+    const int nonZero = PointKernels::countNonZero(values);
+    const int halves = PointKernels::countEqual(values.constData(), values.count(), 0.5);
+
+    double min;
+    double max;
+    PointKernels::minMax(values.constData(), values.count(), &min, &max);
+
+    for(int instructions = PointKernels::SSE2; instructions <= supported; instructions++)
+    {
+        PointKernels::setInstructions(PointKernels::Instructions(instructions));
+
+        double actualMin;
+        double actualMax;
+        PointKernels::minMax(values.constData(), values.count(), &actualMin, &actualMax);
+
+        FUZZY_COMPARE(PointKernels::sum(values), sum);
+        FUZZY_COMPARE(PointKernels::sumOfSquares(values, 0.25), sumOfSquares);
+        FUZZY_COMPARE(actualMin, min);
+        FUZZY_COMPARE(actualMax, max);
+        QCOMPARE(PointKernels::countNonZero(values), nonZero);
+        QCOMPARE(PointKernels::countEqual(values.constData(), values.count(), 0.5), halves);
+    }
+
+    PointKernels::setInstructions(supported);
+}
@@ -0,0 +1,27 @@
+#ifndef TPOINTKERNELS_H
+
+#define TPOINTKERNELS_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/PointKernels.h"
+
+#include "../src/Metatypes.h"
+
+class TPointKernels : public QObject
+{
+    Q_OBJECT
+public:
+    TPointKernels();
+
+private slots:
+    void TestKernels_data();
+    void TestKernels();
+
+    void TestInstructionsMatchScalar_data();
+    void TestInstructionsMatchScalar();
+};
+
+#endif // TPOINTKERNELS_H
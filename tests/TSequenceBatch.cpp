@@ -0,0 +1,162 @@
+#include "TSequenceBatch.h"
+
+TSequenceBatch::TSequenceBatch()
+{
+}
+
+void TSequenceBatch::TestPointLists_data()
+{
+    QTest::addColumn<SequencePointList>("sequences");
+
+    QTest::newRow("empty") << SequencePointList();
+
+    QTest::newRow("one") << (SequencePointList()
+                             << (PointList("First") << 1.0 << 2.0));
+
+    QTest::newRow("different-lengths") << (SequencePointList()
+                                           << (PointList("First") << 1.0)
+                                           << PointList("Second")
+                                           << (PointList("Third") << 3.0 << -1.0 << 4.0)
+                                           << (PointList("Four") << 0.5 << 0.0));
+}
+
+void TSequenceBatch::TestPointLists()
+{
+    QFETCH(SequencePointList, sequences);
+
+    SequenceBatch batch;
+    for(int i = 0; i < sequences.count(); i++)
+    {
+        QVERIFY(batch.append(sequences.at(i)));
+    }
+
+    QCOMPARE(batch.count(), sequences.count());
+
+    for(int i = 0; i < sequences.count(); i++)
+    {
+        QCOMPARE(batch.id(i), sequences.at(i).id());
+        QCOMPARE(batch.pointsCount(i), sequences.at(i).count());
+        QVERIFY(PointList::fuzzyCompare(batch.pointList(i), sequences.at(i)));
+    }
+
+    QVector<Point> tooLong(SequenceBatch::maxPoints + 1);
+    QVERIFY(!batch.append("too-long", tooLong));
+    QCOMPARE(batch.count(), sequences.count());
+}
+
+void TSequenceBatch::TestStatistics_data()
+{
+    QTest::addColumn<int>("sequencesCount");
+    QTest::addColumn<int>("maxPoints");
+
+    QTest::newRow("one-point") << 1000 << 1;
+    QTest::newRow("short") << 37 << 5;
+    QTest::newRow("up-to-twenty") << 1000 << 20;
+    QTest::newRow("max") << 17 << SequenceBatch::maxPoints;
+}
+
+void TSequenceBatch::TestStatistics()
+{
+    QFETCH(int, sequencesCount);
+    QFETCH(int, maxPoints);
+
+    qsrand(sequencesCount + maxPoints);
+
+    SequenceBatch batch;
+    SequencePointList sequences;
+
+    for(int i = 0; i < sequencesCount; i++)
+    {
+        PointList list(QString("id%1").arg(i));
+
+        const int pointsCount = qrand() % (maxPoints + 1);
+        for(int j = 0; j < pointsCount; j++)
+        {
+            list << double(qrand() % 9 - 4) / 2.0;
+        }
+
+        sequences.append(list);
+        batch.append(list);
+    }
+
+    const PointKernels::Instructions supported = PointKernels::supportedInstructions();
+
+    for(int instructions = PointKernels::Scalar; instructions <= supported; instructions++)
+    {
+        PointKernels::setInstructions(PointKernels::Instructions(instructions));
+
+        const SequenceBatchResults results = batch.analyze();
+
+        for(int i = 0; i < sequences.count(); i++)
+        {
+            const QVector<Point> points = sequences.at(i).toVector();
+
+            double min = 0.0;
+            double max = 0.0;
+            PointKernels::minMax(points.constData(), points.count(), &min, &max);
+
+            FUZZY_COMPARE(results.averages.at(i), AverageAnalysis().analyze(sequences.at(i)));
+            FUZZY_COMPARE(results.averagesIgnoreNull.at(i), AverageIgnoreNullAnalysis().analyze(sequences.at(i)));
+            FUZZY_COMPARE(results.deviations.at(i), StandardDeviationAnalysis().analyze(sequences.at(i)));
+            FUZZY_COMPARE(results.minimums.at(i), min);
+            FUZZY_COMPARE(results.maximums.at(i), max);
+        }
+    }
+
+    PointKernels::setInstructions(supported);
+}
+
+void TSequenceBatch::TestCollectionBatch_data()
+{
+    QTest::addColumn<AnalysisList>("analyzes");
+
+    QTest::newRow("batched") << (AnalysisList()
+                                 << new AverageAnalysis
+                                 << new StandardDeviationAnalysis);
+
+    QTest::newRow("mixed") << (AnalysisList()
+                               << new MedianAnalysis
+                               << new AverageIgnoreNullAnalysis
+                               << new AverageAnalysis);
+
+    QTest::newRow("multi-output") << (AnalysisList()
+                                      << new AverageAnalysis
+                                      << new PercentileAnalysis
+                                      << new StandardDeviationAnalysis);
+}
+
+void TSequenceBatch::TestCollectionBatch()
+{
+    QFETCH(AnalysisList, analyzes);
+
+    AnalysisCollection collection(analyzes);
+
+    SequencePointList sequences;
+    sequences << (PointList("First") << 1.0 << 2.0 << 6.0)
+              << (PointList("Second") << 0.0)
+              << PointList("Third")
+              << (PointList("Four") << -1.0 << 0.0 << 1.0 << 4.0);
+
+    SequenceBatch batch;
+    for(int i = 0; i < sequences.count(); i++)
+    {
+        batch.append(sequences.at(i));
+    }
+
+    const QVector<double> values = collection.analyzeBatch(batch);
+    const int width = collection.outputCount();
+
+    QCOMPARE(values.count(), sequences.count() * width);
+
+    for(int i = 0; i < sequences.count(); i++)
+    {
+        const QVector<double> expected = collection.analyzeValues(sequences.at(i));
+
+        for(int column = 0; column < width; column++)
+        {
+            FUZZY_COMPARE(values.at(i * width + column), expected.at(column));
+        }
+    }
+
+    qDeleteAll(analyzes);
+}
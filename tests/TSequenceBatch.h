@@ -0,0 +1,35 @@
+#ifndef TSEQUENCEBATCH_H
+
+#define TSEQUENCEBATCH_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/SequenceBatch.h"
+#include "../src/AverageAnalysis.h"
+#include "../src/AverageIgnoreNullAnalysis.h"
+#include "../src/StandardDeviationAnalysis.h"
+#include "../src/MedianAnalysis.h"
+#include "../src/PercentileAnalysis.h"
+
+#include "../src/Metatypes.h"
+
+class TSequenceBatch : public QObject
+{
+    Q_OBJECT
+public:
+    TSequenceBatch();
+
+private slots:
+    void TestPointLists_data();
+    void TestPointLists();
+
+    void TestStatistics_data();
+    void TestStatistics();
+
+    void TestCollectionBatch_data();
+    void TestCollectionBatch();
+};
+
+#endif // TSEQUENCEBATCH_H
@@ -0,0 +1,129 @@
+#include "TSequenceState.h"
+
+TSequenceState::TSequenceState()
+{
+}
+
+void TSequenceState::TestAppend_data()
+{
+    QTest::addColumn<PointList>("points");
+
+    QTest::newRow("empty") << PointList("Empty");
+    QTest::newRow("one") << (PointList("One") << 3.0);
+    QTest::newRow("zeros") << (PointList("Zeros") << 0.0 << 2.0 << 0.0 << -4.0 << 7.5);
+}
+
+void TSequenceState::TestAppend()
+{
+    QFETCH(PointList, points);
+
+    const QVector<Point> values = points.toVector();
+    const SequenceState whole = SequenceState::fromPoints(values);
+
+    SequenceState appended;
+    for(int i = 0; i < values.count(); i++)
+    {
+        appended.append(values.at(i));
+    }
+
+    QCOMPARE(appended.count(), qint64(values.count()));
+    QCOMPARE(appended.accumulator().nonZeroCount(), whole.accumulator().nonZeroCount());
+
+    FUZZY_COMPARE(appended.accumulator().average(), AverageAnalysis().analyze(points));
+    FUZZY_COMPARE(appended.accumulator().averageIgnoreNull(), AverageIgnoreNullAnalysis().analyze(points));
+    FUZZY_COMPARE(appended.accumulator().standardDeviation(), StandardDeviationAnalysis().analyze(points));
+    FUZZY_COMPARE(appended.digest().quantile(0.5), MedianAnalysis().analyze(points));
+}
+
+void TSequenceState::TestSerialization()
+{
+    SequenceState state;
+    for(int i = 0; i < 10000; i++)
+    {
+        state.append(double(i % 97) - 48.0);
+    }
+
+    bool ok = false;
+    const SequenceState restored = SequenceState::fromByteArray(state.toByteArray(), &ok);
+
+    QVERIFY(ok);
+    QCOMPARE(restored.count(), state.count());
+    FUZZY_COMPARE(restored.accumulator().average(), state.accumulator().average());
+    FUZZY_COMPARE(restored.accumulator().standardDeviation(), state.accumulator().standardDeviation());
+    FUZZY_COMPARE(restored.accumulator().minimum(), state.accumulator().minimum());
+    FUZZY_COMPARE(restored.accumulator().maximum(), state.accumulator().maximum());
+    FUZZY_COMPARE(restored.digest().quantile(0.9), state.digest().quantile(0.9));
+
+    SequenceState::fromByteArray(QByteArray("broken"), &ok);
+    QVERIFY(!ok);
+}
+
+void TSequenceState::TestCollectionState()
+{
+    AnalysisList analyzes;
+    analyzes << new StupidAnalysis(2.0)
+             << new AverageAnalysis
+             << new AverageIgnoreNullAnalysis
+             << new StandardDeviationAnalysis
+             << new QuantileSketchAnalysis(0.5);
+
+    AnalysisCollection collection(analyzes);
+    qDeleteAll(analyzes);
+
+    QVERIFY(collection.isIncremental());
+
+    const PointList points = PointList("Points") << 1.0 << 0.0 << 5.0 << 3.0 << 0.0 << 8.0;
+    const QVector<double> expected = collection.analyzeValues(points);
+    const QVector<double> actual = collection.analyzeState(SequenceState::fromPoints(points.toVector()));
+
+    QCOMPARE(actual.count(), expected.count());
+    for(int i = 0; i < expected.count(); i++)
+    {
+        FUZZY_COMPARE(actual.at(i), expected.at(i));
+    }
+
+    MedianAnalysis median;
+    collection.addAnalysis(&median);
+    QVERIFY(!collection.isIncremental());
+}
+
+void TSequenceState::TestStoredState()
+{
+    const QString dataBaseName = "TestStoredState.db";
+    const QString tableName = "Points";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    SqlPointListWriter writer(dataBaseName, tableName);
+    writer.open();
+    writer.write(PointList("Sensor") << 1.0 << 2.0 << 3.0);
+
+    SqlPointListReader reader(dataBaseName, tableName);
+    reader.open();
+
+    SequenceState state;
+    QVERIFY(!reader.readState("Sensor", &state));
+
+    // the first append builds the state from the written points
+    QVERIFY(writer.append("Sensor", QVector<Point>() << 4.0 << 0.0));
+    QVERIFY(writer.append("Sensor", QVector<Point>() << 10.0));
+    QVERIFY(writer.append("New", QVector<Point>() << 7.0));
+
+    const PointList expected = PointList("Sensor") << 1.0 << 2.0 << 3.0 << 4.0 << 0.0 << 10.0;
+    QVERIFY(PointList::fuzzyCompare(reader.read("Sensor"), expected));
+
+    QVERIFY(reader.readState("Sensor", &state));
+    QCOMPARE(state.count(), qint64(expected.count()));
+    FUZZY_COMPARE(state.accumulator().average(), AverageAnalysis().analyze(expected));
+    FUZZY_COMPARE(state.accumulator().standardDeviation(), StandardDeviationAnalysis().analyze(expected));
+    FUZZY_COMPARE(state.accumulator().maximum(), 10.0);
+
+    QVERIFY(reader.readState("New", &state));
+    QCOMPARE(state.count(), qint64(1));
+}
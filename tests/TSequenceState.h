@@ -0,0 +1,36 @@
+#ifndef TSEQUENCESTATE_H
+
+#define TSEQUENCESTATE_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/SequenceState.h"
+#include "../src/SqlPointListReader.h"
+#include "../src/SqlPointListWriter.h"
+#include "../src/StupidAnalysis.h"
+#include "../src/AverageAnalysis.h"
+#include "../src/AverageIgnoreNullAnalysis.h"
+#include "../src/StandardDeviationAnalysis.h"
+#include "../src/MedianAnalysis.h"
+#include "../src/QuantileSketchAnalysis.h"
+
+#include "../src/Metatypes.h"
+
+class TSequenceState : public QObject
+{
+    Q_OBJECT
+public:
+    TSequenceState();
+
+private slots:
+    void TestAppend_data();
+    void TestAppend();
+
+    void TestSerialization();
+    void TestCollectionState();
+    void TestStoredState();
+};
+
+#endif // TSEQUENCESTATE_H
@@ -352,3 +352,102 @@ void TSqlPointListReader::TestStatistics()
 
     QCOMPARE(actualStatisticReaderValue, expectedStatisticReaderValue);
 }
+
+void TSqlPointListReader::TestAggregates()
+{
+    const QString dataBaseName = "TestAggregates.db";
+    const QString tableName = "Points";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    SqlPointListWriter writer(dataBaseName, tableName);
+    writer.open();
+    writer.write(SequencePointList()
+                 << (PointList("First") << Point(3.0) << Point(0.0) << Point(-1.0) << Point(6.0))
+                 << (PointList("Second") << Point(0.0) << Point(0.0))
+                 << (PointList("Third") << Point(2.5)));
+
+    SqlPointListReader reader(dataBaseName, tableName);
+    reader.open();
+
+    QVERIFY(reader.canAggregate(StorageAggregateList() << StorageAggregate::Average));
+    QCOMPARE(reader.readPointsCount("First"), 4);
+    QCOMPARE(reader.readPointsCount("Missing"), 0);
+
+    const StorageAggregateList aggregates = StorageAggregateList()
+            << StorageAggregate::Average
+            << StorageAggregate::Count
+            << StorageAggregate::Minimum
+            << StorageAggregate::Maximum
+            << StorageAggregate::AverageIgnoreNull;
+
+    // rows follow the order of the items, missing items give 0
+    const IDList items = IDList() << "Third" << "Missing" << "First" << "Second";
+
+    QVector<double> values;
+    QVERIFY(reader.readAggregates(items, aggregates, &values));
+    QCOMPARE(values.count(), items.count() * aggregates.count());
+
+    const double expected[] = {2.5, 1.0, 2.5, 2.5, 2.5,
+                               0.0, 0.0, 0.0, 0.0, 0.0,
+                               2.0, 4.0, -1.0, 6.0, 8.0 / 3.0,
+                               0.0, 2.0, 0.0, 0.0, 0.0};
+
+    for(int i = 0; i < values.count(); i++)
+    {
+        FUZZY_COMPARE(values.at(i), expected[i]);
+    }
+
+    QVERIFY(!reader.readAggregates(items, StorageAggregateList() << StorageAggregate::NoAggregate, &values));
+}
+
+void TSqlPointListReader::TestReadOnly()
+{
+    const QString dataBaseName = "TestReadOnly.db";
+    const QString tableName = "Points";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    {
+        // a read-only reader never creates the database
+        SqlPointListReader reader(dataBaseName, tableName);
+        reader.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+        reader.setReadOnly(true);
+
+        QVERIFY(!reader.open());
+        QVERIFY(!QFile::exists(dataBaseName));
+    }
+
+    {
+        SqlPointListWriter writer(dataBaseName, tableName);
+        writer.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+        writer.open();
+        writer.write(SequencePointList() << (PointList("First") << Point(1.0) << Point(2.0)));
+    }
+
+    SqlPointListReader reader(dataBaseName, tableName);
+    reader.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+    reader.setReadOnly(true);
+
+    QVERIFY(reader.open());
+    QVERIFY(reader.isReadOnly());
+    QCOMPARE(reader.readItems(ID(), 10), IDList() << "First");
+    QCOMPARE(reader.readPointsCount("First"), 2);
+
+    SqlPointListReader* clone = reader.clone();
+    QVERIFY(clone->isReadOnly());
+    QCOMPARE(clone->readPointsCount("First"), 2);
+    delete clone;
+}
@@ -23,6 +23,9 @@ private slots:
 
     void TestStatistics_data();
     void TestStatistics();
+
+    void TestAggregates();
+    void TestReadOnly();
 };
 
 #endif // TSQLPOINTLISTREADER_H
@@ -0,0 +1,135 @@
+#include "TSqliteAggregateFunctions.h"
+
+TSqliteAggregateFunctions::TSqliteAggregateFunctions()
+{
+}
+
+SequencePointList TSqliteAggregateFunctions::sequences() const
+{
+    return SequencePointList()
+            << (PointList("First") << Point(3.0) << Point(0.0) << Point(-1.0) << Point(6.0) << Point(2.5))
+            << (PointList("Second") << Point(0.0) << Point(0.0))
+            << (PointList("Third") << Point(7.25))
+            << (PointList("Four") << Point(4.0) << Point(1.0) << Point(9.0) << Point(1.0));
+}
+
+bool TSqliteAggregateFunctions::writeDataBase(const QString &dataBaseName, const QString &tableName) const
+{
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            return false;
+        }
+    }
+
+    SqlPointListWriter writer(dataBaseName, tableName);
+    writer.open();
+    writer.write(sequences());
+
+    return true;
+}
+
+void TSqliteAggregateFunctions::TestFunctions()
+{
+    const QString dataBaseName = "TestFunctions.db";
+    const QString tableName = "Points";
+
+    QVERIFY(writeDataBase(dataBaseName, tableName));
+
+    SqlPointListReader reader(dataBaseName, tableName);
+    reader.open();
+
+    const bool isNative = reader.hasAggregateFunctions();
+    QVERIFY(!isNative || SqliteAggregateFunctions::isAvailable());
+
+    // the non-zero average has a plain SQL fallback, the other ones don't
+    QVERIFY(reader.canAggregate(StorageAggregateList() << StorageAggregate::AverageIgnoreNull));
+    QCOMPARE(reader.canAggregate(StorageAggregateList() << StorageAggregate::StandardDeviation), isNative);
+    QCOMPARE(reader.canAggregate(StorageAggregateList() << StorageAggregate::Median), isNative);
+    QCOMPARE(reader.canAggregate(StorageAggregateList() << StorageAggregate(StorageAggregate::Quantile, 0.25)), isNative);
+
+    if(!isNative)
+    {
+        return;
+    }
+
+    QSqlQuery query(reader.dataBase());
+    QVERIFY(query.exec("SELECT id, stddev(value), median(value), quantile(value, 0.25), nonzero_avg(value)"
+                       " FROM " + tableName + " GROUP BY id"));
+
+    const SequencePointList lists = sequences();
+    int groups = 0;
+
+    while(query.next())
+    {
+        const ID id = query.value(0).toString();
+
+        PointList list;
+        for(int i = 0; i < lists.count(); i++)
+        {
+            if(lists.at(i).id() == id)
+            {
+                list = lists.at(i);
+            }
+        }
+
+        FUZZY_COMPARE(query.value(1).toDouble(), StandardDeviationAnalysis().analyze(list));
+        FUZZY_COMPARE(query.value(2).toDouble(), MedianAnalysis().analyze(list));
+        FUZZY_COMPARE(query.value(3).toDouble(), PercentileAnalysis(QList<double>() << 25.0).analyze(list));
+        FUZZY_COMPARE(query.value(4).toDouble(), AverageIgnoreNullAnalysis().analyze(list));
+        groups++;
+    }
+
+    QCOMPARE(groups, lists.count());
+
+    // empty tables give one group of zeros
+    QVERIFY(query.exec("SELECT stddev(value), median(value), quantile(value, 0.5), nonzero_avg(value)"
+                       " FROM " + tableName + " WHERE id = 'Missing'"));
+    QVERIFY(query.next());
+    for(int i = 0; i < 4; i++)
+    {
+        FUZZY_COMPARE(query.value(i).toDouble(), 0.0);
+    }
+}
+
+void TSqliteAggregateFunctions::TestCollection()
+{
+    const QString dataBaseName = "TestCollection.db";
+    const QString tableName = "Points";
+
+    QVERIFY(writeDataBase(dataBaseName, tableName));
+
+    SqlPointListReader reader(dataBaseName, tableName);
+    reader.open();
+
+    AnalysisCollection collection;
+    collection.addAnalysis(new StandardDeviationAnalysis);
+    collection.addAnalysis(new MedianAnalysis);
+    collection.addAnalysis(new PercentileAnalysis);
+
+    QVERIFY(collection.isAggregate());
+
+    const IDList items = IDList() << "Four" << "First" << "Second" << "Third";
+
+    QVector<double> values;
+    QCOMPARE(collection.analyzeStorage(&reader, items, &values), reader.hasAggregateFunctions());
+
+    if(!reader.hasAggregateFunctions())
+    {
+        return;
+    }
+
+    const int width = collection.outputCount();
+    QCOMPARE(values.count(), items.count() * width);
+
+    for(int row = 0; row < items.count(); row++)
+    {
+        const QVector<double> expected = collection.analyzeValues(reader.read(items.at(row)));
+
+        for(int column = 0; column < width; column++)
+        {
+            FUZZY_COMPARE(values.at(row * width + column), expected.at(column));
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef TSQLITEAGGREGATEFUNCTIONS_H
+
+#define TSQLITEAGGREGATEFUNCTIONS_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/SqliteAggregateFunctions.h"
+#include "../src/SqlPointListReader.h"
+#include "../src/SqlPointListWriter.h"
+#include "../src/AverageIgnoreNullAnalysis.h"
+#include "../src/StandardDeviationAnalysis.h"
+#include "../src/MedianAnalysis.h"
+#include "../src/PercentileAnalysis.h"
+
+#include "../src/Metatypes.h"
+
+class TSqliteAggregateFunctions : public QObject
+{
+    Q_OBJECT
+public:
+    TSqliteAggregateFunctions();
+
+private slots:
+    void TestFunctions();
+    void TestCollection();
+
+private:
+    SequencePointList sequences() const;
+    bool writeDataBase(const QString &dataBaseName, const QString &tableName) const;
+};
+
+#endif // TSQLITEAGGREGATEFUNCTIONS_H
@@ -0,0 +1,85 @@
+#include "TStaticAnalysisSet.h"
+
+#include <algorithm>
+
+typedef StaticAnalysisSet<StaticAverage,
+                          StaticAverageIgnoreNull,
+                          StaticStandardDeviation,
+                          StaticMedian,
+                          StaticFirstQuartile,
+                          StaticThirdQuartile,
+                          StaticMinimum,
+                          StaticMaximum> AllStaticAnalyses;
+
+typedef StaticAnalysisSet<StaticAverage, StaticStandardDeviation, StaticMedian> DefaultStaticAnalyses;
+
+TStaticAnalysisSet::TStaticAnalysisSet()
+{
+}
+
+void TStaticAnalysisSet::TestLayout()
+{
+    QCOMPARE(int(DefaultStaticAnalyses::size), 3);
+    QCOMPARE(DefaultStaticAnalyses::ids(), IDAnalysisList() << "average" << "standard-deviation" << "median");
+
+    QCOMPARE(int(DefaultStaticAnalyses::needs),
+             int(StaticPointContext::NeedsSum | StaticPointContext::NeedsSquares | StaticPointContext::NeedsSorted));
+
+    QCOMPARE(int(AllStaticAnalyses::size), 8);
+}
+
+void TStaticAnalysisSet::TestResults_data()
+{
+    QTest::addColumn<PointList>("values");
+
+    QTest::newRow("empty") << PointList("Empty");
+    QTest::newRow("one-value") << (PointList("One") << 26.0);
+    QTest::newRow("zeros") << (PointList("Zeros") << 0.0 << 0.0 << 0.0);
+    QTest::newRow("even") << (PointList("Even") << 23.0 << -5.0 << 0.0 << 31.0);
+    QTest::newRow("odd") << (PointList("Odd") << -3.0 << 13.0 << 17.5 << 15.0 << -4.5 << 0.0 << 2.0);
+}
+
+void TStaticAnalysisSet::TestResults()
+{
+    QFETCH(PointList, values);
+
+    double outputs[AllStaticAnalyses::size];
+    AllStaticAnalyses::analyze(values.toVector(), outputs);
+
+    FUZZY_COMPARE(outputs[0], AverageAnalysis().analyze(values));
+    FUZZY_COMPARE(outputs[1], AverageIgnoreNullAnalysis().analyze(values));
+    FUZZY_COMPARE(outputs[2], StandardDeviationAnalysis().analyze(values));
+    FUZZY_COMPARE(outputs[3], MedianAnalysis().analyze(values));
+    FUZZY_COMPARE(outputs[4], FirstQuartileAnalysis().analyze(values));
+    FUZZY_COMPARE(outputs[5], ThirdQuartileAnalysis().analyze(values));
+
+    const QList<Point> points = values.points();
+    FUZZY_COMPARE(outputs[6], points.isEmpty() ? 0.0 : *std::min_element(points.constBegin(), points.constEnd()));
+    FUZZY_COMPARE(outputs[7], points.isEmpty() ? 0.0 : *std::max_element(points.constBegin(), points.constEnd()));
+}
+
+void TStaticAnalysisSet::TestAdapter()
+{
+    StaticAnalysisAdapter<DefaultStaticAnalyses> adapter;
+
+    QCOMPARE(adapter.id(), IDAnalysis("static-average-standard-deviation-median"));
+    QCOMPARE(adapter.outputCount(), 3);
+
+    AnalysisCollection collection;
+    collection.addAnalysis(&adapter);
+
+    QCOMPARE(collection.getOutputIDList(), DefaultStaticAnalyses::ids());
+
+    const PointList values = PointList("Values") << 5.0 << 9.0 << 14.0 << 0.0;
+    const AnalysisResult result = collection.analyze(values);
+
+    FUZZY_COMPARE(result.value("average"), AverageAnalysis().analyze(values));
+    FUZZY_COMPARE(result.value("standard-deviation"), StandardDeviationAnalysis().analyze(values));
+    FUZZY_COMPARE(result.value("median"), MedianAnalysis().analyze(values));
+    FUZZY_COMPARE(adapter.analyze(values), AverageAnalysis().analyze(values));
+
+    // the outputs are taken, the same analyses can not be added once more
+    AverageAnalysis average;
+    collection.addAnalysis(&average);
+    QCOMPARE(collection.size(), 1);
+}
@@ -0,0 +1,34 @@
+#ifndef TSTATICANALYSISSET_H
+
+#define TSTATICANALYSISSET_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/StaticAnalysisSet.h"
+#include "../src/AverageAnalysis.h"
+#include "../src/AverageIgnoreNullAnalysis.h"
+#include "../src/StandardDeviationAnalysis.h"
+#include "../src/MedianAnalysis.h"
+#include "../src/FirstQuartileAnalysis.h"
+#include "../src/ThirdQuartileAnalysis.h"
+
+#include "../src/Metatypes.h"
+
+class TStaticAnalysisSet : public QObject
+{
+    Q_OBJECT
+public:
+    TStaticAnalysisSet();
+
+private slots:
+    void TestLayout();
+
+    void TestResults_data();
+    void TestResults();
+
+    void TestAdapter();
+};
+
+#endif // TSTATICANALYSISSET_H
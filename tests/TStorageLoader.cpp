@@ -0,0 +1,173 @@
+#include "TStorageLoader.h"
+
+TStorageLoader::TStorageLoader()
+{
+}
+
+void TStorageLoader::TestLoad()
+{
+    const QString dataBaseName = "TestStorageLoader.db";
+    const QString tableName = "Points";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    {
+        SequencePointList lists;
+        for(int i = 0; i < 25; i++)
+        {
+            lists << (PointList(QString("Item%1").arg(i, 2, 10, QChar('0'))) << Point(i) << Point(2 * i));
+        }
+
+        SqlPointListWriter writer(dataBaseName, tableName);
+        writer.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+        writer.open();
+        writer.write(lists);
+    }
+
+    StorageLoader loader(dataBaseName, tableName);
+
+    // the signals are emitted from the loader thread, the spies are connected directly
+    QSignalSpy itemsSpy(&loader, SIGNAL(itemsLoaded(IDList)));
+    QSignalSpy statisticsSpy(&loader, SIGNAL(statisticsLoaded(PointListStorageStatistics)));
+    QSignalSpy failedSpy(&loader, SIGNAL(loadFailed()));
+
+    loader.load();
+    loader.wait();
+
+    QCOMPARE(failedSpy.count(), 0);
+    QCOMPARE(itemsSpy.count(), 1);
+    QCOMPARE(statisticsSpy.count(), 1);
+    QVERIFY(loader.isStatisticsLoaded());
+    QVERIFY(loader.statistics().size() > 0);
+
+    const IDList firstPage = itemsSpy.at(0).at(0).value<IDList>();
+    QCOMPARE(firstPage.count(), 25);
+    QCOMPARE(firstPage.first(), ID("Item00"));
+
+    // the model takes the loaded page, so a reader that is not opened yet is not queried
+    SqlPointListReader reader(dataBaseName, tableName);
+    reader.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+
+    ItemListModel model(&reader, firstPage);
+    QCOMPARE(model.rowCount(), 25);
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+    QCOMPARE(model.data(model.index(24, 0)).toString(), QString("Item24"));
+}
+
+void TStorageLoader::TestGenerate()
+{
+    const QString dataBaseName = "TestStorageLoaderGenerate.db";
+    const QString tableName = "Points";
+
+    StorageLoader loader(dataBaseName, tableName);
+    loader.setGeneratedSequences(30);
+    loader.setPageSize(100);
+
+    QSignalSpy itemsSpy(&loader, SIGNAL(itemsLoaded(IDList)));
+
+    loader.load();
+    loader.wait();
+
+    QCOMPARE(itemsSpy.count(), 1);
+    QCOMPARE(itemsSpy.at(0).at(0).value<IDList>().count(), 30);
+
+    // the next load keeps the generated database
+    QCOMPARE(loader.generatedSequences(), 0);
+}
+
+void TStorageLoader::TestMissingDatabase()
+{
+    const QString dataBaseName = "TestStorageLoaderMissing.db";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    StorageLoader loader(dataBaseName, "Points");
+
+    QSignalSpy itemsSpy(&loader, SIGNAL(itemsLoaded(IDList)));
+    QSignalSpy failedSpy(&loader, SIGNAL(loadFailed()));
+
+    loader.load();
+    loader.wait();
+
+    QCOMPARE(itemsSpy.count(), 0);
+    QCOMPARE(failedSpy.count(), 1);
+    QVERIFY(!loader.isStatisticsLoaded());
+    QVERIFY(!QFile::exists(dataBaseName));
+}
+
+void TStorageLoader::TestMissingStateTable()
+{
+    const QString dataBaseName = "TestStorageLoaderNoState.db";
+    const QString tableName = "Points";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    // a database of a version that didn't store the sequence states
+    {
+        QSqlDatabase dataBase = QSqlDatabase::addDatabase("QSQLITE", "TestMissingStateTable");
+        dataBase.setDatabaseName(dataBaseName);
+        QVERIFY(dataBase.open());
+
+        QSqlQuery query(dataBase);
+        QVERIFY(query.exec("CREATE TABLE " + tableName + " (id VARCHAR, num INT, value REAL, PRIMARY KEY(id, num))"));
+        for(int i = 0; i < 10; i++)
+        {
+            QVERIFY(query.exec(QString("INSERT INTO %1 VALUES ('Item%2', 0, %3)").arg(tableName).arg(i).arg(i)));
+        }
+
+        query = QSqlQuery();
+        dataBase.close();
+    }
+    QSqlDatabase::removeDatabase("TestMissingStateTable");
+
+    StorageLoader loader(dataBaseName, tableName);
+
+    QSignalSpy itemsSpy(&loader, SIGNAL(itemsLoaded(IDList)));
+    QSignalSpy failedSpy(&loader, SIGNAL(loadFailed()));
+
+    loader.load();
+    loader.wait();
+
+    QCOMPARE(failedSpy.count(), 0);
+    QCOMPARE(itemsSpy.count(), 1);
+    QCOMPARE(itemsSpy.at(0).at(0).value<IDList>().count(), 10);
+
+    {
+        SqlPointListReader reader(dataBaseName, tableName);
+        reader.setConnectionName(SqlPointListInterface::uniqueConnectionName());
+        reader.setReadOnly(true);
+        QVERIFY(reader.open());
+
+        SequenceState state;
+        QVERIFY(!reader.readState(ID("Item0"), &state));
+        QCOMPARE(reader.readValues(ID("Item3")).count(), 1);
+    }
+
+    // the read-only reader doesn't add the table
+    {
+        QSqlDatabase dataBase = QSqlDatabase::addDatabase("QSQLITE", "TestMissingStateTable");
+        dataBase.setDatabaseName(dataBaseName);
+        QVERIFY(dataBase.open());
+        QVERIFY(!dataBase.tables().contains(tableName + "_state"));
+        dataBase.close();
+    }
+    QSqlDatabase::removeDatabase("TestMissingStateTable");
+}
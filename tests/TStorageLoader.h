@@ -0,0 +1,30 @@
+#ifndef TSTORAGELOADER_H
+
+#define TSTORAGELOADER_H
+
+#include <QTest>
+#include <QSignalSpy>
+
+#include "TestingUtilities.h"
+
+#include "../src/StorageLoader.h"
+#include "../src/SqlPointListWriter.h"
+#include "../src/SqlPointListReader.h"
+#include "../src/ItemListModel.h"
+
+#include "../src/Metatypes.h"
+
+class TStorageLoader : public QObject
+{
+    Q_OBJECT
+public:
+    TStorageLoader();
+
+private slots:
+    void TestLoad();
+    void TestGenerate();
+    void TestMissingDatabase();
+    void TestMissingStateTable();
+};
+
+#endif // TSTORAGELOADER_H
@@ -0,0 +1,129 @@
+#include "TTDigest.h"
+
+static QVector<Point> randomPoints(const int count, const int seed)
+{
+    qsrand(seed);
+
+    QVector<Point> points(count);
+    for(int i = 0; i < count; i++)
+    {
+        points[i] = double(qrand() % 100000) / 100.0;
+    }
+    return points;
+}
+
+static double exactQuantile(QVector<Point> points, const double q)
+{
+    qSort(points);
+    return points.at(qMin(points.count() - 1, int(q * points.count())));
+}
+
+TTDigest::TTDigest()
+{
+}
+
+void TTDigest::TestQuantiles_data()
+{
+    QTest::addColumn<double>("quantile");
+
+    QTest::newRow("p1") << 0.01;
+    QTest::newRow("p25") << 0.25;
+    QTest::newRow("p50") << 0.5;
+    QTest::newRow("p75") << 0.75;
+    QTest::newRow("p90") << 0.9;
+    QTest::newRow("p99") << 0.99;
+}
+
+void TTDigest::TestQuantiles()
+{
+    QFETCH(double, quantile);
+
+    const QVector<Point> points = randomPoints(100000, 1);
+    const TDigest digest = TDigest::fromPoints(points.constData(), points.count());
+
+    // points are uniform on [0, 1000), 0.5% of the range is about 0.5% in rank
+    FUZZY_COMPARE_EPS(digest.quantile(quantile), exactQuantile(points, quantile), 5.0);
+
+    FUZZY_COMPARE(digest.quantile(0.0), exactQuantile(points, 0.0));
+    FUZZY_COMPARE(digest.quantile(1.0), exactQuantile(points, 1.0));
+}
+
+void TTDigest::TestMerge()
+{
+    const QVector<Point> first = randomPoints(50000, 2);
+    const QVector<Point> second = randomPoints(30000, 3);
+
+    TDigest merged = TDigest::fromPoints(first.constData(), first.count());
+    merged.merge(TDigest::fromPoints(second.constData(), second.count()));
+
+    QVector<Point> all = first;
+    all << second;
+
+    FUZZY_COMPARE(merged.count(), double(all.count()));
+    FUZZY_COMPARE_EPS(merged.quantile(0.5), exactQuantile(all, 0.5), 5.0);
+    FUZZY_COMPARE_EPS(merged.quantile(0.99), exactQuantile(all, 0.99), 5.0);
+}
+
+void TTDigest::TestSerialization()
+{
+    const QVector<Point> points = randomPoints(10000, 4);
+    const TDigest digest = TDigest::fromPoints(points.constData(), points.count(), 50.0);
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream << digest;
+    }
+
+    TDigest restored;
+    {
+        QDataStream stream(data);
+        stream >> restored;
+    }
+
+    FUZZY_COMPARE(restored.compression(), 50.0);
+    FUZZY_COMPARE(restored.count(), digest.count());
+    QCOMPARE(restored.centroidCount(), digest.centroidCount());
+
+    for(int percentile = 0; percentile <= 100; percentile += 5)
+    {
+        FUZZY_COMPARE(restored.quantile(percentile / 100.0), digest.quantile(percentile / 100.0));
+    }
+}
+
+void TTDigest::TestBoundedMemory()
+{
+    TDigest digest;
+
+    for(int chunk = 0; chunk < 10; chunk++)
+    {
+        const QVector<Point> points = randomPoints(100000, 5 + chunk);
+        digest.add(points.constData(), points.count());
+
+        QVERIFY(digest.centroidCount() <= int(digest.compression()));
+    }
+}
+
+void TTDigest::TestAnalysis_data()
+{
+    QTest::addColumn<PointList>("points");
+
+    QTest::newRow("empty") << PointList("Empty");
+    QTest::newRow("one") << (PointList("One") << 3.0);
+    QTest::newRow("odd") << (PointList("Odd") << 5.0 << 1.0 << 4.0 << 2.0 << 3.0);
+    QTest::newRow("even") << (PointList("Even") << 5.0 << 1.0 << 4.0 << 2.0 << 3.0 << 6.0);
+}
+
+void TTDigest::TestAnalysis()
+{
+    QFETCH(PointList, points);
+
+    // small sequences are kept exactly, so the sketch median is exact
+    QuantileSketchAnalysis median;
+
+    QCOMPARE(median.id(), IDAnalysis("sketch-p50"));
+    FUZZY_COMPARE(median.analyze(points), MedianAnalysis().analyze(points));
+
+    QCOMPARE(QuantileSketchAnalysis(0.99).id(), IDAnalysis("sketch-p99"));
+    QVERIFY(!QuantileSketchAnalysis(1.5).isValid());
+}
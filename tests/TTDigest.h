@@ -0,0 +1,33 @@
+#ifndef TTDIGEST_H
+
+#define TTDIGEST_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/TDigest.h"
+#include "../src/QuantileSketchAnalysis.h"
+#include "../src/MedianAnalysis.h"
+
+#include "../src/Metatypes.h"
+
+class TTDigest : public QObject
+{
+    Q_OBJECT
+public:
+    TTDigest();
+
+private slots:
+    void TestQuantiles_data();
+    void TestQuantiles();
+
+    void TestMerge();
+    void TestSerialization();
+    void TestBoundedMemory();
+
+    void TestAnalysis_data();
+    void TestAnalysis();
+};
+
+#endif // TTDIGEST_H
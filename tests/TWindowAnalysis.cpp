@@ -0,0 +1,164 @@
+#include "TWindowAnalysis.h"
+
+#include <algorithm>
+
+TWindowAnalysis::TWindowAnalysis()
+{
+}
+
+void TWindowAnalysis::TestSeries_data()
+{
+    QTest::addColumn<int>("statistic");
+    QTest::addColumn<int>("window");
+    QTest::addColumn<PointList>("values");
+    QTest::addColumn<QList<Point> >("result");
+
+    const PointList values = PointList("Values") << 4.0 << 1.0 << 3.0 << 8.0 << 2.0 << 2.0;
+
+    QTest::newRow("average") << int(WindowAnalysis::Average) << 3 << values
+                             << (QList<Point>() << 8.0 / 3.0 << 4.0 << 13.0 / 3.0 << 4.0);
+
+    QTest::newRow("minimum") << int(WindowAnalysis::Minimum) << 2 << values
+                             << (QList<Point>() << 1.0 << 1.0 << 3.0 << 2.0 << 2.0);
+
+    QTest::newRow("maximum") << int(WindowAnalysis::Maximum) << 3 << values
+                             << (QList<Point>() << 4.0 << 8.0 << 8.0 << 8.0);
+
+    QTest::newRow("median-odd") << int(WindowAnalysis::Median) << 3 << values
+                                << (QList<Point>() << 3.0 << 3.0 << 3.0 << 2.0);
+
+    QTest::newRow("median-even") << int(WindowAnalysis::Median) << 4 << values
+                                 << (QList<Point>() << 3.5 << 2.5 << 2.5);
+
+    // NaN ranks above every number, like in the sorted table
+    QTest::newRow("median-nan") << int(WindowAnalysis::Median) << 3
+                                << (PointList("Values") << 4.0 << 1.0 << qQNaN() << 8.0 << 2.0 << 2.0)
+                                << (QList<Point>() << 4.0 << 8.0 << 8.0 << 2.0);
+
+    QTest::newRow("deviation-one-point") << int(WindowAnalysis::StandardDeviation) << 1 << values
+                                         << (QList<Point>() << 0.0 << 0.0 << 0.0 << 0.0 << 0.0 << 0.0);
+
+    QTest::newRow("whole-sequence") << int(WindowAnalysis::Average) << 6 << values
+                                    << (QList<Point>() << 20.0 / 6.0);
+
+    QTest::newRow("shorter-than-window") << int(WindowAnalysis::Median) << 7 << values
+                                         << QList<Point>();
+}
+
+void TWindowAnalysis::TestSeries()
+{
+    QFETCH(int, statistic);
+    QFETCH(int, window);
+    QFETCH(PointList, values);
+    QFETCH(QList<Point>, result);
+
+    const WindowAnalysis analysis(WindowAnalysis::Statistic(statistic), window);
+    const PointList series = analysis.analyze(values);
+
+    QCOMPARE(series.id(), WindowAnalysis::seriesID(values.id(), analysis.id()));
+    QCOMPARE(series.count(), result.count());
+
+    for(int i = 0; i < result.count(); i++)
+    {
+        FUZZY_COMPARE(series.at(i), result.at(i));
+    }
+}
+
+void TWindowAnalysis::TestSlidingWindows_data()
+{
+    QTest::addColumn<int>("window");
+
+    QTest::newRow("one") << 1;
+    QTest::newRow("two") << 2;
+    QTest::newRow("seven") << 7;
+    QTest::newRow("sixty-four") << 64;
+}
+
+void TWindowAnalysis::TestSlidingWindows()
+{
+    QFETCH(int, window);
+
+    qsrand(window);
+
+    QVector<Point> values(500);
+    for(int i = 0; i < values.count(); i++)
+    {
+        values[i] = 1000.0 + double(qrand() % 2001 - 1000) / 10.0;
+    }
+
+    const QVector<Point> averages = WindowAnalysis(WindowAnalysis::Average, window).analyze(values);
+    const QVector<Point> deviations = WindowAnalysis(WindowAnalysis::StandardDeviation, window).analyze(values);
+    const QVector<Point> minimums = WindowAnalysis(WindowAnalysis::Minimum, window).analyze(values);
+    const QVector<Point> maximums = WindowAnalysis(WindowAnalysis::Maximum, window).analyze(values);
+    const QVector<Point> medians = WindowAnalysis(WindowAnalysis::Median, window).analyze(values);
+
+    QCOMPARE(averages.count(), values.count() - window + 1);
+
+    // every window analyzed anew gives the same series
+    for(int i = 0; i + window <= values.count(); i++)
+    {
+        const PointList windowPoints = PointList::fromVector("Window", values.mid(i, window));
+
+        FUZZY_COMPARE(averages.at(i), AverageAnalysis().analyze(windowPoints));
+        FUZZY_COMPARE(medians.at(i), MedianAnalysis().analyze(windowPoints));
+
+        const double deviation = (window > 1) ? StandardDeviationAnalysis().analyze(windowPoints) : 0.0;
+        FUZZY_COMPARE(deviations.at(i), deviation);
+
+        const QVector<Point> sorted = windowPoints.toVector();
+        FUZZY_COMPARE(minimums.at(i), *std::min_element(sorted.constBegin(), sorted.constEnd()));
+        FUZZY_COMPARE(maximums.at(i), *std::max_element(sorted.constBegin(), sorted.constEnd()));
+    }
+}
+
+void TWindowAnalysis::TestWriteSeries()
+{
+    const QString dataBaseName = "TestWriteSeries.db";
+
+    if(QFile::exists(dataBaseName))
+    {
+        if(!QFile::remove(dataBaseName))
+        {
+            QFAIL("can't remove testing database");
+        }
+    }
+
+    SqlPointListWriter writer(dataBaseName, "Points");
+    writer.open();
+    writer.write(SequencePointList()
+                 << (PointList("First") << 1.0 << 2.0 << 3.0 << 4.0)
+                 << (PointList("Second") << 5.0));
+
+    SqlPointListReader reader(dataBaseName, "Points");
+    reader.open();
+
+    SqlPointListWriter seriesWriter(dataBaseName, "Series");
+    seriesWriter.open();
+
+    const QList<WindowAnalysis> analyzes = QList<WindowAnalysis>()
+            << WindowAnalysis(WindowAnalysis::Average, 2)
+            << WindowAnalysis(WindowAnalysis::Maximum, 3);
+
+    // the second sequence is shorter than both windows and gives no series
+    QCOMPARE(WindowAnalysis::writeSeries(&reader, reader.readAllItems(), analyzes, &seriesWriter), 2);
+
+    SqlPointListReader seriesReader(dataBaseName, "Series");
+    seriesReader.open();
+
+    const PointList averages = seriesReader.read(WindowAnalysis::seriesID("First", "moving-average-2"));
+    QVERIFY(PointList::fuzzyCompare(averages, PointList("First:moving-average-2") << 1.5 << 2.5 << 3.5));
+
+    const PointList maximums = seriesReader.read(WindowAnalysis::seriesID("First", "moving-maximum-3"));
+    QVERIFY(PointList::fuzzyCompare(maximums, PointList("First:moving-maximum-3") << 3.0 << 4.0));
+
+    // a run over changed points replaces the series of the earlier run
+    QVERIFY(writer.replace(SequencePointList() << (PointList("First") << 10.0 << 20.0)));
+
+    QCOMPARE(WindowAnalysis::writeSeries(&reader, reader.readAllItems(), analyzes, &seriesWriter), 1);
+
+    const PointList newAverages = seriesReader.read(WindowAnalysis::seriesID("First", "moving-average-2"));
+    QVERIFY(PointList::fuzzyCompare(newAverages, PointList("First:moving-average-2") << 15.0));
+
+    // the points are too few for the maximum window now, its old series is removed
+    QCOMPARE(seriesReader.read(WindowAnalysis::seriesID("First", "moving-maximum-3")).count(), 0);
+}
@@ -0,0 +1,33 @@
+#ifndef TWINDOWANALYSIS_H
+
+#define TWINDOWANALYSIS_H
+
+#include <QTest>
+
+#include "TestingUtilities.h"
+
+#include "../src/WindowAnalysis.h"
+#include "../src/SqlPointListReader.h"
+#include "../src/AverageAnalysis.h"
+#include "../src/StandardDeviationAnalysis.h"
+#include "../src/MedianAnalysis.h"
+
+#include "../src/Metatypes.h"
+
+class TWindowAnalysis : public QObject
+{
+    Q_OBJECT
+public:
+    TWindowAnalysis();
+
+private slots:
+    void TestSeries_data();
+    void TestSeries();
+
+    void TestSlidingWindows_data();
+    void TestSlidingWindows();
+
+    void TestWriteSeries();
+};
+
+#endif // TWINDOWANALYSIS_H